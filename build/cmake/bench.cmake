@@ -0,0 +1,25 @@
+# if the library is compiled by vcpkg during the port build (i.e. during the package installation),
+# then we don't need to build benchmarks
+if(IS_VCPKG_PORT_BUILD)
+    return()
+endif()
+
+# no benchmarks for ios
+if(IOS)
+    return()
+endif()
+
+set(bench_srcs)
+myci_add_source_files(bench_srcs
+    DIRECTORY
+        ${CMAKE_CURRENT_LIST_DIR}/../../tests/bench/src
+    RECURSIVE
+)
+
+# benchmarks are not run as tests, run the application manually, see --help for options
+myci_declare_application(${PROJECT_NAME}-bench
+    SOURCES
+        ${bench_srcs}
+    DEPENDENCIES
+        r4
+)
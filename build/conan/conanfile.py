@@ -12,7 +12,7 @@ class R4Conan(ConanFile):
 	description = "3D vector math C++ library"
 	topics = ("C++", "cross-platform")
 	settings = "os", "compiler", "build_type", "arch"
-	package_type = "header-library"
+	package_type = "library"
 	options = {"shared": [True, False], "fPIC": [True, False]}
 	default_options = {"shared": False, "fPIC": True}
 	generators = "AutotoolsDeps" # this will set CXXFLAGS etc. env vars
@@ -80,8 +80,8 @@ class R4Conan(ConanFile):
 			copy(conanfile=self, pattern="*" + self.name + ".lib", dst=dst_lib_dir,     src="",          keep_path=False)
 			copy(conanfile=self, pattern="*.a",                    dst=dst_lib_dir,     src=src_rel_dir, keep_path=False)
 
-	# def package_info(self):
-	# 	self.cpp_info.libs = [self.name]
+	def package_info(self):
+		self.cpp_info.libs = [self.name]
 
 	def package_id(self):
 		# change package id only when minor or major version changes, i.e. when ABI breaks
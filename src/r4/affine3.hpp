@@ -0,0 +1,418 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <array>
+
+#include <utki/debug.hpp>
+
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "vector.hpp"
+
+namespace r4 {
+
+/**
+ * @brief Compact 3d affine transformation.
+ * The transformation is stored as 3x4 matrix, i.e. as 4x4 matrix with implicit (0, 0, 0, 1) last row.
+ *     | A t |
+ *     | 0 1 |
+ * Where A is a 3x3 linear block (rotation, scale, shear) and t is a translation column.
+ * Compared to matrix4, it takes 25% less memory and composition of two transformations
+ * takes 36 multiplications instead of 64.
+ */
+template <class component_type>
+class affine3 :
+	// it's ok to inherit std::array<component_type> because r4::affine3 only defines methods
+	// and doesn't define any new member variables, so it is ok that std::array has non-virtual destructor
+	public std::array<vector<component_type, 4>, 3>
+{
+public:
+	using base_type = std::array<vector<component_type, 4>, 3>;
+
+	/**
+	 * @brief Default constructor.
+	 * NOTE: it does not initialize the transformation with any values.
+	 */
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+	constexpr affine3() = default;
+
+	/**
+	 * @brief Constructor.
+	 * Initializes rows of the 3x4 matrix to given values.
+	 * @param r0 - first row.
+	 * @param r1 - second row.
+	 * @param r2 - third row.
+	 */
+	constexpr affine3(
+		const vector<component_type, 4>& r0,
+		const vector<component_type, 4>& r1,
+		const vector<component_type, 4>& r2
+	) noexcept :
+		base_type{r0, r1, r2}
+	{}
+
+	/**
+	 * @brief Construct from 4x4 matrix.
+	 * The last row of the matrix is discarded, it must be (0, 0, 0, 1),
+	 * which is checked by assertion in debug build.
+	 * @param m - 4x4 matrix to construct from.
+	 */
+	explicit affine3(const matrix4<component_type>& m) noexcept :
+		base_type{m[0], m[1], m[2]}
+	{
+		ASSERT(m[3] == (vector<component_type, 4>{0, 0, 0, 1}))
+	}
+
+	/**
+	 * @brief Construct rotation transformation.
+	 * @param quat - unit quaternion defining the rotation.
+	 */
+	explicit affine3(const quaternion<component_type>& quat) noexcept
+	{
+		this->set(quat);
+	}
+
+	/**
+	 * @brief Convert to 4x4 matrix.
+	 * @return 4x4 matrix with (0, 0, 0, 1) as last row.
+	 */
+	matrix4<component_type> to_matrix4() const noexcept
+	{
+		return matrix4<component_type>{
+			this->row(0),
+			this->row(1),
+			this->row(2),
+			vector<component_type, 4>{0, 0, 0, 1}
+		};
+	}
+
+	/**
+	 * @brief Convert to different element type.
+	 * @return affine transformation with converted element type.
+	 */
+	template <typename another_component_type>
+	affine3<another_component_type> to() const noexcept
+	{
+		return affine3<another_component_type>{
+			this->row(0).template to<another_component_type>(),
+			this->row(1).template to<another_component_type>(),
+			this->row(2).template to<another_component_type>()
+		};
+	}
+
+	/**
+	 * @brief Get row of the 3x4 matrix.
+	 * @param r - row number to get.
+	 * @return reference to vector representing the row.
+	 */
+	vector<component_type, 4>& row(size_t r) noexcept
+	{
+		ASSERT(r < this->size())
+		return this->operator[](r);
+	}
+
+	/**
+	 * @brief Get row of the 3x4 matrix.
+	 * @param r - row number to get.
+	 * @return reference to vector representing the row.
+	 */
+	const vector<component_type, 4>& row(size_t r) const noexcept
+	{
+		ASSERT(r < this->size())
+		return this->operator[](r);
+	}
+
+	/**
+	 * @brief Set this transformation to identity.
+	 * @return reference to this transformation.
+	 */
+	affine3& set_identity() noexcept
+	{
+		this->row(0) = {1, 0, 0, 0};
+		this->row(1) = {0, 1, 0, 0};
+		this->row(2) = {0, 0, 1, 0};
+		return *this;
+	}
+
+	/**
+	 * @brief Set this transformation to rotation.
+	 * @param quat - unit quaternion defining the rotation.
+	 * @return reference to this transformation.
+	 */
+	affine3& set(const quaternion<component_type>& quat) noexcept
+	{
+		matrix3<component_type> r(quat);
+		for (size_t i = 0; i != 3; ++i) {
+			this->row(i) = vector<component_type, 4>{r[i], 0};
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Compose two transformations.
+	 * Calculate this transformation M multiplied by another transformation K from the right (M * K),
+	 * i.e. the resulting transformation first applies K and then M.
+	 * @param a - transformation to multiply by (transformation K).
+	 * @return composed transformation.
+	 */
+	affine3 operator*(const affine3& a) const noexcept
+	{
+		affine3 ret;
+		for (size_t r = 0; r != 3; ++r) {
+			const auto& s = this->row(r);
+			auto& d = ret.row(r);
+			for (size_t c = 0; c != 4; ++c) {
+				d[c] = s[0] * a[0][c] + s[1] * a[1][c] + s[2] * a[2][c];
+			}
+			d[3] += s[3];
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief Compose with transformation from the right.
+	 * Multiply this transformation M by another transformation K from the right (M = M * K).
+	 * @param a - transformation to multiply by (transformation K).
+	 * @return reference to this transformation.
+	 */
+	affine3& operator*=(const affine3& a) noexcept
+	{
+		return this->operator=(this->operator*(a));
+	}
+
+	/**
+	 * @brief Compose with transformation from the left.
+	 * Multiply this transformation M by another transformation K from the left (M = K * M).
+	 * @param a - transformation to multiply by (transformation K).
+	 * @return reference to this transformation.
+	 */
+	affine3& left_mul(const affine3& a) noexcept
+	{
+		return this->operator=(a * (*this));
+	}
+
+	/**
+	 * @brief Transform point.
+	 * The point is transformed by the linear block and translated.
+	 * @param p - point to transform.
+	 * @return transformed point.
+	 */
+	vector<component_type, 3> transform_point(const vector<component_type, 3>& p) const noexcept
+	{
+		const auto& m = *this;
+		return vector<component_type, 3>{
+			m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2] + m[0][3],
+			m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2] + m[1][3],
+			m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2] + m[2][3]
+		};
+	}
+
+	/**
+	 * @brief Transform direction.
+	 * The direction is transformed by the linear block only, no translation is applied.
+	 * @param d - direction to transform.
+	 * @return transformed direction.
+	 */
+	vector<component_type, 3> transform_direction(const vector<component_type, 3>& d) const noexcept
+	{
+		const auto& m = *this;
+		return vector<component_type, 3>{
+			m[0][0] * d[0] + m[0][1] * d[1] + m[0][2] * d[2],
+			m[1][0] * d[0] + m[1][1] * d[1] + m[1][2] * d[2],
+			m[2][0] * d[0] + m[2][1] * d[1] + m[2][2] * d[2]
+		};
+	}
+
+	/**
+	 * @brief Transform point.
+	 * Same as transform_point().
+	 * @param p - point to transform.
+	 * @return transformed point.
+	 */
+	vector<component_type, 3> operator*(const vector<component_type, 3>& p) const noexcept
+	{
+		return this->transform_point(p);
+	}
+
+	/**
+	 * @brief Calculate inverse transformation.
+	 * The linear 3x3 block is inverted and the translation is transformed by the inverted block.
+	 * The linear block must be invertible.
+	 * @return inverse transformation.
+	 */
+	affine3 inv_affine() const noexcept
+	{
+		matrix3<component_type> a = this->linear();
+
+		auto [ai, det] = a.inv_det();
+		ASSERT(det != component_type(0))
+
+		auto t = this->translation();
+
+		return affine3{
+			vector<component_type, 4>{ai[0], -ai[0] * t},
+			vector<component_type, 4>{ai[1], -ai[1] * t},
+			vector<component_type, 4>{ai[2], -ai[2] * t}
+		};
+	}
+
+	/**
+	 * @brief Invert this transformation.
+	 * See inv_affine() for details.
+	 * @return reference to this transformation.
+	 */
+	affine3& invert_affine() noexcept
+	{
+		return this->operator=(this->inv_affine());
+	}
+
+	/**
+	 * @brief Get linear block.
+	 * @return 3x3 linear block of this transformation.
+	 */
+	matrix3<component_type> linear() const noexcept
+	{
+		return matrix3<component_type>{
+			vector<component_type, 3>(this->row(0)),
+			vector<component_type, 3>(this->row(1)),
+			vector<component_type, 3>(this->row(2))
+		};
+	}
+
+	/**
+	 * @brief Get translation.
+	 * @return translation column of this transformation.
+	 */
+	vector<component_type, 3> translation() const noexcept
+	{
+		return vector<component_type, 3>{this->row(0)[3], this->row(1)[3], this->row(2)[3]};
+	}
+
+	/**
+	 * @brief Multiply this transformation by translation.
+	 * Multiplies this transformation M by translation T from the right (M = M * T).
+	 * @param x - x component of translation vector.
+	 * @param y - y component of translation vector.
+	 * @param z - z component of translation vector.
+	 * @return reference to this transformation.
+	 */
+	affine3& translate(component_type x, component_type y, component_type z) noexcept
+	{
+		// only last column changes
+		for (auto& r : *this) {
+			r[3] += r[0] * x + r[1] * y + r[2] * z;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Multiply this transformation by translation.
+	 * Multiplies this transformation M by translation T from the right (M = M * T).
+	 * @param t - translation vector.
+	 * @return reference to this transformation.
+	 */
+	affine3& translate(const vector<component_type, 3>& t) noexcept
+	{
+		return this->translate(t.x(), t.y(), t.z());
+	}
+
+	/**
+	 * @brief Multiply this transformation by scale.
+	 * Multiplies this transformation M by scale S from the right (M = M * S).
+	 * @param s - scaling factor to be applied in all directions (x, y and z).
+	 * @return reference to this transformation.
+	 */
+	affine3& scale(component_type s) noexcept
+	{
+		return this->scale(s, s, s);
+	}
+
+	/**
+	 * @brief Multiply this transformation by scale.
+	 * Multiplies this transformation M by scale S from the right (M = M * S).
+	 * @param x - scaling factor in x direction.
+	 * @param y - scaling factor in y direction.
+	 * @param z - scaling factor in z direction.
+	 * @return reference to this transformation.
+	 */
+	affine3& scale(component_type x, component_type y, component_type z) noexcept
+	{
+		// translation column does not change
+		for (auto& r : *this) {
+			r[0] *= x;
+			r[1] *= y;
+			r[2] *= z;
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Multiply this transformation by scale.
+	 * Multiplies this transformation M by scale S from the right (M = M * S).
+	 * @param s - vector of scaling factors.
+	 * @return reference to this transformation.
+	 */
+	affine3& scale(const vector<component_type, 3>& s) noexcept
+	{
+		return this->scale(s.x(), s.y(), s.z());
+	}
+
+	/**
+	 * @brief Multiply this transformation by rotation.
+	 * Multiplies this transformation M by rotation R from the right (M = M * R).
+	 * Only the linear block changes, the translation column stays as is.
+	 * @param q - unit quaternion, representing the rotation.
+	 * @return reference to this transformation.
+	 */
+	affine3& rotate(const quaternion<component_type>& q) noexcept
+	{
+		matrix3<component_type> rot(q);
+
+		for (auto& r : *this) {
+			vector<component_type, 3> v{r[0], r[1], r[2]};
+			r[0] = v[0] * rot[0][0] + v[1] * rot[1][0] + v[2] * rot[2][0];
+			r[1] = v[0] * rot[0][1] + v[1] * rot[1][1] + v[2] * rot[2][1];
+			r[2] = v[0] * rot[0][2] + v[1] * rot[1][2] + v[2] * rot[2][2];
+		}
+		return *this;
+	}
+};
+
+} // namespace r4
+
+// The r4 library contains explicit instantiations of affine transformations of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class affine3<float>;
+extern template class affine3<double>;
+
+} // namespace r4
+#endif
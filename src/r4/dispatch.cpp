@@ -0,0 +1,1217 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#include "dispatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <utki/config.hpp>
+
+#include "transform.hpp"
+
+#if !defined(R4_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#	define R4_DISPATCH_X86
+#	include <immintrin.h>
+#	if CFG_COMPILER == CFG_COMPILER_MSVC
+#		include <intrin.h>
+// MSVC allows using intrinsics of any instruction set without enabling it for the whole translation unit
+#		define R4_TARGET(instruction_set)
+#		define R4_TARGET_INLINE(instruction_set) __forceinline
+#	else
+#		define R4_TARGET(instruction_set) __attribute__((target(instruction_set)))
+// the helpers take vectors by reference, if not inlined the registers are spilled to memory on every call
+#		define R4_TARGET_INLINE(instruction_set) __attribute__((target(instruction_set), always_inline)) inline
+#	endif
+#endif
+
+using namespace r4;
+using dispatch::isa;
+
+namespace {
+using points_span = utki::span<const vector3<float>>;
+using vectors_span = utki::span<vector3<float>>;
+using box_type = std::pair<vector3<float>, vector3<float>>;
+using floats_span = utki::span<const float>;
+
+box_type empty_box() noexcept
+{
+	return {
+		vector3<float>(std::numeric_limits<float>::infinity()),
+		vector3<float>(-std::numeric_limits<float>::infinity())
+	};
+}
+
+// ============================ scalar ============================
+
+void transform_points_scalar(const matrix4<float>& m, points_span in, vectors_span out) noexcept
+{
+	transform_internal::transform_scalar<transform_internal::kind::point>(m, in, out);
+}
+
+void normalize_scalar(vectors_span vectors) noexcept
+{
+	for (auto& v : vectors) {
+		v.normalize();
+	}
+}
+
+void bounding_box_tail(box_type& box, points_span points) noexcept
+{
+	for (const auto& p : points) {
+		box.first = min(box.first, p);
+		box.second = max(box.second, p);
+	}
+}
+
+box_type bounding_box_scalar(points_span points) noexcept
+{
+	auto box = empty_box();
+	bounding_box_tail(box, points);
+	return box;
+}
+
+void to_half_scalar(floats_span in, utki::span<half> out) noexcept
+{
+	std::copy(in.begin(), in.end(), out.begin());
+}
+
+void from_half_scalar(utki::span<const half> in, utki::span<float> out) noexcept
+{
+	std::copy(in.begin(), in.end(), out.begin());
+}
+
+void to_bfloat16_scalar(floats_span in, utki::span<bfloat16> out) noexcept
+{
+	std::copy(in.begin(), in.end(), out.begin());
+}
+
+void from_bfloat16_scalar(utki::span<const bfloat16> in, utki::span<float> out) noexcept
+{
+	std::copy(in.begin(), in.end(), out.begin());
+}
+
+#ifdef R4_DISPATCH_X86
+
+// The SIMD kernels process blocks of 4, 8 or 16 points, the remaining points are processed by the narrower kernels.
+// The components are deinterleaved to separate x, y and z registers, so that each SIMD instruction
+// processes same component of several points.
+// FMA instructions are not used, so that the results are same as of the scalar code.
+
+// the kernels process arrays of vector3<float> as flat arrays of floats
+static_assert(sizeof(vector3<float>) == 3 * sizeof(float), "vector3<float> must not have padding");
+
+const float* flat(points_span s) noexcept
+{
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+	return reinterpret_cast<const float*>(s.data());
+}
+
+float* flat(vectors_span s) noexcept
+{
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+	return reinterpret_cast<float*>(s.data());
+}
+
+// reduce the per-lane minimums and maximums of SIMD kernels, stored to arrays
+template <size_t num_lanes>
+void reduce_box(
+	box_type& box,
+	const std::array<std::array<float, num_lanes>, 3>& mins,
+	const std::array<std::array<float, num_lanes>, 3>& maxs
+) noexcept
+{
+	for (size_t c = 0; c != 3; ++c) {
+		for (size_t l = 0; l != num_lanes; ++l) {
+			box.first[c] = std::min(box.first[c], mins[c][l]);
+			box.second[c] = std::max(box.second[c], maxs[c][l]);
+		}
+	}
+}
+
+// ============================ SSE4.1 ============================
+
+// deinterleave 4 points: (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) -> (x0 x1 x2 x3) (y0 ...) (z0 ...)
+// clang-format off
+#	define R4_DEINTERLEAVE(shuffle, a, b, c, x, y, z) \
+	{ \
+		auto xy = shuffle(b, c, _MM_SHUFFLE(2, 1, 3, 2)); /* x2 y2 x3 y3 */ \
+		auto yz = shuffle(a, b, _MM_SHUFFLE(1, 0, 2, 1)); /* y0 z0 y1 z1 */ \
+		x = shuffle(a, xy, _MM_SHUFFLE(2, 0, 3, 0)); \
+		y = shuffle(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)); \
+		z = shuffle(yz, c, _MM_SHUFFLE(3, 0, 3, 1)); \
+	}
+
+// interleave back, reverse of R4_DEINTERLEAVE
+#	define R4_INTERLEAVE(shuffle, x, y, z, a, b, c) \
+	{ \
+		auto xy = shuffle(x, y, _MM_SHUFFLE(2, 0, 2, 0)); /* x0 x2 y0 y2 */ \
+		auto yz = shuffle(y, z, _MM_SHUFFLE(3, 1, 3, 1)); /* y1 y3 z1 z3 */ \
+		auto zx = shuffle(z, x, _MM_SHUFFLE(3, 1, 2, 0)); /* z0 z2 x1 x3 */ \
+		a = shuffle(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)); \
+		b = shuffle(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)); \
+		c = shuffle(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)); \
+	}
+// clang-format on
+
+R4_TARGET_INLINE("sse4.1")
+void load_sse(const float* p, __m128& x, __m128& y, __m128& z) noexcept
+{
+	__m128 a = _mm_loadu_ps(p);
+	__m128 b = _mm_loadu_ps(std::next(p, 4));
+	__m128 c = _mm_loadu_ps(std::next(p, 8));
+	R4_DEINTERLEAVE(_mm_shuffle_ps, a, b, c, x, y, z)
+}
+
+R4_TARGET_INLINE("sse4.1")
+void store_sse(float* p, __m128 x, __m128 y, __m128 z) noexcept
+{
+	__m128 a{};
+	__m128 b{};
+	__m128 c{};
+	R4_INTERLEAVE(_mm_shuffle_ps, x, y, z, a, b, c)
+	_mm_storeu_ps(p, a);
+	_mm_storeu_ps(std::next(p, 4), b);
+	_mm_storeu_ps(std::next(p, 8), c);
+}
+
+// same order of operations as in the scalar code
+R4_TARGET_INLINE("sse4.1")
+__m128 transform_row_sse(__m128 x, __m128 y, __m128 z, __m128 m0, __m128 m1, __m128 m2, __m128 m3) noexcept
+{
+	return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_mul_ps(m2, z)), m3);
+}
+
+R4_TARGET("sse4.1")
+void transform_points_sse4_1(const matrix4<float>& m, points_span in, vectors_span out) noexcept
+{
+	constexpr size_t block_size = 4;
+	const size_t num_blocks = in.size() / block_size;
+
+	// load the matrix once
+	const __m128 m00 = _mm_set1_ps(m[0][0]);
+	const __m128 m01 = _mm_set1_ps(m[0][1]);
+	const __m128 m02 = _mm_set1_ps(m[0][2]);
+	const __m128 m03 = _mm_set1_ps(m[0][3]);
+	const __m128 m10 = _mm_set1_ps(m[1][0]);
+	const __m128 m11 = _mm_set1_ps(m[1][1]);
+	const __m128 m12 = _mm_set1_ps(m[1][2]);
+	const __m128 m13 = _mm_set1_ps(m[1][3]);
+	const __m128 m20 = _mm_set1_ps(m[2][0]);
+	const __m128 m21 = _mm_set1_ps(m[2][1]);
+	const __m128 m22 = _mm_set1_ps(m[2][2]);
+	const __m128 m23 = _mm_set1_ps(m[2][3]);
+
+	const float* src = flat(in);
+	float* dst = flat(out);
+	for (size_t b = 0; b != num_blocks; ++b) {
+		__m128 x{};
+		__m128 y{};
+		__m128 z{};
+		load_sse(src, x, y, z);
+
+		store_sse(
+			dst,
+			transform_row_sse(x, y, z, m00, m01, m02, m03),
+			transform_row_sse(x, y, z, m10, m11, m12, m13),
+			transform_row_sse(x, y, z, m20, m21, m22, m23)
+		);
+		src = std::next(src, block_size * 3);
+		dst = std::next(dst, block_size * 3);
+	}
+
+	const size_t done = num_blocks * block_size;
+	transform_points_scalar(m, in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("sse4.1")
+void normalize_sse4_1(vectors_span vectors) noexcept
+{
+	constexpr size_t block_size = 4;
+	const size_t num_blocks = vectors.size() / block_size;
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1);
+
+	float* p = flat(vectors);
+	for (size_t b = 0; b != num_blocks; ++b) {
+		__m128 x{};
+		__m128 y{};
+		__m128 z{};
+		load_sse(p, x, y, z);
+
+		__m128 mag = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+		__m128 is_zero = _mm_cmpeq_ps(mag, zero);
+
+		// zero vectors become (1, 0, 0)
+		x = _mm_blendv_ps(_mm_div_ps(x, mag), one, is_zero);
+		y = _mm_blendv_ps(_mm_div_ps(y, mag), zero, is_zero);
+		z = _mm_blendv_ps(_mm_div_ps(z, mag), zero, is_zero);
+
+		store_sse(p, x, y, z);
+		p = std::next(p, block_size * 3);
+	}
+
+	normalize_scalar(vectors.subspan(num_blocks * block_size));
+}
+
+R4_TARGET("sse4.1")
+box_type bounding_box_sse4_1(points_span points) noexcept
+{
+	constexpr size_t block_size = 4;
+	const size_t num_blocks = points.size() / block_size;
+
+	auto box = empty_box();
+
+	if (num_blocks != 0) {
+		const float* p = flat(points);
+
+		__m128 min_x{};
+		__m128 min_y{};
+		__m128 min_z{};
+		load_sse(p, min_x, min_y, min_z);
+		__m128 max_x = min_x;
+		__m128 max_y = min_y;
+		__m128 max_z = min_z;
+
+		for (size_t b = 1; b != num_blocks; ++b) {
+			p = std::next(p, block_size * 3);
+			__m128 x{};
+			__m128 y{};
+			__m128 z{};
+			load_sse(p, x, y, z);
+			min_x = _mm_min_ps(min_x, x);
+			min_y = _mm_min_ps(min_y, y);
+			min_z = _mm_min_ps(min_z, z);
+			max_x = _mm_max_ps(max_x, x);
+			max_y = _mm_max_ps(max_y, y);
+			max_z = _mm_max_ps(max_z, z);
+		}
+
+		std::array<std::array<float, block_size>, 3> lane_mins{};
+		std::array<std::array<float, block_size>, 3> lane_maxs{};
+		_mm_storeu_ps(lane_mins[0].data(), min_x);
+		_mm_storeu_ps(lane_mins[1].data(), min_y);
+		_mm_storeu_ps(lane_mins[2].data(), min_z);
+		_mm_storeu_ps(lane_maxs[0].data(), max_x);
+		_mm_storeu_ps(lane_maxs[1].data(), max_y);
+		_mm_storeu_ps(lane_maxs[2].data(), max_z);
+		reduce_box(box, lane_mins, lane_maxs);
+	}
+
+	bounding_box_tail(box, points.subspan(num_blocks * block_size));
+	return box;
+}
+
+// there are no half precision conversion instructions before F16C, so the SSE4.1 level converts half with scalar code
+
+R4_TARGET("sse4.1")
+void to_bfloat16_sse4_1(floats_span in, utki::span<bfloat16> out) noexcept
+{
+	constexpr size_t block_size = 4;
+	const size_t num_blocks = in.size() / block_size;
+
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i rounding_bias = _mm_set1_epi32(0x7fff);
+	const __m128i quiet_bit = _mm_set1_epi32(0x400000);
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		__m128 f = _mm_loadu_ps(std::next(in.data(), i));
+		__m128i u = _mm_castps_si128(f);
+
+		// same as half_internal::float_to_bfloat16()
+		__m128i lsb = _mm_and_si128(_mm_srli_epi32(u, 16), one);
+		__m128i rounded = _mm_add_epi32(u, _mm_add_epi32(rounding_bias, lsb));
+		__m128i is_nan = _mm_castps_si128(_mm_cmpunord_ps(f, f));
+		__m128i r = _mm_blendv_epi8(rounded, _mm_or_si128(u, quiet_bit), is_nan);
+
+		__m128i packed = _mm_packus_epi32(_mm_srli_epi32(r, 16), _mm_setzero_si128());
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(std::next(out.data(), i)), packed);
+	}
+
+	const size_t done = num_blocks * block_size;
+	to_bfloat16_scalar(in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("sse4.1")
+void from_bfloat16_sse4_1(utki::span<const bfloat16> in, utki::span<float> out) noexcept
+{
+	constexpr size_t block_size = 4;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		__m128i v = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(std::next(in.data(), i))));
+		_mm_storeu_ps(std::next(out.data(), i), _mm_castsi128_ps(_mm_slli_epi32(v, 16)));
+	}
+
+	const size_t done = num_blocks * block_size;
+	from_bfloat16_scalar(in.subspan(done), out.subspan(done));
+}
+
+// ============================ AVX2 ============================
+
+// 8 points are processed as 2 blocks of 4 points, one block per 128-bit lane.
+// The remaining points are processed by the SSE4.1 kernels, which are compiled to legacy SSE instructions,
+// so the upper halves of the registers are cleared before calling them, to avoid the AVX-SSE transition penalty.
+
+R4_TARGET_INLINE("avx2")
+__m256 load_lanes(const float* p, size_t high_offset) noexcept
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(std::next(p, high_offset)), 1);
+}
+
+R4_TARGET_INLINE("avx2")
+void store_lanes(float* p, size_t high_offset, __m256 v) noexcept
+{
+	_mm_storeu_ps(p, _mm256_castps256_ps128(v));
+	_mm_storeu_ps(std::next(p, high_offset), _mm256_extractf128_ps(v, 1));
+}
+
+R4_TARGET_INLINE("avx2")
+void load_avx(const float* p, __m256& x, __m256& y, __m256& z) noexcept
+{
+	constexpr size_t high_offset = 12;
+	__m256 a = load_lanes(p, high_offset);
+	__m256 b = load_lanes(std::next(p, 4), high_offset);
+	__m256 c = load_lanes(std::next(p, 8), high_offset);
+	R4_DEINTERLEAVE(_mm256_shuffle_ps, a, b, c, x, y, z)
+}
+
+R4_TARGET_INLINE("avx2")
+void store_avx(float* p, __m256 x, __m256 y, __m256 z) noexcept
+{
+	constexpr size_t high_offset = 12;
+	__m256 a{};
+	__m256 b{};
+	__m256 c{};
+	R4_INTERLEAVE(_mm256_shuffle_ps, x, y, z, a, b, c)
+	store_lanes(p, high_offset, a);
+	store_lanes(std::next(p, 4), high_offset, b);
+	store_lanes(std::next(p, 8), high_offset, c);
+}
+
+// same order of operations as in the scalar code
+R4_TARGET_INLINE("avx2")
+__m256 transform_row_avx(__m256 x, __m256 y, __m256 z, __m256 m0, __m256 m1, __m256 m2, __m256 m3) noexcept
+{
+	return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m1, y)), _mm256_mul_ps(m2, z)), m3);
+}
+
+R4_TARGET("avx2")
+void transform_points_avx2(const matrix4<float>& m, points_span in, vectors_span out) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = in.size() / block_size;
+
+	// load the matrix once
+	const __m256 m00 = _mm256_set1_ps(m[0][0]);
+	const __m256 m01 = _mm256_set1_ps(m[0][1]);
+	const __m256 m02 = _mm256_set1_ps(m[0][2]);
+	const __m256 m03 = _mm256_set1_ps(m[0][3]);
+	const __m256 m10 = _mm256_set1_ps(m[1][0]);
+	const __m256 m11 = _mm256_set1_ps(m[1][1]);
+	const __m256 m12 = _mm256_set1_ps(m[1][2]);
+	const __m256 m13 = _mm256_set1_ps(m[1][3]);
+	const __m256 m20 = _mm256_set1_ps(m[2][0]);
+	const __m256 m21 = _mm256_set1_ps(m[2][1]);
+	const __m256 m22 = _mm256_set1_ps(m[2][2]);
+	const __m256 m23 = _mm256_set1_ps(m[2][3]);
+
+	const float* src = flat(in);
+	float* dst = flat(out);
+	for (size_t b = 0; b != num_blocks; ++b) {
+		__m256 x{};
+		__m256 y{};
+		__m256 z{};
+		load_avx(src, x, y, z);
+
+		store_avx(
+			dst,
+			transform_row_avx(x, y, z, m00, m01, m02, m03),
+			transform_row_avx(x, y, z, m10, m11, m12, m13),
+			transform_row_avx(x, y, z, m20, m21, m22, m23)
+		);
+		src = std::next(src, block_size * 3);
+		dst = std::next(dst, block_size * 3);
+	}
+
+	const size_t done = num_blocks * block_size;
+	_mm256_zeroupper();
+	transform_points_sse4_1(m, in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx2")
+void normalize_avx2(vectors_span vectors) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = vectors.size() / block_size;
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1);
+
+	float* p = flat(vectors);
+	for (size_t b = 0; b != num_blocks; ++b) {
+		__m256 x{};
+		__m256 y{};
+		__m256 z{};
+		load_avx(p, x, y, z);
+
+		__m256 mag = _mm256_sqrt_ps(
+			_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z))
+		);
+		__m256 is_zero = _mm256_cmp_ps(mag, zero, _CMP_EQ_OQ);
+
+		// zero vectors become (1, 0, 0)
+		x = _mm256_blendv_ps(_mm256_div_ps(x, mag), one, is_zero);
+		y = _mm256_blendv_ps(_mm256_div_ps(y, mag), zero, is_zero);
+		z = _mm256_blendv_ps(_mm256_div_ps(z, mag), zero, is_zero);
+
+		store_avx(p, x, y, z);
+		p = std::next(p, block_size * 3);
+	}
+
+	_mm256_zeroupper();
+	normalize_sse4_1(vectors.subspan(num_blocks * block_size));
+}
+
+R4_TARGET("avx2")
+box_type bounding_box_avx2(points_span points) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = points.size() / block_size;
+
+	auto box = empty_box();
+
+	if (num_blocks != 0) {
+		const float* p = flat(points);
+
+		__m256 min_x{};
+		__m256 min_y{};
+		__m256 min_z{};
+		load_avx(p, min_x, min_y, min_z);
+		__m256 max_x = min_x;
+		__m256 max_y = min_y;
+		__m256 max_z = min_z;
+
+		for (size_t b = 1; b != num_blocks; ++b) {
+			p = std::next(p, block_size * 3);
+			__m256 x{};
+			__m256 y{};
+			__m256 z{};
+			load_avx(p, x, y, z);
+			min_x = _mm256_min_ps(min_x, x);
+			min_y = _mm256_min_ps(min_y, y);
+			min_z = _mm256_min_ps(min_z, z);
+			max_x = _mm256_max_ps(max_x, x);
+			max_y = _mm256_max_ps(max_y, y);
+			max_z = _mm256_max_ps(max_z, z);
+		}
+
+		std::array<std::array<float, block_size>, 3> lane_mins{};
+		std::array<std::array<float, block_size>, 3> lane_maxs{};
+		_mm256_storeu_ps(lane_mins[0].data(), min_x);
+		_mm256_storeu_ps(lane_mins[1].data(), min_y);
+		_mm256_storeu_ps(lane_mins[2].data(), min_z);
+		_mm256_storeu_ps(lane_maxs[0].data(), max_x);
+		_mm256_storeu_ps(lane_maxs[1].data(), max_y);
+		_mm256_storeu_ps(lane_maxs[2].data(), max_z);
+		reduce_box(box, lane_mins, lane_maxs);
+	}
+
+	_mm256_zeroupper();
+	auto tail = bounding_box_sse4_1(points.subspan(num_blocks * block_size));
+	box.first = min(box.first, tail.first);
+	box.second = max(box.second, tail.second);
+	return box;
+}
+
+R4_TARGET("avx,f16c")
+void to_half_f16c(floats_span in, utki::span<half> out) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(std::next(in.data(), i)), _MM_FROUND_TO_NEAREST_INT);
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(std::next(out.data(), i)), h);
+	}
+
+	const size_t done = num_blocks * block_size;
+	_mm256_zeroupper();
+	to_half_scalar(in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx,f16c")
+void from_half_f16c(utki::span<const half> in, utki::span<float> out) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(std::next(in.data(), i)));
+		_mm256_storeu_ps(std::next(out.data(), i), _mm256_cvtph_ps(h));
+	}
+
+	const size_t done = num_blocks * block_size;
+	_mm256_zeroupper();
+	from_half_scalar(in.subspan(done), out.subspan(done));
+}
+
+// F16C is a separate CPUID feature, virtual machines can report AVX2 without it
+bool detect_f16c() noexcept
+{
+#	if CFG_COMPILER == CFG_COMPILER_MSVC
+	constexpr unsigned f16c_bit = 1 << 29;
+
+	std::array<int, 4> regs{}; // eax, ebx, ecx, edx
+	__cpuid(regs.data(), 1);
+	return (unsigned(regs[2]) & f16c_bit) != 0;
+#	else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("f16c");
+#	endif
+}
+
+bool has_f16c() noexcept
+{
+	static const bool supported = detect_f16c();
+	return supported;
+}
+
+void to_half_avx2(floats_span in, utki::span<half> out) noexcept
+{
+	if (has_f16c()) {
+		to_half_f16c(in, out);
+	} else {
+		to_half_scalar(in, out);
+	}
+}
+
+void from_half_avx2(utki::span<const half> in, utki::span<float> out) noexcept
+{
+	if (has_f16c()) {
+		from_half_f16c(in, out);
+	} else {
+		from_half_scalar(in, out);
+	}
+}
+
+R4_TARGET("avx2")
+void to_bfloat16_avx2(floats_span in, utki::span<bfloat16> out) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = in.size() / block_size;
+
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i rounding_bias = _mm256_set1_epi32(0x7fff);
+	const __m256i quiet_bit = _mm256_set1_epi32(0x400000);
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		__m256 f = _mm256_loadu_ps(std::next(in.data(), i));
+		__m256i u = _mm256_castps_si256(f);
+
+		// same as half_internal::float_to_bfloat16()
+		__m256i lsb = _mm256_and_si256(_mm256_srli_epi32(u, 16), one);
+		__m256i rounded = _mm256_add_epi32(u, _mm256_add_epi32(rounding_bias, lsb));
+		__m256i is_nan = _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+		__m256i r = _mm256_srli_epi32(_mm256_blendv_epi8(rounded, _mm256_or_si256(u, quiet_bit), is_nan), 16);
+
+		// 256-bit pack works within 128-bit lanes, so pack the halves with 128-bit instruction
+		__m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(std::next(out.data(), i)), packed);
+	}
+
+	const size_t done = num_blocks * block_size;
+	_mm256_zeroupper();
+	to_bfloat16_sse4_1(in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx2")
+void from_bfloat16_avx2(utki::span<const bfloat16> in, utki::span<float> out) noexcept
+{
+	constexpr size_t block_size = 8;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		__m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(std::next(in.data(), i))));
+		_mm256_storeu_ps(std::next(out.data(), i), _mm256_castsi256_ps(_mm256_slli_epi32(v, 16)));
+	}
+
+	const size_t done = num_blocks * block_size;
+	_mm256_zeroupper();
+	from_bfloat16_sse4_1(in.subspan(done), out.subspan(done));
+}
+
+// ============================ AVX-512 ============================
+
+// 16 points are loaded to 3 registers as is and deinterleaved with two-source permutations.
+// Masked versions of some intrinsics are used because with some compilers the unmasked ones
+// produce false uninitialized variable warnings.
+
+constexpr __mmask16 all_lanes = 0xffff;
+
+struct permutation_tables {
+	using table = std::array<int32_t, 16>; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+
+	// gather component c of 16 points from registers 0 and 1, then from register 2
+	std::array<table, 3> gather_01{};
+	std::array<table, 3> gather_2{};
+
+	// scatter x and y components of points to output register r, then z components
+	std::array<table, 3> scatter_xy{};
+	std::array<table, 3> scatter_z{};
+};
+
+constexpr permutation_tables make_permutation_tables() noexcept
+{
+	// index of permutex2var: bits 0-3 select the element, bit 4 selects the second source register
+	constexpr int32_t second = 16;
+	constexpr int32_t num_lanes = 16;
+
+	permutation_tables t;
+	for (int32_t c = 0; c != 3; ++c) {
+		for (int32_t i = 0; i != num_lanes; ++i) {
+			int32_t f = 3 * i + c; // index in the flat array of 48 floats
+			auto& g01 = t.gather_01[size_t(c)][size_t(i)];
+			auto& g2 = t.gather_2[size_t(c)][size_t(i)];
+			g01 = f < 2 * num_lanes ? f : 0;
+			g2 = f < 2 * num_lanes ? i : second + f - 2 * num_lanes;
+		}
+	}
+	for (int32_t r = 0; r != 3; ++r) {
+		for (int32_t e = 0; e != num_lanes; ++e) {
+			int32_t f = r * num_lanes + e; // index in the flat array of 48 floats
+			int32_t p = f / 3;
+			int32_t c = f % 3;
+			auto& sxy = t.scatter_xy[size_t(r)][size_t(e)];
+			auto& sz = t.scatter_z[size_t(r)][size_t(e)];
+			sxy = c == 0 ? p : (c == 1 ? second + p : 0);
+			sz = c == 2 ? second + p : e;
+		}
+	}
+	return t;
+}
+
+constexpr permutation_tables perm = make_permutation_tables();
+
+R4_TARGET_INLINE("avx512f")
+__m512i load_table(const permutation_tables::table& t) noexcept
+{
+	return _mm512_loadu_si512(t.data());
+}
+
+R4_TARGET_INLINE("avx512f")
+__m512 gather_avx512(__m512 a, __m512 b, __m512 c, size_t component) noexcept
+{
+	return _mm512_permutex2var_ps(
+		_mm512_permutex2var_ps(a, load_table(perm.gather_01[component]), b),
+		load_table(perm.gather_2[component]),
+		c
+	);
+}
+
+R4_TARGET_INLINE("avx512f")
+void load_avx512(const float* p, __m512& x, __m512& y, __m512& z) noexcept
+{
+	__m512 a = _mm512_loadu_ps(p);
+	__m512 b = _mm512_loadu_ps(std::next(p, 16));
+	__m512 c = _mm512_loadu_ps(std::next(p, 32));
+
+	x = gather_avx512(a, b, c, 0);
+	y = gather_avx512(a, b, c, 1);
+	z = gather_avx512(a, b, c, 2);
+}
+
+R4_TARGET_INLINE("avx512f")
+void store_avx512(float* p, __m512 x, __m512 y, __m512 z) noexcept
+{
+	for (size_t i = 0; i != 3; ++i) {
+		__m512 r = _mm512_permutex2var_ps(
+			_mm512_permutex2var_ps(x, load_table(perm.scatter_xy[i]), y),
+			load_table(perm.scatter_z[i]),
+			z
+		);
+		_mm512_storeu_ps(std::next(p, ptrdiff_t(16 * i)), r);
+	}
+}
+
+// same order of operations as in the scalar code
+R4_TARGET_INLINE("avx512f")
+__m512 transform_row_avx512(__m512 x, __m512 y, __m512 z, __m512 m0, __m512 m1, __m512 m2, __m512 m3) noexcept
+{
+	return _mm512_add_ps(_mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m0, x), _mm512_mul_ps(m1, y)), _mm512_mul_ps(m2, z)), m3);
+}
+
+R4_TARGET("avx512f")
+void transform_points_avx512(const matrix4<float>& m, points_span in, vectors_span out) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = in.size() / block_size;
+
+	// load the matrix once
+	const __m512 m00 = _mm512_set1_ps(m[0][0]);
+	const __m512 m01 = _mm512_set1_ps(m[0][1]);
+	const __m512 m02 = _mm512_set1_ps(m[0][2]);
+	const __m512 m03 = _mm512_set1_ps(m[0][3]);
+	const __m512 m10 = _mm512_set1_ps(m[1][0]);
+	const __m512 m11 = _mm512_set1_ps(m[1][1]);
+	const __m512 m12 = _mm512_set1_ps(m[1][2]);
+	const __m512 m13 = _mm512_set1_ps(m[1][3]);
+	const __m512 m20 = _mm512_set1_ps(m[2][0]);
+	const __m512 m21 = _mm512_set1_ps(m[2][1]);
+	const __m512 m22 = _mm512_set1_ps(m[2][2]);
+	const __m512 m23 = _mm512_set1_ps(m[2][3]);
+
+	const float* src = flat(in);
+	float* dst = flat(out);
+	for (size_t b = 0; b != num_blocks; ++b) {
+		__m512 x{};
+		__m512 y{};
+		__m512 z{};
+		load_avx512(src, x, y, z);
+
+		store_avx512(
+			dst,
+			transform_row_avx512(x, y, z, m00, m01, m02, m03),
+			transform_row_avx512(x, y, z, m10, m11, m12, m13),
+			transform_row_avx512(x, y, z, m20, m21, m22, m23)
+		);
+		src = std::next(src, block_size * 3);
+		dst = std::next(dst, block_size * 3);
+	}
+
+	const size_t done = num_blocks * block_size;
+	transform_points_avx2(m, in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx512f")
+void normalize_avx512(vectors_span vectors) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = vectors.size() / block_size;
+
+	const __m512 zero = _mm512_setzero_ps();
+	const __m512 one = _mm512_set1_ps(1);
+
+	float* p = flat(vectors);
+	for (size_t b = 0; b != num_blocks; ++b) {
+		__m512 x{};
+		__m512 y{};
+		__m512 z{};
+		load_avx512(p, x, y, z);
+
+		__m512 mag_pow2 = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(x, x), _mm512_mul_ps(y, y)), _mm512_mul_ps(z, z));
+		__m512 mag = _mm512_mask_sqrt_ps(mag_pow2, all_lanes, mag_pow2);
+		__mmask16 is_zero = _mm512_cmp_ps_mask(mag, zero, _CMP_EQ_OQ);
+
+		// zero vectors become (1, 0, 0)
+		x = _mm512_mask_blend_ps(is_zero, _mm512_div_ps(x, mag), one);
+		y = _mm512_mask_blend_ps(is_zero, _mm512_div_ps(y, mag), zero);
+		z = _mm512_mask_blend_ps(is_zero, _mm512_div_ps(z, mag), zero);
+
+		store_avx512(p, x, y, z);
+		p = std::next(p, block_size * 3);
+	}
+
+	normalize_avx2(vectors.subspan(num_blocks * block_size));
+}
+
+R4_TARGET("avx512f")
+box_type bounding_box_avx512(points_span points) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = points.size() / block_size;
+
+	auto box = empty_box();
+
+	if (num_blocks != 0) {
+		const float* p = flat(points);
+
+		__m512 min_x{};
+		__m512 min_y{};
+		__m512 min_z{};
+		load_avx512(p, min_x, min_y, min_z);
+		__m512 max_x = min_x;
+		__m512 max_y = min_y;
+		__m512 max_z = min_z;
+
+		for (size_t b = 1; b != num_blocks; ++b) {
+			p = std::next(p, block_size * 3);
+			__m512 x{};
+			__m512 y{};
+			__m512 z{};
+			load_avx512(p, x, y, z);
+			min_x = _mm512_mask_min_ps(min_x, all_lanes, min_x, x);
+			min_y = _mm512_mask_min_ps(min_y, all_lanes, min_y, y);
+			min_z = _mm512_mask_min_ps(min_z, all_lanes, min_z, z);
+			max_x = _mm512_mask_max_ps(max_x, all_lanes, max_x, x);
+			max_y = _mm512_mask_max_ps(max_y, all_lanes, max_y, y);
+			max_z = _mm512_mask_max_ps(max_z, all_lanes, max_z, z);
+		}
+
+		std::array<std::array<float, block_size>, 3> lane_mins{};
+		std::array<std::array<float, block_size>, 3> lane_maxs{};
+		_mm512_storeu_ps(lane_mins[0].data(), min_x);
+		_mm512_storeu_ps(lane_mins[1].data(), min_y);
+		_mm512_storeu_ps(lane_mins[2].data(), min_z);
+		_mm512_storeu_ps(lane_maxs[0].data(), max_x);
+		_mm512_storeu_ps(lane_maxs[1].data(), max_y);
+		_mm512_storeu_ps(lane_maxs[2].data(), max_z);
+		reduce_box(box, lane_mins, lane_maxs);
+	}
+
+	auto tail = bounding_box_avx2(points.subspan(num_blocks * block_size));
+	box.first = min(box.first, tail.first);
+	box.second = max(box.second, tail.second);
+	return box;
+}
+
+R4_TARGET("avx512f")
+void to_half_avx512(floats_span in, utki::span<half> out) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		__m256i h = _mm512_maskz_cvtps_ph(all_lanes, _mm512_loadu_ps(std::next(in.data(), i)), _MM_FROUND_TO_NEAREST_INT);
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(std::next(out.data(), i)), h);
+	}
+
+	const size_t done = num_blocks * block_size;
+	to_half_avx2(in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx512f")
+void from_half_avx512(utki::span<const half> in, utki::span<float> out) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		__m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(std::next(in.data(), i)));
+		_mm512_storeu_ps(std::next(out.data(), i), _mm512_maskz_cvtph_ps(all_lanes, h));
+	}
+
+	const size_t done = num_blocks * block_size;
+	from_half_avx2(in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx512f")
+void to_bfloat16_avx512(floats_span in, utki::span<bfloat16> out) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = in.size() / block_size;
+
+	const __m512i one = _mm512_set1_epi32(1);
+	const __m512i rounding_bias = _mm512_set1_epi32(0x7fff);
+	const __m512i quiet_bit = _mm512_set1_epi32(0x400000);
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		__m512 f = _mm512_loadu_ps(std::next(in.data(), i));
+		__m512i u = _mm512_castps_si512(f);
+
+		// same as half_internal::float_to_bfloat16()
+		__m512i lsb = _mm512_and_si512(_mm512_maskz_srli_epi32(all_lanes, u, 16), one);
+		__m512i rounded = _mm512_add_epi32(u, _mm512_add_epi32(rounding_bias, lsb));
+		__mmask16 is_nan = _mm512_cmp_ps_mask(f, f, _CMP_UNORD_Q);
+		__m512i r = _mm512_maskz_srli_epi32(all_lanes, _mm512_mask_blend_epi32(is_nan, rounded, _mm512_or_si512(u, quiet_bit)), 16);
+
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(std::next(out.data(), i)), _mm512_maskz_cvtepi32_epi16(all_lanes, r));
+	}
+
+	const size_t done = num_blocks * block_size;
+	to_bfloat16_avx2(in.subspan(done), out.subspan(done));
+}
+
+R4_TARGET("avx512f")
+void from_bfloat16_avx512(utki::span<const bfloat16> in, utki::span<float> out) noexcept
+{
+	constexpr size_t block_size = 16;
+	const size_t num_blocks = in.size() / block_size;
+
+	for (size_t b = 0; b != num_blocks; ++b) {
+		const size_t i = b * block_size;
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		__m512i v = _mm512_maskz_cvtepu16_epi32(all_lanes, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(std::next(in.data(), i))));
+		_mm512_storeu_ps(std::next(out.data(), i), _mm512_castsi512_ps(_mm512_maskz_slli_epi32(all_lanes, v, 16)));
+	}
+
+	const size_t done = num_blocks * block_size;
+	from_bfloat16_avx2(in.subspan(done), out.subspan(done));
+}
+
+#	undef R4_INTERLEAVE
+#	undef R4_DEINTERLEAVE
+
+#endif // ~R4_DISPATCH_X86
+
+// ============================ dispatching ============================
+
+struct kernels {
+	decltype(&transform_points_scalar) transform_points;
+	decltype(&normalize_scalar) normalize;
+	decltype(&bounding_box_scalar) bounding_box;
+	decltype(&to_half_scalar) to_half;
+	decltype(&from_half_scalar) from_half;
+	decltype(&to_bfloat16_scalar) to_bfloat16;
+	decltype(&from_bfloat16_scalar) from_bfloat16;
+};
+
+#ifdef R4_DISPATCH_X86
+const std::array<kernels, size_t(isa::enum_size)> kernel_table = {
+	{
+     {transform_points_scalar,
+         normalize_scalar,
+         bounding_box_scalar,
+         to_half_scalar,
+         from_half_scalar,
+         to_bfloat16_scalar,
+         from_bfloat16_scalar},
+     {transform_points_sse4_1,
+         normalize_sse4_1,
+         bounding_box_sse4_1,
+         to_half_scalar,
+         from_half_scalar,
+         to_bfloat16_sse4_1,
+         from_bfloat16_sse4_1},
+     {transform_points_avx2,
+         normalize_avx2,
+         bounding_box_avx2,
+         to_half_avx2,
+         from_half_avx2,
+         to_bfloat16_avx2,
+         from_bfloat16_avx2},
+     {transform_points_avx512,
+         normalize_avx512,
+         bounding_box_avx512,
+         to_half_avx512,
+         from_half_avx512,
+         to_bfloat16_avx512,
+         from_bfloat16_avx512},
+	 }
+};
+#else
+// only the scalar implementation is ever selected
+const std::array<kernels, 1> kernel_table = {
+	{
+     {transform_points_scalar,
+         normalize_scalar,
+         bounding_box_scalar,
+         to_half_scalar,
+         from_half_scalar,
+         to_bfloat16_scalar,
+         from_bfloat16_scalar},
+	 }
+};
+#endif
+
+isa detect_isa() noexcept
+{
+#ifdef R4_DISPATCH_X86
+#	if CFG_COMPILER == CFG_COMPILER_MSVC
+	constexpr unsigned sse4_1_bit = 1 << 19;
+	constexpr unsigned osxsave_bit = 1 << 27;
+	constexpr unsigned avx_bit = 1 << 28;
+	constexpr unsigned avx2_bit = 1 << 5;
+	constexpr unsigned avx512f_bit = 1 << 16;
+
+	// XMM and YMM registers state, then also opmask and ZMM registers state
+	constexpr unsigned long long ymm_state = 0x6;
+	constexpr unsigned long long zmm_state = 0xe6;
+
+	std::array<int, 4> regs{}; // eax, ebx, ecx, edx
+	__cpuid(regs.data(), 0);
+	const int max_leaf = regs[0];
+
+	__cpuid(regs.data(), 1);
+	const auto ecx1 = unsigned(regs[2]);
+	if (!(ecx1 & sse4_1_bit)) {
+		return isa::scalar;
+	}
+	if (!(ecx1 & osxsave_bit) || !(ecx1 & avx_bit) || max_leaf < 7) {
+		return isa::sse4_1;
+	}
+
+	const auto xcr0 = _xgetbv(0);
+	__cpuidex(regs.data(), 7, 0);
+	const auto ebx7 = unsigned(regs[1]);
+	if ((xcr0 & ymm_state) != ymm_state || !(ebx7 & avx2_bit)) {
+		return isa::sse4_1;
+	}
+	if ((xcr0 & zmm_state) != zmm_state || !(ebx7 & avx512f_bit)) {
+		return isa::avx2;
+	}
+	return isa::avx512;
+#	else
+	// the builtins also check that the OS saves the extended registers state
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return isa::avx512;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return isa::avx2;
+	}
+	if (__builtin_cpu_supports("sse4.1")) {
+		return isa::sse4_1;
+	}
+#	endif
+#endif
+	return isa::scalar;
+}
+
+isa initial_isa() noexcept
+{
+	const isa supported = dispatch::get_supported_isa();
+
+	// NOLINTNEXTLINE(concurrency-mt-unsafe)
+	const char* env = std::getenv("R4_ISA");
+	if (!env) {
+		return supported;
+	}
+
+	for (size_t i = 0; i != size_t(isa::enum_size); ++i) {
+		if (dispatch::to_string(isa(i)) == env) {
+			return std::min(isa(i), supported);
+		}
+	}
+	return supported;
+}
+
+std::atomic<isa>& current_isa() noexcept
+{
+	static std::atomic<isa> i(initial_isa());
+	return i;
+}
+
+const kernels& get_kernels() noexcept
+{
+	return kernel_table[size_t(current_isa().load(std::memory_order_relaxed))];
+}
+} // namespace
+
+std::string_view dispatch::to_string(isa i) noexcept
+{
+	switch (i) {
+		case isa::scalar:
+			return "scalar";
+		case isa::sse4_1:
+			return "sse4.1";
+		case isa::avx2:
+			return "avx2";
+		case isa::avx512:
+			return "avx512";
+		case isa::enum_size:
+			break;
+	}
+	return "unknown";
+}
+
+isa dispatch::get_supported_isa() noexcept
+{
+	static const isa supported = detect_isa();
+	return supported;
+}
+
+isa dispatch::get_isa() noexcept
+{
+	return current_isa().load(std::memory_order_relaxed);
+}
+
+void dispatch::set_isa(isa i)
+{
+	if (i >= isa::enum_size || i > get_supported_isa()) {
+		throw std::invalid_argument(
+			"r4::dispatch::set_isa(): instruction set is not supported by the CPU: " + std::string(to_string(i))
+		);
+	}
+	current_isa().store(i, std::memory_order_relaxed);
+}
+
+void dispatch::transform_points(const matrix4<float>& m, points_span in, vectors_span out) noexcept
+{
+	ASSERT(in.size() == out.size())
+	get_kernels().transform_points(m, in, out);
+}
+
+void dispatch::normalize(vectors_span vectors) noexcept
+{
+	get_kernels().normalize(vectors);
+}
+
+box_type dispatch::bounding_box(points_span points) noexcept
+{
+	return get_kernels().bounding_box(points);
+}
+
+void dispatch::convert(utki::span<const float> in, utki::span<half> out) noexcept
+{
+	ASSERT(in.size() == out.size())
+	get_kernels().to_half(in, out);
+}
+
+void dispatch::convert(utki::span<const half> in, utki::span<float> out) noexcept
+{
+	ASSERT(in.size() == out.size())
+	get_kernels().from_half(in, out);
+}
+
+void dispatch::convert(utki::span<const float> in, utki::span<bfloat16> out) noexcept
+{
+	ASSERT(in.size() == out.size())
+	get_kernels().to_bfloat16(in, out);
+}
+
+void dispatch::convert(utki::span<const bfloat16> in, utki::span<float> out) noexcept
+{
+	ASSERT(in.size() == out.size())
+	get_kernels().from_bfloat16(in, out);
+}
@@ -0,0 +1,204 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <string_view>
+#include <utility>
+
+#include <utki/span.hpp>
+
+#include "half.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Run-time dispatched bulk operations.
+ * The header-only SIMD code paths of r4 are selected at compile time, so a binary built for the baseline
+ * instruction set does not use wider instructions even if the CPU supports them.
+ * The functions in this namespace are part of the r4 library and contain implementations for several
+ * instruction sets, those are point transformation, normalization and bounding box calculation of vector3<float> spans,
+ * and conversion between float and half precision types.
+ * The best implementation supported by the CPU is selected once, on first use.
+ *
+ * The selection can be overridden by setting the R4_ISA environment variable to one of
+ * "scalar", "sse4.1", "avx2" or "avx512" before the first call, or at any time with set_isa().
+ * Unknown values of the environment variable are ignored, instruction sets not supported by the CPU
+ * are replaced with the best supported one.
+ */
+namespace r4::dispatch {
+
+/**
+ * @brief Instruction set.
+ * The values are ordered, each instruction set is a superset of the previous one.
+ */
+enum class isa {
+	scalar,
+	sse4_1,
+	avx2,
+	avx512,
+
+	enum_size
+};
+
+/**
+ * @brief Get name of the instruction set.
+ * The name is the one accepted in the R4_ISA environment variable.
+ * @param i - instruction set.
+ * @return Instruction set name.
+ */
+std::string_view to_string(isa i) noexcept;
+
+/**
+ * @brief Get the best instruction set supported by the CPU and OS.
+ * @return The best supported instruction set.
+ */
+isa get_supported_isa() noexcept;
+
+/**
+ * @brief Get the instruction set used by the dispatched functions.
+ * @return Currently used instruction set.
+ */
+isa get_isa() noexcept;
+
+/**
+ * @brief Select the instruction set used by the dispatched functions.
+ * Intended for testing and benchmarking of each implementation on one machine.
+ * @param i - instruction set to use.
+ * @throw std::invalid_argument - in case the instruction set is not supported by the CPU.
+ */
+void set_isa(isa i);
+
+/**
+ * @brief Transform points by matrix.
+ * Same as r4::transform_points() from r4/transform.hpp.
+ * @param m - transformation matrix.
+ * @param in - points to transform.
+ * @param out - span to store transformed points to. Must have same size as the input span.
+ *              Can be the same span as the input one.
+ */
+void transform_points(
+	const matrix4<float>& m,
+	utki::span<const vector3<float>> in,
+	utki::span<vector3<float>> out
+) noexcept;
+
+/**
+ * @brief Normalize vectors.
+ * Same as calling vector::normalize() on each vector, zero vectors become (1, 0, 0).
+ * @param vectors - vectors to normalize in place.
+ */
+void normalize(utki::span<vector3<float>> vectors) noexcept;
+
+/**
+ * @brief Calculate axis-aligned bounding box of points.
+ * For empty span the result is (inf, inf, inf) for minimum corner and (-inf, -inf, -inf) for maximum corner.
+ * @param points - points to calculate bounding box of. Must not contain NaN components.
+ * @return Pair of minimum and maximum corners of the bounding box.
+ */
+std::pair<vector3<float>, vector3<float>> bounding_box(utki::span<const vector3<float>> points) noexcept;
+
+/**
+ * @brief Convert floats to half precision.
+ * Same as converting each number with r4::half constructor.
+ * @param in - numbers to convert.
+ * @param out - span to store converted numbers to. Must have same size as the input span.
+ */
+void convert(utki::span<const float> in, utki::span<half> out) noexcept;
+
+/**
+ * @brief Convert half precision numbers to floats.
+ * @param in - numbers to convert.
+ * @param out - span to store converted numbers to. Must have same size as the input span.
+ */
+void convert(utki::span<const half> in, utki::span<float> out) noexcept;
+
+/**
+ * @brief Convert floats to bfloat16.
+ * Same as converting each number with r4::bfloat16 constructor.
+ * @param in - numbers to convert.
+ * @param out - span to store converted numbers to. Must have same size as the input span.
+ */
+void convert(utki::span<const float> in, utki::span<bfloat16> out) noexcept;
+
+/**
+ * @brief Convert bfloat16 numbers to floats.
+ * @param in - numbers to convert.
+ * @param out - span to store converted numbers to. Must have same size as the input span.
+ */
+void convert(utki::span<const bfloat16> in, utki::span<float> out) noexcept;
+
+/**
+ * @brief Convert component type of vectors.
+ * Same as calling vector::to() on each vector.
+ * Defined for the conversions supported by the convert() functions on spans of numbers,
+ * i.e. between float and r4::half or r4::bfloat16.
+ * @param in - vectors to convert.
+ * @param out - span to store converted vectors to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type, size_t dimension>
+void convert(utki::span<const vector<from_type, dimension>> in, utki::span<vector<to_type, dimension>> out) noexcept
+{
+	static_assert(sizeof(vector<from_type, dimension>) == sizeof(from_type) * dimension, "vector must not have padding");
+	static_assert(sizeof(vector<to_type, dimension>) == sizeof(to_type) * dimension, "vector must not have padding");
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+	convert(
+		utki::span<const from_type>(reinterpret_cast<const from_type*>(in.data()), in.size() * dimension),
+		utki::span<to_type>(reinterpret_cast<to_type*>(out.data()), out.size() * dimension)
+	);
+	// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+/**
+ * @brief Convert component type of matrices.
+ * Same as calling matrix::to() on each matrix.
+ * Defined for the conversions supported by the convert() functions on spans of numbers,
+ * i.e. between float and r4::half or r4::bfloat16.
+ * @param in - matrices to convert.
+ * @param out - span to store converted matrices to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type, size_t num_rows, size_t num_columns>
+void convert(
+	utki::span<const matrix<from_type, num_rows, num_columns>> in,
+	utki::span<matrix<to_type, num_rows, num_columns>> out
+) noexcept
+{
+	constexpr size_t num_elements = num_rows * num_columns;
+
+	static_assert(sizeof(matrix<from_type, num_rows, num_columns>) == sizeof(from_type) * num_elements, "matrix must not have padding");
+	static_assert(sizeof(matrix<to_type, num_rows, num_columns>) == sizeof(to_type) * num_elements, "matrix must not have padding");
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+	convert(
+		utki::span<const from_type>(reinterpret_cast<const from_type*>(in.data()), in.size() * num_elements),
+		utki::span<to_type>(reinterpret_cast<to_type*>(out.data()), out.size() * num_elements)
+	);
+	// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+} // namespace r4::dispatch
@@ -0,0 +1,823 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "simd.hpp"
+
+namespace r4 {
+
+/**
+ * @brief Overflow behaviour of fixed point arithmetic.
+ */
+enum class overflow {
+	/**
+	 * @brief Results are taken modulo 2^n, where n is the number of bits of the fixed point number.
+	 */
+	wrap,
+
+	/**
+	 * @brief Results are clamped to the representable range.
+	 */
+	saturate
+};
+
+namespace fixed_internal {
+
+template <size_t num_bits>
+using raw_type = std::conditional_t<
+	num_bits == 8,
+	int8_t,
+	std::conditional_t<num_bits == 16, int16_t, int32_t> //
+	>;
+
+// Trigonometric functions are calculated with CORDIC algorithm in Q2.30 format
+// stored in 64-bit integers, which leaves enough headroom for intermediate values.
+constexpr unsigned q30_bits = 30;
+constexpr int64_t q30_one = int64_t(1) << q30_bits;
+constexpr int64_t q30_pi = 3373259426;
+constexpr int64_t q30_half_pi = 1686629713;
+constexpr int64_t q30_two_pi = 6746518852;
+
+// CORDIC gain compensation, product of 1 / sqrt(1 + 2^(-2 * i))
+constexpr int64_t q30_cordic_gain = 652032874;
+
+constexpr size_t num_cordic_iterations = 30;
+
+// atan(2^-i)
+constexpr std::array<int64_t, num_cordic_iterations> q30_cordic_angles = {
+	{843314857, 497837829, 263043837, 133525159, 67021687, 33543516, 16775851, 8388437, 4194283, 2097149,
+	 1048576,   524288,    262144,    131072,    65536,    32768,    16384,    8192,    4096,    2048,
+	 1024,      512,       256,       128,       64,       32,       16,       8,       4,       2}
+};
+
+// Right shifts of negative numbers are arithmetic on all supported compilers,
+// left shifts of negative numbers are done with multiplications.
+
+constexpr int64_t to_q30(int64_t raw, size_t frac_bits) noexcept
+{
+	if (frac_bits <= q30_bits) {
+		return raw * (int64_t(1) << (q30_bits - frac_bits));
+	}
+	return raw >> (frac_bits - q30_bits);
+}
+
+// rounds to nearest, ties towards positive infinity
+constexpr int64_t from_q30(int64_t q, size_t frac_bits) noexcept
+{
+	if (frac_bits >= q30_bits) {
+		return q * (int64_t(1) << (frac_bits - q30_bits));
+	}
+	const unsigned shift = unsigned(q30_bits - frac_bits);
+	return (q + (int64_t(1) << (shift - 1))) >> shift;
+}
+
+// square root rounded to nearest
+constexpr uint64_t sqrt(uint64_t n) noexcept
+{
+	uint64_t res = 0;
+	uint64_t bit = uint64_t(1) << 62;
+	while (bit > n) {
+		bit >>= 2;
+	}
+	while (bit != 0) {
+		if (n >= res + bit) {
+			n -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	// n is now the remainder of the rounded down root
+	if (n > res) {
+		++res;
+	}
+	return res;
+}
+
+struct sin_cos {
+	int64_t sin;
+	int64_t cos;
+};
+
+constexpr sin_cos cordic_sin_cos(int64_t angle) noexcept
+{
+	// reduce to [-pi, pi]
+	angle %= q30_two_pi;
+	if (angle > q30_pi) {
+		angle -= q30_two_pi;
+	} else if (angle < -q30_pi) {
+		angle += q30_two_pi;
+	}
+
+	// CORDIC converges for [-pi / 2, pi / 2], rotate the rest by pi
+	bool negate = false;
+	if (angle > q30_half_pi) {
+		angle -= q30_pi;
+		negate = true;
+	} else if (angle < -q30_half_pi) {
+		angle += q30_pi;
+		negate = true;
+	}
+
+	int64_t x = q30_cordic_gain;
+	int64_t y = 0;
+	for (size_t i = 0; i != num_cordic_iterations; ++i) {
+		const int64_t dx = y >> i;
+		const int64_t dy = x >> i;
+		if (angle >= 0) {
+			x -= dx;
+			y += dy;
+			angle -= q30_cordic_angles[i];
+		} else {
+			x += dx;
+			y -= dy;
+			angle += q30_cordic_angles[i];
+		}
+	}
+
+	if (negate) {
+		return {-y, -x};
+	}
+	return {y, x};
+}
+
+// arguments are of any same scale, the result is in Q2.30
+constexpr int64_t cordic_atan2(int64_t y, int64_t x) noexcept
+{
+	if (x == 0 && y == 0) {
+		return 0;
+	}
+
+	// scale the vector to [2^29, 2^30) magnitude range, to keep the precision of the shifts
+	auto magnitude = [](int64_t v) {
+		return v < 0 ? -v : v;
+	};
+	while (magnitude(x) >= q30_one || magnitude(y) >= q30_one) {
+		x >>= 1;
+		y >>= 1;
+	}
+	while (magnitude(x) < q30_one / 2 && magnitude(y) < q30_one / 2) {
+		x *= 2;
+		y *= 2;
+	}
+
+	// CORDIC converges for x >= 0, rotate the rest by pi
+	int64_t angle = 0;
+	if (x < 0) {
+		angle = y >= 0 ? q30_pi : -q30_pi;
+		x = -x;
+		y = -y;
+	}
+
+	for (size_t i = 0; i != num_cordic_iterations; ++i) {
+		const int64_t dx = y >> i;
+		const int64_t dy = x >> i;
+		if (y > 0) {
+			x += dx;
+			y -= dy;
+			angle += q30_cordic_angles[i];
+		} else {
+			x -= dx;
+			y += dy;
+			angle -= q30_cordic_angles[i];
+		}
+	}
+
+	return angle;
+}
+
+} // namespace fixed_internal
+
+/**
+ * @brief Fixed point number.
+ * Signed number stored in an integer of int_bits + frac_bits bits, which must be 8, 16 or 32.
+ * The value is the stored integer divided by 2^frac_bits.
+ *
+ * All operations are done in integer arithmetic, so the results are bit-identical on all platforms,
+ * which makes the type suitable for lockstep simulations.
+ * It can be used as component type of r4::vector, r4::matrix, r4::quaternion and other r4 types.
+ * The mathematical functions, i.e. sqrt(), sin(), cos(), tan(), asin(), acos(), atan(), atan2(),
+ * abs(), floor(), ceil() and round(), are found by argument dependent lookup:
+ * square root is calculated with integer algorithm, trigonometric functions with CORDIC algorithm.
+ *
+ * Multiplication rounds to nearest, division rounds towards zero.
+ * Division by zero gives the maximal or the minimal value, depending on the sign of the dividend.
+ * Conversions from integers are implicit, conversions from and to floating point types are explicit,
+ * conversion from floating point rounds to nearest and saturates regardless of the overflow behaviour.
+ *
+ * @tparam int_bits - number of integer bits, including the sign bit.
+ * @tparam frac_bits - number of fractional bits.
+ * @tparam overflow_behaviour - what happens when result does not fit to the representable range.
+ */
+template <size_t int_bits, size_t frac_bits, overflow overflow_behaviour = overflow::wrap>
+class fixed
+{
+	static_assert(
+		int_bits + frac_bits == 8 || int_bits + frac_bits == 16 || int_bits + frac_bits == 32,
+		"fixed point number must be 8, 16 or 32 bits"
+	);
+	static_assert(int_bits >= 1, "fixed point number must have sign bit");
+
+public:
+	/**
+	 * @brief Integer type storing the fixed point number.
+	 */
+	using raw_type = fixed_internal::raw_type<int_bits + frac_bits>;
+
+private:
+	raw_type raw;
+
+	constexpr static int64_t raw_min = std::numeric_limits<raw_type>::min();
+	constexpr static int64_t raw_max = std::numeric_limits<raw_type>::max();
+	constexpr static int64_t one = int64_t(1) << frac_bits;
+	constexpr static int64_t frac_mask = one - 1;
+
+	// convert result of operation to the raw type, according to overflow behaviour
+	constexpr static fixed narrow(int64_t v) noexcept
+	{
+		if constexpr (overflow_behaviour == overflow::saturate) {
+			return from_raw(raw_type(v > raw_max ? raw_max : (v < raw_min ? raw_min : v)));
+		} else {
+			using unsigned_type = std::make_unsigned_t<raw_type>;
+			return from_raw(raw_type(unsigned_type(uint64_t(v))));
+		}
+	}
+
+	// clamp integer to just beyond the representable range, so that multiplication by 'one' does not overflow int64_t
+	// and the product is still out of range for narrow() to saturate it
+	template <typename integer_type>
+	constexpr static int64_t clamp_integer(integer_type i) noexcept
+	{
+		constexpr int64_t max = (raw_max >> frac_bits) + 1;
+		constexpr int64_t min = (raw_min >> frac_bits) - 1;
+		if constexpr (std::is_signed_v<integer_type>) {
+			return int64_t(i) > max ? max : (int64_t(i) < min ? min : int64_t(i));
+		} else {
+			return uint64_t(i) > uint64_t(max) ? max : int64_t(i);
+		}
+	}
+
+	template <typename integer_type>
+	constexpr static fixed from_integer(integer_type i) noexcept
+	{
+		if constexpr (overflow_behaviour == overflow::saturate) {
+			return narrow(clamp_integer(i) * one);
+		} else {
+			// unsigned shift wraps around without overflow
+			using unsigned_type = std::make_unsigned_t<raw_type>;
+			return from_raw(raw_type(unsigned_type(uint64_t(i) << frac_bits)));
+		}
+	}
+
+	constexpr static int64_t round_shift(int64_t v) noexcept
+	{
+		if constexpr (frac_bits == 0) {
+			return v;
+		} else {
+			return (v + (one >> 1)) >> frac_bits;
+		}
+	}
+
+public:
+	/**
+	 * @brief Default constructor.
+	 * Default constructor does not initialize the value.
+	 */
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+	constexpr fixed() = default;
+
+	/**
+	 * @brief Construct from integer.
+	 * @param i - integer value.
+	 */
+	template <
+		typename integer_type, //
+		std::enable_if_t<std::is_integral_v<integer_type>, bool> = true>
+	constexpr fixed(integer_type i) noexcept :
+		raw(from_integer(i).raw)
+	{}
+
+	/**
+	 * @brief Construct from floating point number.
+	 * The value is rounded to nearest representable one, values out of range are saturated, NaN becomes zero.
+	 * @param f - floating point value.
+	 */
+	template <
+		typename float_type, //
+		std::enable_if_t<std::is_floating_point_v<float_type>, bool> = true>
+	constexpr explicit fixed(float_type f) noexcept :
+		raw(0)
+	{
+		const auto scaled = double(f) * double(one);
+		if (scaled >= double(raw_max)) {
+			this->raw = raw_type(raw_max);
+		} else if (scaled <= double(raw_min)) {
+			this->raw = raw_type(raw_min);
+		} else if (scaled >= 0) {
+			this->raw = raw_type(scaled + 0.5);
+		} else if (scaled < 0) {
+			this->raw = raw_type(-int64_t(-scaled + 0.5));
+		}
+	}
+
+	/**
+	 * @brief Create fixed point number from its integer representation.
+	 * @param raw - integer representation, i.e. the value multiplied by 2^frac_bits.
+	 * @return Fixed point number.
+	 */
+	constexpr static fixed from_raw(raw_type raw) noexcept
+	{
+		fixed ret{};
+		ret.raw = raw;
+		return ret;
+	}
+
+	/**
+	 * @brief Get integer representation.
+	 * @return The value multiplied by 2^frac_bits.
+	 */
+	constexpr raw_type get_raw() const noexcept
+	{
+		return this->raw;
+	}
+
+	/**
+	 * @brief Convert to floating point number.
+	 * @return Floating point value.
+	 */
+	template <
+		typename float_type, //
+		std::enable_if_t<std::is_floating_point_v<float_type>, bool> = true>
+	constexpr explicit operator float_type() const noexcept
+	{
+		return float_type(double(this->raw) / double(one));
+	}
+
+	/**
+	 * @brief Convert to integer.
+	 * The value is rounded towards zero.
+	 * @return Integer value.
+	 */
+	template <
+		typename integer_type, //
+		std::enable_if_t<std::is_integral_v<integer_type>, bool> = true>
+	constexpr explicit operator integer_type() const noexcept
+	{
+		return integer_type(int64_t(this->raw) / one);
+	}
+
+	constexpr fixed operator-() const noexcept
+	{
+		return narrow(-int64_t(this->raw));
+	}
+
+	constexpr fixed operator+() const noexcept
+	{
+		return *this;
+	}
+
+	constexpr fixed& operator+=(fixed f) noexcept
+	{
+		return *this = *this + f;
+	}
+
+	constexpr fixed& operator-=(fixed f) noexcept
+	{
+		return *this = *this - f;
+	}
+
+	constexpr fixed& operator*=(fixed f) noexcept
+	{
+		return *this = *this * f;
+	}
+
+	constexpr fixed& operator/=(fixed f) noexcept
+	{
+		return *this = *this / f;
+	}
+
+	friend constexpr fixed operator+(fixed a, fixed b) noexcept
+	{
+		return narrow(int64_t(a.raw) + int64_t(b.raw));
+	}
+
+	friend constexpr fixed operator-(fixed a, fixed b) noexcept
+	{
+		return narrow(int64_t(a.raw) - int64_t(b.raw));
+	}
+
+	friend constexpr fixed operator*(fixed a, fixed b) noexcept
+	{
+		return narrow(round_shift(int64_t(a.raw) * int64_t(b.raw)));
+	}
+
+	friend constexpr fixed operator/(fixed a, fixed b) noexcept
+	{
+		if (b.raw == 0) {
+			return from_raw(raw_type(a.raw < 0 ? raw_min : raw_max));
+		}
+		return narrow(int64_t(a.raw) * one / int64_t(b.raw));
+	}
+
+	friend constexpr bool operator==(fixed a, fixed b) noexcept
+	{
+		return a.raw == b.raw;
+	}
+
+	friend constexpr bool operator!=(fixed a, fixed b) noexcept
+	{
+		return a.raw != b.raw;
+	}
+
+	friend constexpr bool operator<(fixed a, fixed b) noexcept
+	{
+		return a.raw < b.raw;
+	}
+
+	friend constexpr bool operator<=(fixed a, fixed b) noexcept
+	{
+		return a.raw <= b.raw;
+	}
+
+	friend constexpr bool operator>(fixed a, fixed b) noexcept
+	{
+		return a.raw > b.raw;
+	}
+
+	friend constexpr bool operator>=(fixed a, fixed b) noexcept
+	{
+		return a.raw >= b.raw;
+	}
+
+	friend constexpr fixed abs(fixed f) noexcept
+	{
+		return f.raw < 0 ? -f : f;
+	}
+
+	friend constexpr fixed floor(fixed f) noexcept
+	{
+		return narrow(int64_t(f.raw) & ~frac_mask);
+	}
+
+	friend constexpr fixed ceil(fixed f) noexcept
+	{
+		return narrow((int64_t(f.raw) + frac_mask) & ~frac_mask);
+	}
+
+	/**
+	 * @brief Round to nearest integer.
+	 * Halfway values are rounded away from zero, same as std::round().
+	 * @param f - number to round.
+	 * @return Rounded number.
+	 */
+	friend constexpr fixed round(fixed f) noexcept
+	{
+		const int64_t half = one >> 1;
+		const int64_t v = f.raw;
+		if (v >= 0) {
+			return narrow((v + half) & ~frac_mask);
+		}
+		return narrow(-((-v + half) & ~frac_mask));
+	}
+
+	/**
+	 * @brief Square root.
+	 * @param f - number to calculate square root of.
+	 * @return Square root rounded to nearest, zero for negative numbers.
+	 */
+	friend constexpr fixed sqrt(fixed f) noexcept
+	{
+		if (f.raw <= 0) {
+			return fixed(0);
+		}
+		// sqrt(raw * 2^frac_bits) = sqrt(raw / 2^frac_bits) * 2^frac_bits
+		return narrow(int64_t(fixed_internal::sqrt(uint64_t(f.raw) << frac_bits)));
+	}
+
+	friend constexpr fixed sin(fixed angle) noexcept
+	{
+		auto sc = fixed_internal::cordic_sin_cos(fixed_internal::to_q30(angle.raw, frac_bits));
+		return narrow(fixed_internal::from_q30(sc.sin, frac_bits));
+	}
+
+	friend constexpr fixed cos(fixed angle) noexcept
+	{
+		auto sc = fixed_internal::cordic_sin_cos(fixed_internal::to_q30(angle.raw, frac_bits));
+		return narrow(fixed_internal::from_q30(sc.cos, frac_bits));
+	}
+
+	/**
+	 * @brief Tangent.
+	 * @param angle - angle in radians.
+	 * @return Tangent of the angle, maximal or minimal value if cosine of the angle is zero.
+	 */
+	friend constexpr fixed tan(fixed angle) noexcept
+	{
+		auto sc = fixed_internal::cordic_sin_cos(fixed_internal::to_q30(angle.raw, frac_bits));
+		if (sc.cos == 0) {
+			return from_raw(raw_type(sc.sin < 0 ? raw_min : raw_max));
+		}
+		return narrow(fixed_internal::from_q30(sc.sin * fixed_internal::q30_one / sc.cos, frac_bits));
+	}
+
+	friend constexpr fixed atan2(fixed y, fixed x) noexcept
+	{
+		return narrow(fixed_internal::from_q30(fixed_internal::cordic_atan2(y.raw, x.raw), frac_bits));
+	}
+
+	friend constexpr fixed atan(fixed f) noexcept
+	{
+		return narrow(fixed_internal::from_q30(fixed_internal::cordic_atan2(f.raw, one), frac_bits));
+	}
+
+	/**
+	 * @brief Arcsine.
+	 * @param f - number in [-1, 1] range, numbers outside of the range are clamped to it.
+	 * @return Arcsine of the number.
+	 */
+	friend constexpr fixed asin(fixed f) noexcept
+	{
+		auto c = clamped_q30_cos(f);
+		return narrow(fixed_internal::from_q30(fixed_internal::cordic_atan2(c.sin, c.cos), frac_bits));
+	}
+
+	/**
+	 * @brief Arccosine.
+	 * @param f - number in [-1, 1] range, numbers outside of the range are clamped to it.
+	 * @return Arccosine of the number.
+	 */
+	friend constexpr fixed acos(fixed f) noexcept
+	{
+		auto c = clamped_q30_cos(f);
+		return narrow(fixed_internal::from_q30(fixed_internal::cordic_atan2(c.cos, c.sin), frac_bits));
+	}
+
+private:
+	// for a number in [-1, 1] range, treated as sine of some angle, calculate the cosine of that angle
+	constexpr static fixed_internal::sin_cos clamped_q30_cos(fixed f) noexcept
+	{
+		int64_t s = fixed_internal::to_q30(f.raw, frac_bits);
+		s = s > fixed_internal::q30_one ? fixed_internal::q30_one : s;
+		s = s < -fixed_internal::q30_one ? -fixed_internal::q30_one : s;
+		auto c = int64_t(fixed_internal::sqrt(uint64_t(fixed_internal::q30_one * fixed_internal::q30_one - s * s)));
+		return {s, c};
+	}
+};
+
+} // namespace r4
+
+#ifdef R4_SIMD_SSE4_1
+
+namespace r4::simd {
+
+// Kernels for 4 component vectors of 32-bit wrapping fixed point numbers.
+// The results are bit-identical to the scalar implementation.
+template <size_t int_bits, size_t frac_bits>
+struct vector_kernels<fixed<int_bits, frac_bits, overflow::wrap>, 4> {
+	constexpr static bool enabled = int_bits + frac_bits == 32;
+
+	using fixed_type = fixed<int_bits, frac_bits, overflow::wrap>;
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+	static __m128i load(const fixed_type* p) noexcept
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+	}
+
+	static void store(fixed_type* p, __m128i v) noexcept
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+	}
+
+	// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+	static __m128i broadcast(fixed_type num) noexcept
+	{
+		return _mm_set1_epi32(num.get_raw());
+	}
+
+	static __m128i mul(__m128i a, __m128i b) noexcept
+	{
+		// _mm_mul_epi32() multiplies lanes 0 and 2 to 64-bit products,
+		// lanes 1 and 3 are multiplied after shifting them to lanes 0 and 2.
+		// Only the lower 32 bits of the shifted products are kept, those are same for
+		// logical and arithmetic shifts, since there are at most 31 fractional bits.
+		const __m128i rounding = _mm_set1_epi64x((int64_t(1) << frac_bits) >> 1);
+		__m128i even = _mm_add_epi64(_mm_mul_epi32(a, b), rounding);
+		__m128i odd = _mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), rounding);
+		even = _mm_srli_epi64(even, int(frac_bits));
+		odd = _mm_slli_epi64(_mm_srli_epi64(odd, int(frac_bits)), 32);
+		return _mm_blend_epi16(even, odd, 0xcc);
+	}
+
+	static int32_t reduce_add(__m128i v) noexcept
+	{
+		__m128i s = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+		s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtsi128_si32(s);
+	}
+
+	static void set(fixed_type* res, fixed_type num) noexcept
+	{
+		store(res, broadcast(num));
+	}
+
+	static void add(const fixed_type* a, const fixed_type* b, fixed_type* res) noexcept
+	{
+		store(res, _mm_add_epi32(load(a), load(b)));
+	}
+
+	static void add(const fixed_type* a, fixed_type num, fixed_type* res) noexcept
+	{
+		store(res, _mm_add_epi32(load(a), broadcast(num)));
+	}
+
+	static void sub(const fixed_type* a, const fixed_type* b, fixed_type* res) noexcept
+	{
+		store(res, _mm_sub_epi32(load(a), load(b)));
+	}
+
+	static void mul(const fixed_type* a, const fixed_type* b, fixed_type* res) noexcept
+	{
+		store(res, mul(load(a), load(b)));
+	}
+
+	static void mul(const fixed_type* a, fixed_type num, fixed_type* res) noexcept
+	{
+		store(res, mul(load(a), broadcast(num)));
+	}
+
+	// there is no SIMD integer division, so division is done one component at a time
+
+	static void div(const fixed_type* a, const fixed_type* b, fixed_type* res) noexcept
+	{
+		for (size_t i = 0; i != 4; ++i) {
+			res[i] = a[i] / b[i];
+		}
+	}
+
+	static void div(const fixed_type* a, fixed_type num, fixed_type* res) noexcept
+	{
+		for (size_t i = 0; i != 4; ++i) {
+			res[i] = a[i] / num;
+		}
+	}
+
+	static void negate(const fixed_type* a, fixed_type* res) noexcept
+	{
+		store(res, _mm_sub_epi32(_mm_setzero_si128(), load(a)));
+	}
+
+	static void abs(const fixed_type* a, fixed_type* res) noexcept
+	{
+		store(res, _mm_abs_epi32(load(a)));
+	}
+
+	static void min(const fixed_type* a, const fixed_type* b, fixed_type* res) noexcept
+	{
+		store(res, _mm_min_epi32(load(a), load(b)));
+	}
+
+	static void max(const fixed_type* a, const fixed_type* b, fixed_type* res) noexcept
+	{
+		store(res, _mm_max_epi32(load(a), load(b)));
+	}
+
+	// wrapping addition is associative, so the sums are same as of the scalar implementation
+
+	static fixed_type dot(const fixed_type* a, const fixed_type* b) noexcept
+	{
+		return fixed_type::from_raw(reduce_add(mul(load(a), load(b))));
+	}
+
+	static fixed_type sum(const fixed_type* a) noexcept
+	{
+		return fixed_type::from_raw(reduce_add(load(a)));
+	}
+
+	static fixed_type min_component(const fixed_type* a) noexcept
+	{
+		__m128i v = load(a);
+		v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+		v = _mm_min_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+		return fixed_type::from_raw(_mm_cvtsi128_si32(v));
+	}
+
+	static fixed_type max_component(const fixed_type* a) noexcept
+	{
+		__m128i v = load(a);
+		v = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+		v = _mm_max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+		return fixed_type::from_raw(_mm_cvtsi128_si32(v));
+	}
+
+	constexpr static bool has_rounding = true;
+
+	static __m128i frac_mask() noexcept
+	{
+		return _mm_set1_epi32(int32_t((uint64_t(1) << frac_bits) - 1));
+	}
+
+	static void floor(const fixed_type* a, fixed_type* res) noexcept
+	{
+		store(res, _mm_andnot_si128(frac_mask(), load(a)));
+	}
+
+	static void ceil(const fixed_type* a, fixed_type* res) noexcept
+	{
+		__m128i mask = frac_mask();
+		store(res, _mm_andnot_si128(mask, _mm_add_epi32(load(a), mask)));
+	}
+};
+
+} // namespace r4::simd
+
+#endif // ~R4_SIMD_SSE4_1
+
+namespace std {
+
+template <size_t int_bits, size_t frac_bits, r4::overflow overflow_behaviour>
+class numeric_limits<r4::fixed<int_bits, frac_bits, overflow_behaviour>>
+{
+	using fixed_type = r4::fixed<int_bits, frac_bits, overflow_behaviour>;
+	using raw_limits = numeric_limits<typename fixed_type::raw_type>;
+
+public:
+	constexpr static bool is_specialized = true;
+	constexpr static bool is_signed = true;
+	constexpr static bool is_integer = false;
+	constexpr static bool is_exact = true;
+	constexpr static bool has_infinity = false;
+	constexpr static bool has_quiet_NaN = false;
+	constexpr static bool has_signaling_NaN = false;
+	constexpr static bool is_bounded = true;
+	constexpr static bool is_modulo = overflow_behaviour == r4::overflow::wrap;
+	constexpr static int radix = 2;
+	constexpr static int digits = int(int_bits + frac_bits - 1);
+
+	/**
+	 * @brief Smallest positive value.
+	 * Same as for floating point types.
+	 */
+	constexpr static fixed_type min() noexcept
+	{
+		return fixed_type::from_raw(1);
+	}
+
+	constexpr static fixed_type max() noexcept
+	{
+		return fixed_type::from_raw(raw_limits::max());
+	}
+
+	constexpr static fixed_type lowest() noexcept
+	{
+		return fixed_type::from_raw(raw_limits::min());
+	}
+
+	constexpr static fixed_type epsilon() noexcept
+	{
+		return fixed_type::from_raw(1);
+	}
+
+	constexpr static fixed_type round_error() noexcept
+	{
+		if constexpr (frac_bits == 0) {
+			return fixed_type(0);
+		} else {
+			return fixed_type::from_raw(typename fixed_type::raw_type(int64_t(1) << (frac_bits - 1)));
+		}
+	}
+};
+
+} // namespace std
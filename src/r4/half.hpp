@@ -0,0 +1,378 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include "simd.hpp"
+
+namespace r4 {
+
+namespace half_internal {
+
+inline uint32_t to_bits(float f) noexcept
+{
+	uint32_t u = 0;
+	std::memcpy(&u, &f, sizeof(u));
+	return u;
+}
+
+inline float from_bits(uint32_t u) noexcept
+{
+	float f = 0;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+// The conversions give same results as the F16C instructions,
+// including NaNs, which are made quiet and keep the upper bits of the payload.
+
+inline uint16_t float_to_half(float f) noexcept
+{
+#ifdef R4_SIMD_F16C
+	return uint16_t(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+	constexpr uint32_t sign_mask = 0x80000000;
+	constexpr uint32_t infinity = 0x7f800000;
+	constexpr uint32_t half_infinity = 0x7c00;
+	constexpr uint32_t half_quiet_bit = 0x200;
+	constexpr uint32_t half_mantissa_mask = 0x3ff;
+	constexpr int mantissa_shift = 13; // 23 float mantissa bits - 10 half mantissa bits
+
+	// smallest float which rounds to half infinity is 65520, but all floats from 65536 and above are rounded
+	// to infinity by the exponent check below, and the ones from [65520, 65536) by the rounding itself
+	constexpr uint32_t half_overflow = (127 + 16) << 23; // 65536
+
+	// smallest normal half is 2^-14
+	constexpr uint32_t half_min_normal = (127 - 14) << 23;
+
+	// adding this to a subnormal half value aligns the half mantissa bits at the bottom of the float mantissa,
+	// and the float addition rounds to nearest even
+	constexpr uint32_t denormal_magic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+	uint32_t u = half_internal::to_bits(f);
+	const uint32_t sign = (u & sign_mask) >> 16;
+	u &= ~sign_mask;
+
+	if (u >= half_overflow) {
+		if (u > infinity) {
+			return uint16_t(sign | half_infinity | half_quiet_bit | ((u >> mantissa_shift) & half_mantissa_mask));
+		}
+		return uint16_t(sign | half_infinity);
+	}
+
+	if (u < half_min_normal) {
+		const float aligned = half_internal::from_bits(u) + half_internal::from_bits(denormal_magic);
+		return uint16_t(sign | (half_internal::to_bits(aligned) - denormal_magic));
+	}
+
+	// rebias the exponent and round to nearest even
+	const uint32_t mantissa_odd = (u >> mantissa_shift) & 1;
+	u += (uint32_t(15 - 127) << 23) + 0xfff + mantissa_odd;
+	return uint16_t(sign | (u >> mantissa_shift));
+#endif
+}
+
+inline float half_to_float(uint16_t h) noexcept
+{
+#ifdef R4_SIMD_F16C
+	return _cvtsh_ss(h);
+#else
+	constexpr uint32_t exponent_mask = 0x7c00 << 13; // half exponent bits in float position
+	constexpr uint32_t rebias = uint32_t(127 - 15) << 23;
+	constexpr uint32_t float_quiet_bit = 0x400000;
+	constexpr uint32_t magic = 113 << 23; // 2^-14, smallest normal half
+
+	uint32_t u = uint32_t(h & 0x7fff) << 13;
+	const uint32_t exponent = u & exponent_mask;
+	u += rebias;
+
+	if (exponent == exponent_mask) {
+		// infinity or NaN
+		u += uint32_t(128 - 16) << 23;
+		if (u & 0x7fffff) {
+			u |= float_quiet_bit;
+		}
+	} else if (exponent == 0) {
+		// zero or subnormal, renormalize
+		u += 1 << 23;
+		u = half_internal::to_bits(half_internal::from_bits(u) - half_internal::from_bits(magic));
+	}
+
+	return half_internal::from_bits(u | (uint32_t(h & 0x8000) << 16));
+#endif
+}
+
+inline uint16_t float_to_bfloat16(float f) noexcept
+{
+	constexpr uint32_t quiet_bit = 0x400000;
+
+	uint32_t u = half_internal::to_bits(f);
+	if ((u & 0x7fffffff) > 0x7f800000) {
+		// NaN, make it quiet, otherwise truncation of the payload could turn it to infinity
+		return uint16_t((u | quiet_bit) >> 16);
+	}
+
+	// round to nearest even
+	u += 0x7fff + ((u >> 16) & 1);
+	return uint16_t(u >> 16);
+}
+
+inline float bfloat16_to_float(uint16_t b) noexcept
+{
+	return half_internal::from_bits(uint32_t(b) << 16);
+}
+
+} // namespace half_internal
+
+/**
+ * @brief IEEE 754 half precision floating point number.
+ * 1 sign bit, 5 exponent bits and 10 mantissa bits, the largest finite value is 65504.
+ * This is a storage type, it only converts to and from float, so it can be used as a component type of
+ * vectors and matrices which are stored in memory, e.g. vertex attributes uploaded to GPU.
+ * Convert such vectors to float with vector::to<float>() before doing arithmetic on them.
+ * Conversion from float rounds to nearest even, values outside of the half range become infinities.
+ * When compiled with F16C instructions enabled the conversions use those instructions.
+ * To convert large arrays use r4::dispatch::convert() from r4/dispatch.hpp.
+ */
+class half
+{
+	uint16_t bits;
+
+public:
+	/**
+	 * @brief Default constructor.
+	 * Default constructor does not initialize the value.
+	 */
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+	half() = default;
+
+	/**
+	 * @brief Construct from float.
+	 * @param f - value to convert to half precision.
+	 */
+	half(float f) noexcept :
+		bits(half_internal::float_to_half(f))
+	{}
+
+	/**
+	 * @brief Convert to float.
+	 * The conversion is exact.
+	 * @return Value converted to float.
+	 */
+	operator float() const noexcept
+	{
+		return half_internal::half_to_float(this->bits);
+	}
+
+	/**
+	 * @brief Get binary representation.
+	 * @return Bits of the half precision number.
+	 */
+	uint16_t get_bits() const noexcept
+	{
+		return this->bits;
+	}
+
+	/**
+	 * @brief Create half precision number from its binary representation.
+	 * @param bits - bits of the half precision number.
+	 * @return Half precision number.
+	 */
+	static half from_bits(uint16_t bits) noexcept
+	{
+		half ret;
+		ret.bits = bits;
+		return ret;
+	}
+};
+
+static_assert(sizeof(half) == 2, "half must be 2 bytes");
+
+/**
+ * @brief Brain floating point number.
+ * Upper 16 bits of float: 1 sign bit, 8 exponent bits and 7 mantissa bits.
+ * Same range as float with lower precision.
+ * Like r4::half, this is a storage type, it only converts to and from float.
+ * Conversion from float rounds to nearest even, conversion to float is exact.
+ * To convert large arrays use r4::dispatch::convert() from r4/dispatch.hpp.
+ */
+class bfloat16
+{
+	uint16_t bits;
+
+public:
+	/**
+	 * @brief Default constructor.
+	 * Default constructor does not initialize the value.
+	 */
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+	bfloat16() = default;
+
+	/**
+	 * @brief Construct from float.
+	 * @param f - value to convert to bfloat16.
+	 */
+	bfloat16(float f) noexcept :
+		bits(half_internal::float_to_bfloat16(f))
+	{}
+
+	/**
+	 * @brief Convert to float.
+	 * The conversion is exact.
+	 * @return Value converted to float.
+	 */
+	operator float() const noexcept
+	{
+		return half_internal::bfloat16_to_float(this->bits);
+	}
+
+	/**
+	 * @brief Get binary representation.
+	 * @return Bits of the bfloat16 number.
+	 */
+	uint16_t get_bits() const noexcept
+	{
+		return this->bits;
+	}
+
+	/**
+	 * @brief Create bfloat16 number from its binary representation.
+	 * @param bits - bits of the bfloat16 number.
+	 * @return bfloat16 number.
+	 */
+	static bfloat16 from_bits(uint16_t bits) noexcept
+	{
+		bfloat16 ret;
+		ret.bits = bits;
+		return ret;
+	}
+};
+
+static_assert(sizeof(bfloat16) == 2, "bfloat16 must be 2 bytes");
+
+} // namespace r4
+
+namespace r4::simd {
+
+// vector::to() conversions of vectors with number of components multiple of 4
+
+#ifdef R4_SIMD_F16C
+
+template <size_t dimension>
+struct conversion_kernels<half, float, dimension> {
+	constexpr static bool enabled = dimension % 4 == 0;
+
+	static void convert(const half* in, float* out) noexcept
+	{
+		size_t i = 0;
+		for (; i + 8 <= dimension; i += 8) {
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(std::next(in, i)));
+			_mm256_storeu_ps(std::next(out, i), _mm256_cvtph_ps(h));
+		}
+		if constexpr (dimension % 8 != 0) {
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			__m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(std::next(in, i)));
+			_mm_storeu_ps(std::next(out, i), _mm_cvtph_ps(h));
+		}
+	}
+};
+
+template <size_t dimension>
+struct conversion_kernels<float, half, dimension> {
+	constexpr static bool enabled = dimension % 4 == 0;
+
+	static void convert(const float* in, half* out) noexcept
+	{
+		size_t i = 0;
+		for (; i + 8 <= dimension; i += 8) {
+			__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(std::next(in, i)), _MM_FROUND_TO_NEAREST_INT);
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(std::next(out, i)), h);
+		}
+		if constexpr (dimension % 8 != 0) {
+			__m128i h = _mm_cvtps_ph(_mm_loadu_ps(std::next(in, i)), _MM_FROUND_TO_NEAREST_INT);
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(std::next(out, i)), h);
+		}
+	}
+};
+
+#endif // ~R4_SIMD_F16C
+
+#ifdef R4_SIMD_SSE2
+
+template <size_t dimension>
+struct conversion_kernels<bfloat16, float, dimension> {
+	constexpr static bool enabled = dimension % 4 == 0;
+
+	static void convert(const bfloat16* in, float* out) noexcept
+	{
+		for (size_t i = 0; i != dimension; i += 4) {
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			__m128i b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(std::next(in, i)));
+			// interleaving with zeros shifts each value to the upper half of 32 bits
+			_mm_storeu_ps(std::next(out, i), _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), b)));
+		}
+	}
+};
+
+template <size_t dimension>
+struct conversion_kernels<float, bfloat16, dimension> {
+	constexpr static bool enabled = dimension % 4 == 0;
+
+	static void convert(const float* in, bfloat16* out) noexcept
+	{
+		const __m128i one = _mm_set1_epi32(1);
+		const __m128i rounding_bias = _mm_set1_epi32(0x7fff);
+		const __m128i quiet_bit = _mm_set1_epi32(0x400000);
+
+		for (size_t i = 0; i != dimension; i += 4) {
+			__m128 f = _mm_loadu_ps(std::next(in, i));
+			__m128i u = _mm_castps_si128(f);
+
+			// same as half_internal::float_to_bfloat16()
+			__m128i lsb = _mm_and_si128(_mm_srli_epi32(u, 16), one);
+			__m128i rounded = _mm_add_epi32(u, _mm_add_epi32(rounding_bias, lsb));
+			__m128i is_nan = _mm_castps_si128(_mm_cmpunord_ps(f, f));
+			__m128i r = _mm_or_si128(_mm_and_si128(is_nan, _mm_or_si128(u, quiet_bit)), _mm_andnot_si128(is_nan, rounded));
+
+			// arithmetic shift keeps the values in the signed 16 bit range, so the signed saturation does not change them
+			__m128i b = _mm_packs_epi32(_mm_srai_epi32(r, 16), _mm_setzero_si128());
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(std::next(out, i)), b);
+		}
+	}
+};
+
+#endif // ~R4_SIMD_SSE2
+
+} // namespace r4::simd
@@ -0,0 +1,104 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+#include "affine3.hpp"
+#include "fixed.hpp"
+#include "matrix.hpp"
+#include "quaternion.hpp"
+#include "rectangle.hpp"
+#include "vector.hpp"
+
+// The stream output operators are kept separately from the core headers,
+// so that including the core headers does not bring in the standard streams library.
+
+namespace r4 {
+
+template <size_t int_bits, size_t frac_bits, overflow overflow_behaviour>
+std::ostream& operator<<(std::ostream& s, fixed<int_bits, frac_bits, overflow_behaviour> f)
+{
+	s << double(f);
+	return s;
+}
+
+template <class component_type, size_t dimension>
+std::ostream& operator<<(std::ostream& s, const vector<component_type, dimension>& vec)
+{
+	static_assert(dimension >= 1, "dimension cannot be 0");
+	if constexpr (std::is_same_v<component_type, uint8_t>) {
+		s << unsigned(vec.x());
+	} else {
+		s << vec.x();
+	}
+	for (auto i = std::next(vec.begin()); i != vec.end(); ++i) {
+		s << " ";
+		if constexpr (std::is_same_v<component_type, uint8_t>) {
+			s << unsigned(*i);
+		} else {
+			s << (*i);
+		}
+	}
+	return s;
+}
+
+template <class component_type, size_t num_rows, size_t num_columns>
+std::ostream& operator<<(std::ostream& s, const matrix<component_type, num_rows, num_columns>& mat)
+{
+	for (auto& r : mat) {
+		s << "|" << r << std::endl;
+	}
+	return s;
+}
+
+template <class component_type>
+std::ostream& operator<<(std::ostream& s, const quaternion<component_type>& quat)
+{
+	s << "(" << quat.x() << " " << quat.y() << " " << quat.z() << " " << quat.w() << ")";
+	return s;
+}
+
+template <class component_type>
+std::ostream& operator<<(std::ostream& s, const rectangle<component_type>& rect)
+{
+	s << "(" << rect.p << ")(" << rect.d << ")";
+	return s;
+}
+
+template <class component_type>
+std::ostream& operator<<(std::ostream& s, const affine3<component_type>& a)
+{
+	for (auto& r : a) {
+		s << "|" << r << std::endl;
+	}
+	return s;
+}
+
+} // namespace r4
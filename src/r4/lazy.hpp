@@ -0,0 +1,359 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+// Lazy vector expressions.
+//
+// Regular r4::vector operators return the resulting vector by value, so an expression
+// like 'a * s + b - c' creates a temporary vector for each operator. In optimized builds
+// those temporaries are usually optimized away, but in debug builds they are not.
+//
+// Wrapping one of the operands into r4::lazy() makes the expression to build a lightweight
+// expression tree instead, which is evaluated component-wise in a single pass when it is
+// converted to r4::vector:
+//
+//     r4::vector3<float> r = r4::lazy(a) * s + b - c;
+//
+// Supported operations are: addition and subtraction of expressions and vectors,
+// multiplication and division by a number, unary minus.
+//
+// Expression objects hold references to operand vectors, so expressions are supposed to be
+// evaluated within the same full expression where they were created and not to be stored
+// in variables, e.g. with 'auto'.
+
+namespace r4 {
+
+/**
+ * @brief Base class of lazy vector expressions.
+ * @tparam derived_type - actual expression type.
+ * @tparam component_type - type of the resulting vector components.
+ * @tparam dimension - dimension of the resulting vector.
+ */
+template <typename derived_type, typename component_type, size_t dimension>
+class lazy_expression
+{
+	template <size_t... indices>
+	constexpr vector<component_type, dimension> eval(std::index_sequence<indices...>) const noexcept
+	{
+		return vector<component_type, dimension>{this->derived()[indices]...};
+	}
+
+public:
+	using result_type = vector<component_type, dimension>;
+
+	constexpr const derived_type& derived() const noexcept
+	{
+		return static_cast<const derived_type&>(*this);
+	}
+
+	/**
+	 * @brief Evaluate the expression.
+	 * @return vector resulting from the expression.
+	 */
+	constexpr vector<component_type, dimension> eval() const noexcept
+	{
+		return this->eval(std::make_index_sequence<dimension>());
+	}
+
+	/**
+	 * @brief Evaluate the expression.
+	 * Same as eval().
+	 */
+	// NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+	constexpr operator vector<component_type, dimension>() const noexcept
+	{
+		return this->eval();
+	}
+};
+
+namespace lazy_internal {
+
+template <typename type>
+struct non_deduced {
+	using value_type = type;
+};
+
+template <typename type>
+using non_deduced_t = typename non_deduced<type>::value_type;
+
+template <typename component_type, size_t dimension>
+class terminal : public lazy_expression<terminal<component_type, dimension>, component_type, dimension>
+{
+	const vector<component_type, dimension>& vec;
+
+public:
+	constexpr explicit terminal(const vector<component_type, dimension>& vec) noexcept :
+		vec(vec)
+	{}
+
+	constexpr component_type operator[](size_t i) const noexcept
+	{
+		return this->vec[i];
+	}
+};
+
+template <typename component_type, size_t dimension>
+class scalar : public lazy_expression<scalar<component_type, dimension>, component_type, dimension>
+{
+	component_type num;
+
+public:
+	constexpr explicit scalar(component_type num) noexcept :
+		num(num)
+	{}
+
+	constexpr component_type operator[](size_t) const noexcept
+	{
+		return this->num;
+	}
+};
+
+template <typename operand_type, typename operation_type, typename component_type, size_t dimension>
+class unary :
+	public lazy_expression<unary<operand_type, operation_type, component_type, dimension>, component_type, dimension>
+{
+	operand_type operand;
+
+public:
+	constexpr explicit unary(const operand_type& operand) noexcept :
+		operand(operand)
+	{}
+
+	constexpr component_type operator[](size_t i) const noexcept
+	{
+		return operation_type()(this->operand[i]);
+	}
+};
+
+template <
+	typename left_type,
+	typename right_type,
+	typename operation_type,
+	typename component_type,
+	size_t dimension>
+class binary :
+	public lazy_expression<
+		binary<left_type, right_type, operation_type, component_type, dimension>,
+		component_type,
+		dimension>
+{
+	left_type left;
+	right_type right;
+
+public:
+	constexpr binary(const left_type& left, const right_type& right) noexcept :
+		left(left),
+		right(right)
+	{}
+
+	constexpr component_type operator[](size_t i) const noexcept
+	{
+		return operation_type()(this->left[i], this->right[i]);
+	}
+};
+
+// convert operand to expression node: vectors are wrapped into terminal node, expressions are taken as is
+template <typename derived_type, typename component_type, size_t dimension>
+constexpr const derived_type& to_node(const lazy_expression<derived_type, component_type, dimension>& e) noexcept
+{
+	return e.derived();
+}
+
+template <typename component_type, size_t dimension>
+constexpr terminal<component_type, dimension> to_node(const vector<component_type, dimension>& v) noexcept
+{
+	return terminal<component_type, dimension>(v);
+}
+
+template <typename type>
+struct is_vector : std::false_type {};
+
+template <typename component_type, size_t dimension>
+struct is_vector<vector<component_type, dimension>> : std::true_type {
+	static constexpr size_t size = dimension;
+};
+
+template <typename type, typename = void>
+struct is_lazy_expression : std::false_type {};
+
+template <typename type>
+struct is_lazy_expression<type, std::void_t<typename type::result_type>> :
+	std::bool_constant<std::is_base_of_v<
+		lazy_expression<type, typename type::result_type::value_type, is_vector<typename type::result_type>::size>,
+		type>> {};
+
+// at least one of the operands must be an expression and both operands must result in same vector type
+template <typename left_type, typename right_type, typename = void>
+struct are_operands : std::false_type {};
+
+template <typename left_type, typename right_type>
+struct are_operands<
+	left_type,
+	right_type,
+	std::enable_if_t<
+		(is_lazy_expression<left_type>::value && (is_lazy_expression<right_type>::value || is_vector<right_type>::value)) ||
+		(is_vector<left_type>::value && is_lazy_expression<right_type>::value)>> :
+	std::bool_constant<std::is_same_v<
+		decltype(to_node(std::declval<const left_type&>()).eval()),
+		decltype(to_node(std::declval<const right_type&>()).eval())>> {};
+
+template <typename operation_type, typename left_type, typename right_type>
+constexpr auto make_binary(const left_type& left, const right_type& right) noexcept
+{
+	using left_node_type = std::decay_t<decltype(to_node(left))>;
+	using right_node_type = std::decay_t<decltype(to_node(right))>;
+	using result_type = typename left_node_type::result_type;
+
+	return binary<
+		left_node_type,
+		right_node_type,
+		operation_type,
+		typename result_type::value_type,
+		is_vector<result_type>::size>(to_node(left), to_node(right));
+}
+
+} // namespace lazy_internal
+
+/**
+ * @brief Start lazy vector expression.
+ * @param v - vector to use as an operand of the lazy expression.
+ * @return lazy expression object.
+ */
+template <typename component_type, size_t dimension>
+constexpr lazy_internal::terminal<component_type, dimension> lazy(const vector<component_type, dimension>& v) noexcept
+{
+	return lazy_internal::terminal<component_type, dimension>(v);
+}
+
+/**
+ * @brief Add lazy expressions or vectors component-wise.
+ * At least one of the operands must be a lazy expression.
+ * @param left - left operand.
+ * @param right - right operand.
+ * @return lazy expression object.
+ */
+template <
+	typename left_type,
+	typename right_type,
+	std::enable_if_t<lazy_internal::are_operands<left_type, right_type>::value, bool> = true>
+constexpr auto operator+(const left_type& left, const right_type& right) noexcept
+{
+	return lazy_internal::make_binary<std::plus<>>(left, right);
+}
+
+/**
+ * @brief Subtract lazy expressions or vectors component-wise.
+ * At least one of the operands must be a lazy expression.
+ * @param left - left operand.
+ * @param right - right operand.
+ * @return lazy expression object.
+ */
+template <
+	typename left_type,
+	typename right_type,
+	std::enable_if_t<lazy_internal::are_operands<left_type, right_type>::value, bool> = true>
+constexpr auto operator-(const left_type& left, const right_type& right) noexcept
+{
+	return lazy_internal::make_binary<std::minus<>>(left, right);
+}
+
+/**
+ * @brief Multiply lazy expression by number.
+ * @param e - lazy expression.
+ * @param num - number to multiply by.
+ * @return lazy expression object.
+ */
+template <typename derived_type, typename component_type, size_t dimension>
+constexpr auto operator*(
+	const lazy_expression<derived_type, component_type, dimension>& e,
+	lazy_internal::non_deduced_t<component_type> num
+) noexcept
+{
+	return lazy_internal::
+		binary<derived_type, lazy_internal::scalar<component_type, dimension>, std::multiplies<>, component_type, dimension>(
+			e.derived(),
+			lazy_internal::scalar<component_type, dimension>(num)
+		);
+}
+
+/**
+ * @brief Multiply number by lazy expression.
+ * @param num - number to multiply.
+ * @param e - lazy expression.
+ * @return lazy expression object.
+ */
+template <typename derived_type, typename component_type, size_t dimension>
+constexpr auto operator*(
+	lazy_internal::non_deduced_t<component_type> num,
+	const lazy_expression<derived_type, component_type, dimension>& e
+) noexcept
+{
+	return lazy_internal::
+		binary<lazy_internal::scalar<component_type, dimension>, derived_type, std::multiplies<>, component_type, dimension>(
+			lazy_internal::scalar<component_type, dimension>(num),
+			e.derived()
+		);
+}
+
+/**
+ * @brief Divide lazy expression by number.
+ * @param e - lazy expression.
+ * @param num - number to divide by.
+ * @return lazy expression object.
+ */
+template <typename derived_type, typename component_type, size_t dimension>
+constexpr auto operator/(
+	const lazy_expression<derived_type, component_type, dimension>& e,
+	lazy_internal::non_deduced_t<component_type> num
+) noexcept
+{
+	return lazy_internal::
+		binary<derived_type, lazy_internal::scalar<component_type, dimension>, std::divides<>, component_type, dimension>(
+			e.derived(),
+			lazy_internal::scalar<component_type, dimension>(num)
+		);
+}
+
+/**
+ * @brief Negate lazy expression.
+ * @param e - lazy expression.
+ * @return lazy expression object.
+ */
+template <typename derived_type, typename component_type, size_t dimension>
+constexpr auto operator-(const lazy_expression<derived_type, component_type, dimension>& e) noexcept
+{
+	return lazy_internal::unary<derived_type, std::negate<>, component_type, dimension>(e.derived());
+}
+
+} // namespace r4
@@ -0,0 +1,245 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "simd.hpp"
+
+// Mathematical functions which can be evaluated at compile time.
+// At run time the functions call the standard library implementation,
+// in constant evaluation context a portable implementation is used instead,
+// which may differ from the standard library result in the last bits of the mantissa.
+
+namespace r4::math {
+
+namespace internal {
+
+// type to perform constant evaluation of the functions in, float is evaluated in double precision
+template <typename real_type>
+using evaluation_type = std::conditional_t<std::is_same_v<real_type, float>, double, real_type>;
+
+template <typename real_type>
+constexpr real_type sqrt(real_type x) noexcept
+{
+	if (!(x >= 0)) {
+		// negative or NaN
+		return std::numeric_limits<real_type>::quiet_NaN();
+	}
+	if (x == 0 || x == std::numeric_limits<real_type>::infinity()) {
+		return x;
+	}
+
+	// Newton's iterations starting from above the root decrease monotonically until they converge
+	real_type cur = x < 1 ? real_type(1) : x;
+	for (;;) {
+		real_type next = (cur + x / cur) / 2;
+		if (!(next < cur)) {
+			return cur;
+		}
+		cur = next;
+	}
+}
+
+// infinity - infinity is NaN which is not a constant expression, so only comparisons are used
+template <typename real_type>
+constexpr bool is_finite(real_type x) noexcept
+{
+	constexpr auto infinity = std::numeric_limits<real_type>::infinity();
+	return x == x && x != infinity && x != -infinity;
+}
+
+// reduce the angle to [-pi, pi] range
+template <typename real_type>
+constexpr real_type reduce_angle(real_type x) noexcept
+{
+	constexpr auto pi = real_type(3.141592653589793238462643383279502884L);
+	constexpr auto two_pi = 2 * pi;
+
+	if (-pi <= x && x <= pi) {
+		return x;
+	}
+	if (!is_finite(x)) {
+		// infinity or NaN
+		return std::numeric_limits<real_type>::quiet_NaN();
+	}
+
+	// remainder of division by two_pi with binary long division, it works for angles of any magnitude
+	// and each subtraction is exact, since the subtracted value is within [r / 2, r]
+	real_type r = x < 0 ? -x : x;
+	real_type d = two_pi;
+	while (d <= r / 2) {
+		d *= 2;
+	}
+	for (; d >= two_pi; d /= 2) {
+		if (r >= d) {
+			r -= d;
+		}
+	}
+
+	if (r > pi) {
+		r -= two_pi;
+	}
+	return x < 0 ? -r : r;
+}
+
+// Taylor series of sin(x) if start_power is 1, or cos(x) if start_power is 0
+template <typename real_type>
+constexpr real_type taylor_sin_cos(real_type x, unsigned start_power) noexcept
+{
+	if (!is_finite(x)) {
+		// infinity or NaN
+		return std::numeric_limits<real_type>::quiet_NaN();
+	}
+
+	x = reduce_angle(x);
+
+	real_type term = start_power == 0 ? real_type(1) : x;
+	real_type sum = term;
+	for (unsigned n = start_power + 1;; n += 2) {
+		term *= -x * x / (real_type(n) * real_type(n + 1));
+		real_type next = sum + term;
+		if (next == sum) {
+			return sum;
+		}
+		sum = next;
+	}
+}
+
+} // namespace internal
+
+/**
+ * @brief Square root.
+ * @param x - value to calculate square root of.
+ * @return Square root of the given value, of the same type as std::sqrt(x) returns.
+ */
+template <typename number_type>
+constexpr auto sqrt(number_type x) noexcept
+{
+	using std::sqrt;
+	using result_type = decltype(sqrt(x));
+	if constexpr (!std::is_floating_point_v<result_type>) {
+		// user-defined number types, e.g. r4::fixed, provide own constexpr implementation
+		return sqrt(x);
+	} else {
+		if (!simd::is_constant_evaluated()) {
+			return sqrt(x);
+		}
+		using evaluation_type = internal::evaluation_type<result_type>;
+		return result_type(internal::sqrt(evaluation_type(x)));
+	}
+}
+
+/**
+ * @brief Sine.
+ * @param x - angle in radians.
+ * @return Sine of the given angle, of the same type as std::sin(x) returns.
+ */
+template <typename number_type>
+constexpr auto sin(number_type x) noexcept
+{
+	using std::sin;
+	using result_type = decltype(sin(x));
+	if constexpr (!std::is_floating_point_v<result_type>) {
+		return sin(x);
+	} else {
+		if (!simd::is_constant_evaluated()) {
+			return sin(x);
+		}
+		using evaluation_type = internal::evaluation_type<result_type>;
+		return result_type(internal::taylor_sin_cos(evaluation_type(x), 1));
+	}
+}
+
+/**
+ * @brief Cosine.
+ * @param x - angle in radians.
+ * @return Cosine of the given angle, of the same type as std::cos(x) returns.
+ */
+template <typename number_type>
+constexpr auto cos(number_type x) noexcept
+{
+	using std::cos;
+	using result_type = decltype(cos(x));
+	if constexpr (!std::is_floating_point_v<result_type>) {
+		return cos(x);
+	} else {
+		if (!simd::is_constant_evaluated()) {
+			return cos(x);
+		}
+		using evaluation_type = internal::evaluation_type<result_type>;
+		return result_type(internal::taylor_sin_cos(evaluation_type(x), 0));
+	}
+}
+
+/**
+ * @brief Tangent.
+ * @param x - angle in radians.
+ * @return Tangent of the given angle, of the same type as std::tan(x) returns.
+ */
+template <typename number_type>
+constexpr auto tan(number_type x) noexcept
+{
+	using std::tan;
+	using result_type = decltype(tan(x));
+	if constexpr (!std::is_floating_point_v<result_type>) {
+		return tan(x);
+	} else {
+		if (!simd::is_constant_evaluated()) {
+			return tan(x);
+		}
+		using evaluation_type = internal::evaluation_type<result_type>;
+		return result_type(
+			internal::taylor_sin_cos(evaluation_type(x), 1) / internal::taylor_sin_cos(evaluation_type(x), 0)
+		);
+	}
+}
+
+/**
+ * @brief Absolute value.
+ * @param x - value to get absolute value of.
+ * @return Absolute value of the given number.
+ */
+template <typename number_type>
+constexpr number_type abs(number_type x) noexcept
+{
+	if constexpr (std::is_unsigned_v<number_type>) {
+		return x;
+	} else {
+		if (!simd::is_constant_evaluated()) {
+			using std::abs;
+			return number_type(abs(x));
+		}
+		// -0 is handled by the comparison since -0 < 0 is false, so -0 is returned,
+		// but it is equal to 0 anyway
+		return x < 0 ? number_type(-x) : x;
+	}
+}
+
+} // namespace r4::math
@@ -27,10 +27,18 @@ SOFTWARE.
 #pragma once
 
 #include <array>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 #include <utki/config.hpp>
+#include <utki/debug.hpp>
 
+#include "math.hpp"
 #include "quaternion.hpp"
+#include "simd.hpp"
 #include "vector.hpp"
 
 // undefine possibly defined macros
@@ -55,6 +63,47 @@ class matrix :
 {
 	static_assert(num_rows >= 1, "matrix cannot have 0 rows");
 
+	// SIMD accelerated implementation of matrix operations, if available for this matrix type
+	using simd_kernels = simd::matrix_kernels<component_type, num_rows, num_columns>;
+
+	// In R4_DEBUG_FAST mode the matrix product for matrices of up to 4x4 size is unrolled with index sequences,
+	// see also R4_DEBUG_FAST in vector.hpp.
+#ifdef R4_DEBUG_FAST
+	constexpr static bool unroll = num_rows <= 4 && num_columns <= 4;
+#else
+	constexpr static bool unroll = false;
+#endif
+
+	// Calculate elements of the product of this matrix and matrix m.
+	// The index sequence enumerates the elements of the resulting matrix row by row.
+	template <size_t another_num_column, size_t... i>
+	void unrolled_mul(
+		const matrix<component_type, num_columns, another_num_column>& m,
+		matrix<component_type, num_rows, another_num_column>& res,
+		std::index_sequence<i...>
+	) const noexcept
+	{
+		const component_type* a = this->front().data();
+		const component_type* b = m.front().data();
+		component_type* c = res.front().data();
+		((c[i] = unrolled_row_by_column<another_num_column>(
+			  a + (i / another_num_column) * num_columns,
+			  b + (i % another_num_column),
+			  std::make_index_sequence<num_columns>()
+		  )),
+		 ...);
+	}
+
+	template <size_t stride, size_t... k>
+	static component_type unrolled_row_by_column(
+		const component_type* row,
+		const component_type* column,
+		std::index_sequence<k...>
+	) noexcept
+	{
+		return (... + (row[k] * column[k * stride]));
+	}
+
 public:
 	using base_type = std::array<vector<component_type, num_columns>, num_rows>;
 
@@ -71,7 +120,12 @@ public:
 	 * Initializes matrix rows to given values.
 	 * @param rows - parameter pack with initializing rows.
 	 */
+#if CFG_CPP >= 20
+	template <typename... argument_type>
+		requires(sizeof...(argument_type) == num_rows)
+#else
 	template <typename... argument_type, std::enable_if_t<sizeof...(argument_type) == num_rows, bool> = true>
+#endif
 	constexpr explicit matrix(const vector<argument_type, num_columns>&... rows) noexcept :
 		base_type{rows...}
 	{
@@ -99,11 +153,14 @@ public:
 	constexpr matrix(std::initializer_list<vector<component_type, num_columns>> rows) noexcept :
 		matrix(
 			[&rows]() {
-				if (rows.size() == num_rows)
-					return rows;
-				std::cerr << "wrong number of elements in initializer list of matrix(std::initializer_list), expected "
-						  << num_rows << ", got " << rows.size() << std::endl;
-				std::abort();
+				if (!simd::is_constant_evaluated()) {
+					ASSERT(rows.size() == num_rows)
+				}
+				if (rows.size() != num_rows) {
+					// in constant evaluation this is a compile time error
+					std::abort();
+				}
+				return rows;
 			}(),
 			std::make_index_sequence<num_rows>()
 		)
@@ -115,6 +172,11 @@ public:
 	 * Constructs matrix and initializes it to a rotation matrix from given unit quaternion.
 	 * @param quat - unit quaternion defining the rotation.
 	 */
+#if CFG_CPP >= 20
+	template <typename enable_type = component_type>
+		requires(num_rows == num_columns && (num_rows == 3 || num_rows == 4))
+	constexpr matrix(const quaternion<component_type>& quat) noexcept
+#else
 	template <typename enable_type = component_type>
 	constexpr matrix(const quaternion< //
 					 std::enable_if_t<
@@ -122,6 +184,9 @@ public:
 						 enable_type //
 						 > //
 					 >& quat) noexcept
+#endif
+		:
+		base_type{}
 	{
 		this->set(quat);
 	}
@@ -133,10 +198,12 @@ public:
 	 * @return Resulting vector.
 	 */
 	template <typename unary_operation_type>
-	matrix comp_op(unary_operation_type op) const
+	constexpr matrix comp_op(unary_operation_type op) const
 	{
 		matrix res{};
-		std::transform(this->begin(), this->end(), res.begin(), op);
+		for (size_t r = 0; r != num_rows; ++r) {
+			res[r] = op(this->operator[](r));
+		}
 		return res;
 	}
 
@@ -148,10 +215,12 @@ public:
 	 * @return Resulting vector.
 	 */
 	template <typename binary_operation_type>
-	matrix comp_op(const matrix& mat, binary_operation_type op) const
+	constexpr matrix comp_op(const matrix& mat, binary_operation_type op) const
 	{
 		matrix res{};
-		std::transform(this->begin(), this->end(), mat.begin(), res.begin(), op);
+		for (size_t r = 0; r != num_rows; ++r) {
+			res[r] = op(this->operator[](r), mat[r]);
+		}
 		return res;
 	}
 
@@ -160,17 +229,12 @@ public:
 	 * @return matrix with converted element type.
 	 */
 	template <typename another_component_type>
-	matrix<another_component_type, num_rows, num_columns> to() noexcept
+	constexpr matrix<another_component_type, num_rows, num_columns> to() const noexcept
 	{
-		matrix<another_component_type, num_rows, num_columns> ret;
-		std::transform( //
-			this->begin(),
-			this->end(),
-			ret.begin(),
-			[](const auto& r) {
-				return r.template to<another_component_type>();
-			}
-		);
+		matrix<another_component_type, num_rows, num_columns> ret{};
+		for (size_t r = 0; r != num_rows; ++r) {
+			ret[r] = this->operator[](r).template to<another_component_type>();
+		}
 		return ret;
 	}
 
@@ -184,7 +248,7 @@ public:
 	 * @return A submatrix of this matrix.
 	 */
 	template <size_t row_number, size_t column_number, size_t rows_count, size_t columns_count>
-	matrix<component_type, rows_count, columns_count> submatrix() const noexcept
+	constexpr matrix<component_type, rows_count, columns_count> submatrix() const noexcept
 	{
 		static_assert(row_number + rows_count <= num_rows, "submatrix rows go beyond the original matrix rows");
 		static_assert(
@@ -192,11 +256,11 @@ public:
 			"submatrix columns go beyond the original matrix columns"
 		);
 
-		matrix<component_type, rows_count, columns_count> ret;
+		matrix<component_type, rows_count, columns_count> ret{};
 
 		for (size_t sr = row_number, dr = 0; dr != rows_count; ++dr, ++sr) {
-			auto& src_row = this->row(sr);
-			auto& dst_row = ret.row(dr);
+			auto& src_row = this->operator[](sr);
+			auto& dst_row = ret.operator[](dr);
 			for (size_t sc = column_number, dc = 0; dc != columns_count; ++dc, ++sc) {
 				dst_row[dc] = src_row[sc];
 			}
@@ -212,13 +276,18 @@ public:
 	 * @param quat - unit quaternion defining the rotation.
 	 * @return Reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& set(const quaternion<component_type>& quat) noexcept
+		requires(num_rows == num_columns && (num_rows == 3 || num_rows == 4))
+#else
 	template <typename enable_type = component_type>
-	matrix& set(const quaternion< //
+	constexpr matrix& set(const quaternion< //
 				std::enable_if_t<
 					num_rows == num_columns && (num_rows == 3 || num_rows == 4), //
 					enable_type //
 					> //
 				>& quat) noexcept
+#endif
 	{
 		// Quaternion to matrix conversion:
 		//     |  1-(2y^2+2z^2)   2xy-2zw         2xz+2yw         0   |
@@ -227,48 +296,78 @@ public:
 		//     |  0               0               0               1   |
 
 		// First column
-		this->row(0)[0] = component_type(1) - component_type(2) * (utki::pow2(quat.y()) + utki::pow2(quat.z()));
-		this->row(1)[0] = component_type(2) * (quat.x() * quat.y() + quat.z() * quat.w());
-		this->row(2)[0] = component_type(2) * (quat.x() * quat.z() - quat.y() * quat.w());
+		this->operator[](0)[0] = component_type(1) - component_type(2) * (utki::pow2(quat.y()) + utki::pow2(quat.z()));
+		this->operator[](1)[0] = component_type(2) * (quat.x() * quat.y() + quat.z() * quat.w());
+		this->operator[](2)[0] = component_type(2) * (quat.x() * quat.z() - quat.y() * quat.w());
 		if constexpr (num_rows == 4) {
-			this->row(3)[0] = component_type(0);
+			this->operator[](3)[0] = component_type(0);
 		}
 
 		// Second column
-		this->row(0)[1] = component_type(2) * (quat.x() * quat.y() - quat.z() * quat.w());
-		this->row(1)[1] = component_type(1) - component_type(2) * (utki::pow2(quat.x()) + utki::pow2(quat.z()));
-		this->row(2)[1] = component_type(2) * (quat.z() * quat.y() + quat.x() * quat.w());
+		this->operator[](0)[1] = component_type(2) * (quat.x() * quat.y() - quat.z() * quat.w());
+		this->operator[](1)[1] = component_type(1) - component_type(2) * (utki::pow2(quat.x()) + utki::pow2(quat.z()));
+		this->operator[](2)[1] = component_type(2) * (quat.z() * quat.y() + quat.x() * quat.w());
 		if constexpr (num_rows == 4) {
-			this->row(3)[1] = component_type(0);
+			this->operator[](3)[1] = component_type(0);
 		}
 
 		// Third column
-		this->row(0)[2] = component_type(2) * (quat.x() * quat.z() + quat.y() * quat.w());
-		this->row(1)[2] = component_type(2) * (quat.y() * quat.z() - quat.x() * quat.w());
-		this->row(2)[2] = component_type(1) - component_type(2) * (utki::pow2(quat.x()) + utki::pow2(quat.y()));
+		this->operator[](0)[2] = component_type(2) * (quat.x() * quat.z() + quat.y() * quat.w());
+		this->operator[](1)[2] = component_type(2) * (quat.y() * quat.z() - quat.x() * quat.w());
+		this->operator[](2)[2] = component_type(1) - component_type(2) * (utki::pow2(quat.x()) + utki::pow2(quat.y()));
 		if constexpr (num_rows == 4) {
-			this->row(3)[2] = component_type(0);
+			this->operator[](3)[2] = component_type(0);
 		}
 
 		// Fourth column
 		if constexpr (num_rows == 4) {
-			this->row(0)[3] = component_type(0);
-			this->row(1)[3] = component_type(0);
-			this->row(2)[3] = component_type(0);
-			this->row(3)[3] = component_type(1);
+			this->operator[](0)[3] = component_type(0);
+			this->operator[](1)[3] = component_type(0);
+			this->operator[](2)[3] = component_type(0);
+			this->operator[](3)[3] = component_type(1);
 		}
 
 		return *this;
 	}
 
+	/**
+	 * @brief Check matrices for equality.
+	 * See vector::operator==().
+	 * @param m - matrix to compare this matrix to.
+	 * @return true if all elements of this matrix are equal to the corresponding elements of given matrix.
+	 * @return false otherwise.
+	 */
+	constexpr bool operator==(const matrix& m) const noexcept
+	{
+		for (size_t r = 0; r != num_rows; ++r) {
+			if (this->operator[](r) != m[r]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Check matrices for inequality.
+	 * @param m - matrix to compare this matrix to.
+	 * @return true if at least one element of this matrix differs from the corresponding element of given matrix.
+	 * @return false otherwise.
+	 */
+	constexpr bool operator!=(const matrix& m) const noexcept
+	{
+		return !this->operator==(m);
+	}
+
 	/**
 	 * @brief Get matrix row.
 	 * @param r - row number to get.
 	 * @return reference to vector representing the row of this matrix.
 	 */
-	vector<component_type, num_columns>& row(size_t r) noexcept
+	constexpr vector<component_type, num_columns>& row(size_t r) noexcept
 	{
-		ASSERT(r < this->size())
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(r < this->size())
+		}
 		return this->operator[](r);
 	}
 
@@ -277,9 +376,11 @@ public:
 	 * @param r - row number to get.
 	 * @return reference to vector representing the row of this matrix.
 	 */
-	const vector<component_type, num_columns>& row(size_t r) const noexcept
+	constexpr const vector<component_type, num_columns>& row(size_t r) const noexcept
 	{
-		ASSERT(r < this->size())
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(r < this->size())
+		}
 		return this->operator[](r);
 	}
 
@@ -288,7 +389,7 @@ public:
 	 * @param m - matrix to subtract from this matrix.
 	 * @return resulting matrix of the subtraction.
 	 */
-	matrix operator-(const matrix& m) const noexcept
+	constexpr matrix operator-(const matrix& m) const noexcept
 	{
 		return this->comp_op( //
 			m,
@@ -305,47 +406,54 @@ public:
 	 * @param vec - vector to transform. Must have same number of components, as number of columns in this matrix.
 	 * @return Transformed vector.
 	 */
-	vector<component_type, num_rows> operator*(const vector<component_type, num_columns>& vec) const noexcept
+	constexpr vector<component_type, num_rows> operator*(const vector<component_type, num_columns>& vec) const noexcept
 	{
-		vector<component_type, num_rows> res;
-		std::transform( //
-			this->begin(),
-			this->end(),
-			res.begin(),
-			[&vec](const auto& r) {
-				return r.dot(vec);
-			}
-		);
+		vector<component_type, num_rows> res{};
+		for (size_t r = 0; r != num_rows; ++r) {
+			res[r] = this->operator[](r).dot(vec);
+		}
 		return res;
 	}
 
 	// TODO: add doxygen comment
 	// Transform 2d or 3d vector by matrix.
 	// Defined only for 4x4 matrix.
+#if CFG_CPP >= 20
+	template <size_t dimension>
+		requires(num_rows == 4 && num_columns == 4 && (dimension == 2 || dimension == 3))
+	constexpr vector<component_type, 4> operator*(const vector<component_type, dimension>& vec) const noexcept
+#else
 	template <size_t dimension, typename enable_type = component_type>
-	vector<std::enable_if_t<num_rows == 4 && num_columns == 4 && (dimension == 2 || dimension == 3), enable_type>, 4>
+	constexpr vector<std::enable_if_t<num_rows == 4 && num_columns == 4 && (dimension == 2 || dimension == 3), enable_type>, 4>
 	operator*(const vector<component_type, dimension>& vec) const noexcept
+#endif
 	{
 		static_assert(num_rows == 4 && num_columns == 4, "4x4 matrix expected");
 		return vector<component_type, 4>{
-			this->row(0).dot(vec) + this->row(0)[3],
-			this->row(1).dot(vec) + this->row(1)[3],
-			this->row(2).dot(vec) + this->row(2)[3],
-			this->row(3).dot(vec) + this->row(3)[3],
+			this->operator[](0).dot(vec) + this->operator[](0)[3],
+			this->operator[](1).dot(vec) + this->operator[](1)[3],
+			this->operator[](2).dot(vec) + this->operator[](2)[3],
+			this->operator[](3).dot(vec) + this->operator[](3)[3],
 		};
 	}
 
 	// TODO: add doxygen comment
+#if CFG_CPP >= 20
+	template <size_t dimension>
+		requires(num_rows == 2 && num_columns == 3 && dimension == 2)
+	constexpr vector<component_type, 2> operator*(const vector<component_type, dimension>& vec) const noexcept
+#else
 	template <size_t dimension, typename enable_type = component_type>
-	vector<std::enable_if_t<(num_rows == 2 && num_columns == 3 && dimension == 2), enable_type>, 2> operator*(
+	constexpr vector<std::enable_if_t<(num_rows == 2 && num_columns == 3 && dimension == 2), enable_type>, 2> operator*(
 		const vector<component_type, dimension>& vec
 	) const noexcept
+#endif
 	{
 		static_assert(num_rows == 2 && num_columns == 3, "2x3 matrix expected");
 		static_assert(dimension == 2, "2d vector expected");
 		return vector<component_type, 2>{
-			this->row(0).dot(vec) + this->row(0)[2], //
-			this->row(1).dot(vec) + this->row(1)[2]
+			this->operator[](0).dot(vec) + this->operator[](0)[2], //
+			this->operator[](1).dot(vec) + this->operator[](1)[2]
 		};
 	}
 
@@ -362,15 +470,23 @@ public:
 	 * @return New matrix of size RxCC as a result of matrices product.
 	 */
 	template <size_t another_num_column>
-	matrix<component_type, num_rows, another_num_column> operator*(
+	constexpr matrix<component_type, num_rows, another_num_column> operator*(
 		const matrix<component_type, num_columns, another_num_column>& m
 	) const noexcept
 	{
-		matrix<component_type, num_rows, another_num_column> ret;
+		matrix<component_type, num_rows, another_num_column> ret{};
+		if constexpr (unroll && another_num_column <= 4) {
+			// the unrolled implementation accesses matrix elements through flat pointers,
+			// which is not allowed in constant expressions
+			if (!simd::is_constant_evaluated()) {
+				this->unrolled_mul(m, ret, std::make_index_sequence<num_rows * another_num_column>());
+				return ret;
+			}
+		}
 		for (size_t rd = 0; rd != ret.size(); ++rd) {
 			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
 			auto& row_dst = ret[rd];
-			const auto& row_src = this->row(rd);
+			const auto& row_src = this->operator[](rd);
 
 			for (size_t cd = 0; cd != row_dst.size(); ++cd) {
 				component_type v = 0;
@@ -386,18 +502,23 @@ public:
 	}
 
 	// Define operator*(matrix) for 2x3 matrices. See description of operator*(matrix) for square matrices for info.
+#if CFG_CPP >= 20
+	constexpr matrix operator*(const matrix& matr) const noexcept
+		requires(num_rows == 2 && num_columns == 3)
+#else
 	template <typename enable_type = matrix>
-	std::enable_if_t<num_rows == 2 && num_columns == 3, enable_type> operator*(const matrix& matr) const noexcept
+	constexpr std::enable_if_t<num_rows == 2 && num_columns == 3, enable_type> operator*(const matrix& matr) const noexcept
+#endif
 	{
 		return matrix{
 			vector<component_type, 3>{
-									  this->row(0)[0] * matr[0][0] + this->row(0)[1] * matr[1][0],
-									  this->row(0)[0] * matr[0][1] + this->row(0)[1] * matr[1][1],
-									  this->row(0)[0] * matr[0][2] + this->row(0)[1] * matr[1][2] + this->row(0)[2]},
+									  this->operator[](0)[0] * matr[0][0] + this->operator[](0)[1] * matr[1][0],
+									  this->operator[](0)[0] * matr[0][1] + this->operator[](0)[1] * matr[1][1],
+									  this->operator[](0)[0] * matr[0][2] + this->operator[](0)[1] * matr[1][2] + this->operator[](0)[2]},
 			vector<component_type, 3>{
-									  this->row(1)[0] * matr[0][0] + this->row(1)[1] * matr[1][0],
-									  this->row(1)[0] * matr[0][1] + this->row(1)[1] * matr[1][1],
-									  this->row(1)[0] * matr[0][2] + this->row(1)[1] * matr[1][2] + this->row(1)[2]},
+									  this->operator[](1)[0] * matr[0][0] + this->operator[](1)[1] * matr[1][0],
+									  this->operator[](1)[0] * matr[0][1] + this->operator[](1)[1] * matr[1][1],
+									  this->operator[](1)[0] * matr[0][2] + this->operator[](1)[1] * matr[1][2] + this->operator[](1)[2]},
 		};
 	}
 
@@ -409,10 +530,15 @@ public:
 	 * Multiply this matrix M by another matrix K from the right (M  = M * K).
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& operator*=(const matrix& matr) noexcept
+		requires(num_rows == num_columns || (num_rows == 2 && num_columns == 3))
+#else
 	template <typename enable_type = matrix>
-	std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type&> operator*=(
+	constexpr std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type&> operator*=(
 		const matrix& matr
 	) noexcept
+#endif
 	{
 		return this->operator=(this->operator*(matr));
 	}
@@ -422,7 +548,7 @@ public:
 	 * @param n - scalar to multiply the matrix by.
 	 * @return reference to this matrix.
 	 */
-	matrix& operator*=(component_type n)
+	constexpr matrix& operator*=(component_type n)
 	{
 		for (auto& r : *this) {
 			r *= n;
@@ -435,7 +561,7 @@ public:
 	 * @param n - scalar to divide the matrix by.
 	 * @return reference to this matrix.
 	 */
-	matrix& operator/=(component_type n)
+	constexpr matrix& operator/=(component_type n)
 	{
 		for (auto& r : *this) {
 			r /= n;
@@ -448,7 +574,7 @@ public:
 	 * @param num - scalar to divide the matrix by.
 	 * @return divided matrix.
 	 */
-	matrix operator/(component_type num) const noexcept
+	constexpr matrix operator/(component_type num) const noexcept
 	{
 		return this->comp_op([&num](const auto& r) {
 			return r / num;
@@ -463,10 +589,15 @@ public:
 	 * @param matr - matrix to multiply by.
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& left_mul(const matrix& matr) noexcept
+		requires(num_rows == num_columns || (num_rows == 2 && num_columns == 3))
+#else
 	template <typename enable_type = matrix>
-	std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type&> left_mul(
+	constexpr std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type&> left_mul(
 		const matrix& matr
 	) noexcept
+#endif
 	{
 		return this->operator=(matr.operator*(*this));
 	}
@@ -475,19 +606,18 @@ public:
 	 * @brief Initialize this matrix with identity matrix.
 	 * Defined only for square matrices and 2x3 matrix.
 	 */
-	std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), matrix>& set_identity() noexcept
+#if CFG_CPP >= 20
+	constexpr matrix& set_identity() noexcept
+		requires(num_rows == num_columns || (num_rows == 2 && num_columns == 3))
+#else
+	constexpr std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), matrix>& set_identity() noexcept
+#endif
 	{
-		size_t row_index = 0;
-		for (auto& r : *this) {
-			auto one_iter = utki::next(r.begin(), row_index);
-
-			std::fill(r.begin(), one_iter, component_type(0));
-
-			*one_iter = component_type(1);
-
-			std::fill(std::next(one_iter), r.end(), component_type(0));
-
-			++row_index;
+		for (size_t r = 0; r != num_rows; ++r) {
+			auto& row = this->operator[](r);
+			for (size_t c = 0; c != num_columns; ++c) {
+				row[c] = c == r ? component_type(1) : component_type(0);
+			}
 		}
 		return *this;
 	}
@@ -505,8 +635,19 @@ public:
 	 * @param far_val - distance to the far clipping plane. Must be positive.
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& set_frustum(
+		component_type left,
+		component_type right,
+		component_type bottom,
+		component_type top,
+		component_type near_val,
+		component_type far_val
+	) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& set_frustum(
+	constexpr matrix& set_frustum(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, enable_type> left,
 		component_type right,
 		component_type bottom,
@@ -514,15 +655,22 @@ public:
 		component_type near_val,
 		component_type far_val
 	) noexcept
+#endif
 	{
 		component_type w = right - left;
-		ASSERT(w != 0)
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(w != 0)
+		}
 
 		component_type h = top - bottom;
-		ASSERT(h != 0)
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(h != 0)
+		}
 
 		component_type d = far_val - near_val;
-		ASSERT(d != 0)
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(d != 0)
+		}
 
 		matrix& f = *this;
 		f[0][0] = 2 * near_val / w;
@@ -562,8 +710,19 @@ public:
 	 * @param far - distance to the far clipping plane. Must be positive.
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& frustum(
+		component_type left,
+		component_type right,
+		component_type bottom,
+		component_type top,
+		component_type near,
+		component_type far
+	) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& frustum(
+	constexpr matrix& frustum(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, enable_type> left,
 		component_type right,
 		component_type bottom,
@@ -571,10 +730,47 @@ public:
 		component_type near,
 		component_type far
 	) noexcept
+#endif
 	{
-		matrix f;
-		f.set_frustum(left, right, bottom, top, near, far);
-		return this->operator*=(f);
+		component_type w = right - left;
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(w != 0)
+		}
+
+		component_type h = top - bottom;
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(h != 0)
+		}
+
+		component_type d = far - near;
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(d != 0)
+		}
+
+		// the frustum matrix is sparse:
+		//     | a 0 c 0 |
+		// F = | 0 b e 0 |
+		//     | 0 0 g k |
+		//     | 0 0 -1 0 |
+		// so, multiply only by non-zero elements
+		component_type a = 2 * near / w;
+		component_type b = 2 * near / h;
+		component_type c = (right + left) / w;
+		component_type e = (top + bottom) / h;
+		component_type g = -(far + near) / d;
+		component_type k = -2 * far * near / d;
+
+		for (auto& r : *this) {
+			component_type r0 = r[0];
+			component_type r1 = r[1];
+			component_type r2 = r[2];
+			r[0] = r0 * a;
+			r[1] = r1 * b;
+			r[2] = r0 * c + r1 * e + r2 * g - r[3];
+			r[3] = r2 * k;
+		}
+
+		return *this;
 	}
 
 	/**
@@ -590,29 +786,35 @@ public:
 	 * @param far - far clipping plane, must be positive.
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& set_perspective(component_type fov_y, component_type aspect, component_type near, component_type far) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& set_perspective(
+	constexpr matrix& set_perspective(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, enable_type> fov_y,
 		component_type aspect,
 		component_type near,
 		component_type far
 	) noexcept
+#endif
 	{
-		ASSERT(aspect > 0)
-		ASSERT(near > 0)
-		ASSERT(far > near)
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(aspect > 0)
+			ASSERT(near > 0)
+			ASSERT(far > near)
+		}
 
-		using std::tan;
-		component_type tan_half_fov_y = tan(fov_y / component_type(2));
+		component_type tan_half_fov_y = math::tan(fov_y / component_type(2));
 		component_type minus_d = near - far;
 
 		this->set(0);
 
-		this->row(0)[0] = component_type(1) / (aspect * tan_half_fov_y);
-		this->row(1)[1] = component_type(1) / tan_half_fov_y;
-		this->row(2)[2] = (far + near) / minus_d;
-		this->row(2)[3] = component_type(2) * far * near / minus_d;
-		this->row(3)[2] = -component_type(1);
+		this->operator[](0)[0] = component_type(1) / (aspect * tan_half_fov_y);
+		this->operator[](1)[1] = component_type(1) / tan_half_fov_y;
+		this->operator[](2)[2] = (far + near) / minus_d;
+		this->operator[](2)[3] = component_type(2) * far * near / minus_d;
+		this->operator[](3)[2] = -component_type(1);
 
 		return *this;
 	}
@@ -631,17 +833,48 @@ public:
 	 * @param far - far clipping plane, must be positive.
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& perspective(component_type fov_y, component_type aspect, component_type near, component_type far) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& perspective(
+	constexpr matrix& perspective(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, enable_type> fov_y,
 		component_type aspect,
 		component_type near,
 		component_type far
 	) noexcept
+#endif
 	{
-		matrix p;
-		p.set_perspective(fov_y, aspect, near, far);
-		return this->operator*=(p);
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(aspect > 0)
+			ASSERT(near > 0)
+			ASSERT(far > near)
+		}
+
+		component_type tan_half_fov_y = math::tan(fov_y / component_type(2));
+		component_type minus_d = near - far;
+
+		// the perspective projection matrix is sparse:
+		//     | x 0 0 0 |
+		// P = | 0 y 0 0 |
+		//     | 0 0 g k |
+		//     | 0 0 -1 0 |
+		// so, multiply only by non-zero elements
+		component_type x = component_type(1) / (aspect * tan_half_fov_y);
+		component_type y = component_type(1) / tan_half_fov_y;
+		component_type g = (far + near) / minus_d;
+		component_type k = component_type(2) * far * near / minus_d;
+
+		for (auto& r : *this) {
+			component_type r2 = r[2];
+			r[0] *= x;
+			r[1] *= y;
+			r[2] = r2 * g - r[3];
+			r[3] = r2 * k;
+		}
+
+		return *this;
 	}
 
 	/**
@@ -662,15 +895,20 @@ public:
 	 * @param p - element [3][2] of matrix P.
 	 * @return Reference to this matrix.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& perspective(component_type p = component_type(1)) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& perspective(
+	constexpr matrix& perspective(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, enable_type> p = component_type(1)
 	) noexcept
+#endif
 	{
-		this->row(0)[2] += this->row(0)[3] * p;
-		this->row(1)[2] += this->row(1)[3] * p;
-		this->row(2)[2] += this->row(2)[3] * p;
-		this->row(3)[2] += this->row(3)[3] * p;
+		this->operator[](0)[2] += this->operator[](0)[3] * p;
+		this->operator[](1)[2] += this->operator[](1)[3] * p;
+		this->operator[](2)[2] += this->operator[](2)[3] * p;
+		this->operator[](3)[2] += this->operator[](3)[3] * p;
 		return *this;
 	}
 
@@ -684,12 +922,17 @@ public:
 	 * @param up - direction of the up vector.
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& set_look_at(vector3<component_type> eye, vector3<component_type> center, vector3<component_type> up) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& set_look_at(
+	constexpr matrix& set_look_at(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, vector3<enable_type>> eye,
 		vector3<component_type> center,
 		vector3<component_type> up
 	) noexcept
+#endif
 	{
 		auto f = (center - eye).normalize();
 		auto s = f.cross(up).normalize();
@@ -697,19 +940,19 @@ public:
 
 		this->set(0);
 
-		this->row(0)[0] = s[0];
-		this->row(0)[1] = s[1];
-		this->row(0)[2] = s[2];
-		this->row(0)[3] = -s.dot(eye);
-		this->row(1)[0] = u[0];
-		this->row(1)[1] = u[1];
-		this->row(1)[2] = u[2];
-		this->row(1)[3] = -u.dot(eye);
-		this->row(2)[0] = -f[0];
-		this->row(2)[1] = -f[1];
-		this->row(2)[2] = -f[2];
-		this->row(2)[3] = f.dot(eye);
-		this->row(3)[3] = 1;
+		this->operator[](0)[0] = s[0];
+		this->operator[](0)[1] = s[1];
+		this->operator[](0)[2] = s[2];
+		this->operator[](0)[3] = -s.dot(eye);
+		this->operator[](1)[0] = u[0];
+		this->operator[](1)[1] = u[1];
+		this->operator[](1)[2] = u[2];
+		this->operator[](1)[3] = -u.dot(eye);
+		this->operator[](2)[0] = -f[0];
+		this->operator[](2)[1] = -f[1];
+		this->operator[](2)[2] = -f[2];
+		this->operator[](2)[3] = f.dot(eye);
+		this->operator[](3)[3] = 1;
 
 		return *this;
 	}
@@ -725,16 +968,29 @@ public:
 	 * @param up - direction of the up vector.
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& look_at(vector3<component_type> eye, vector3<component_type> center, vector3<component_type> up) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& look_at(
+	constexpr matrix& look_at(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, vector3<enable_type>> eye,
 		vector3<component_type> center,
 		vector3<component_type> up
 	) noexcept
+#endif
 	{
-		matrix l;
-		l.set_look_at(eye, center, up);
-		return this->operator*=(l);
+		auto f = (center - eye).normalize();
+		auto s = f.cross(up).normalize();
+		auto u = s.cross(f);
+
+		// the look-at matrix is a rotation followed by translation:
+		//     |  s -s*eye |
+		// L = |  u -u*eye | = R * T(-eye)
+		//     | -f  f*eye |
+		//     |  0  1     |
+		this->right_mul_linear_block(matrix<component_type, 3, 3>{s, u, -f});
+		return this->translate(-eye);
 	}
 
 	/**
@@ -744,17 +1000,22 @@ public:
 	 * @param s - scaling factor to be applied in all directions (x, y and z).
 	 * @return reference to this matrix instance.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& scale(component_type s) noexcept
+		requires((num_rows == num_columns && (1 <= num_rows && num_rows <= 4)) || (num_rows == 2 && num_columns == 3))
+#else
 	template <typename enable_type = matrix>
-	std::enable_if_t<
+	constexpr std::enable_if_t<
 		(num_rows == num_columns && (1 <= num_rows && num_rows <= 4)) || (num_rows == 2 && num_columns == 3),
 		matrix&>
 	scale(component_type s) noexcept
+#endif
 	{
 		using std::min;
 		size_t num_cols = min(min(num_columns, num_rows), size_t(3)); // for 2x3 and 4x4 matrix do not scale last column
 		for (auto& r : *this) {
-			for (auto& e : utki::make_span(r.data(), num_cols)) {
-				e *= s;
+			for (size_t c = 0; c != num_cols; ++c) {
+				r[c] *= s;
 			}
 		}
 		return *this;
@@ -767,14 +1028,14 @@ public:
 	 * @param y - scaling factor in y direction.
 	 * @return reference to this matrix instance.
 	 */
-	matrix& scale(component_type x, component_type y) noexcept
+	constexpr matrix& scale(component_type x, component_type y) noexcept
 	{
 		for (size_t r = 0; r != num_rows; ++r) {
-			this->row(r)[0] *= x;
+			this->operator[](r)[0] *= x;
 		}
 		if constexpr (num_columns >= 2) {
 			for (size_t r = 0; r != num_rows; ++r) {
-				this->row(r)[1] *= y;
+				this->operator[](r)[1] *= y;
 			}
 		}
 		return *this;
@@ -788,7 +1049,7 @@ public:
 	 * @param z - scaling factor in z direction.
 	 * @return reference to this matrix instance.
 	 */
-	matrix& scale(component_type x, component_type y, component_type z) noexcept
+	constexpr matrix& scale(component_type x, component_type y, component_type z) noexcept
 	{
 		// update 0th and 1st columns
 		this->scale(x, y);
@@ -796,7 +1057,7 @@ public:
 		// update 2nd column
 		if constexpr (num_columns >= 3) {
 			for (size_t r = 0; r != num_rows; ++r) {
-				this->row(r)[2] *= z;
+				this->operator[](r)[2] *= z;
 			}
 		}
 		return *this;
@@ -809,16 +1070,14 @@ public:
 	 * @return reference to this matrix instance.
 	 */
 	template <size_t dimension>
-	matrix& scale(const vector<component_type, dimension>& s) noexcept
+	constexpr matrix& scale(const vector<component_type, dimension>& s) noexcept
 	{
 		using std::min;
 		constexpr auto num_cols = min(dimension, num_columns);
 
 		for (auto& r : *this) {
-			auto s_iter = s.begin();
-			for (auto& e : utki::make_span(r.data(), num_cols)) {
-				e *= *s_iter;
-				++s_iter;
+			for (size_t c = 0; c != num_cols; ++c) {
+				r[c] *= s[c];
 			}
 		}
 
@@ -834,17 +1093,22 @@ public:
 	 * @param y - y component of translation vector.
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& translate(component_type x, component_type y) noexcept
+		requires((num_rows == 2 && num_columns == 3) || (num_rows == num_columns && (num_rows == 3 || num_rows == 4)))
+#else
 	template <typename enable_type = component_type>
-	matrix& translate(
+	constexpr matrix& translate(
 		std::enable_if_t<
 			(num_rows == 2 && num_columns == 3) || (num_rows == num_columns && (num_rows == 3 || num_rows == 4)),
 			enable_type> x,
 		component_type y
 	) noexcept
+#endif
 	{
 		// only last column of the matrix changes
 		for (size_t r = 0; r != num_rows; ++r) {
-			this->row(r)[num_columns - 1] += this->row(r)[0] * x + this->row(r)[1] * y;
+			this->operator[](r)[num_columns - 1] += this->operator[](r)[0] * x + this->operator[](r)[1] * y;
 		}
 		return *this;
 	}
@@ -858,16 +1122,21 @@ public:
 	 * @param z - z component of translation vector.
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& translate(component_type x, component_type y, component_type z) noexcept
+		requires(num_rows == num_columns && num_rows == 4)
+#else
 	template <typename enable_type = component_type>
-	matrix& translate(
+	constexpr matrix& translate(
 		std::enable_if_t<num_rows == num_columns && num_rows == 4, enable_type> x,
 		component_type y,
 		component_type z
 	) noexcept
+#endif
 	{
 		// only last column of the matrix changes
 		for (size_t r = 0; r != num_rows; ++r) {
-			this->row(r)[num_columns - 1] += this->row(r)[0] * x + this->row(r)[1] * y + this->row(r)[2] * z;
+			this->operator[](r)[num_columns - 1] += this->operator[](r)[0] * x + this->operator[](r)[1] * y + this->operator[](r)[2] * z;
 		}
 		return *this;
 	}
@@ -879,8 +1148,22 @@ public:
 	 * @param translation - translation vector, can have 2 or 3 components.
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	template <size_t dimension>
+		// clang-format off
+		requires(
+			(
+				(num_rows == 2 && num_columns == 3) ||
+				(num_rows == num_columns && (num_rows == 3 || num_rows == 4))
+			) &&
+				(dimension == 2 || dimension == 3) &&
+				(dimension < num_columns)
+		)
+	// clang-format on
+	constexpr matrix& translate(const vector<component_type, dimension>& translation) noexcept
+#else
 	template <typename enable_type = component_type, size_t dimension>
-	matrix& translate(
+	constexpr matrix& translate(
 		// clang-format off
 		const vector<
 			std::enable_if_t<
@@ -896,6 +1179,7 @@ public:
 		>& translation
 		// clang-format on
 	) noexcept
+#endif
 	{
 		// only last column of the matrix changes
 		for (auto& r : *this) {
@@ -918,15 +1202,22 @@ public:
 	 * @param q - unit quaternion, representing the rotation.
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& rotate(const quaternion<component_type>& q) noexcept
+		requires(num_rows == num_columns && (num_rows == 3 || num_rows == 4))
+#else
 	template <typename enable_type = component_type>
-	matrix& rotate(const quaternion< //
+	constexpr matrix& rotate(const quaternion< //
 				   std::enable_if_t<
 					   num_rows == num_columns && (num_rows == 3 || num_rows == 4), //
 					   enable_type //
 					   > //
 				   >& q) noexcept
+#endif
 	{
-		return this->operator*=(matrix<component_type, num_rows, num_columns>(q));
+		// the rotation matrix only has non-trivial 3x3 block, the last column of 4x4 matrix does not change
+		this->right_mul_linear_block(matrix<component_type, 3, 3>(q));
+		return *this;
 	}
 
 	/**
@@ -938,8 +1229,12 @@ public:
 	 * @param angle - the angle of rotation in radians.
 	 * @return reference to this matrix object.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix& rotate(component_type angle) noexcept
+		requires(num_rows == 2 && num_columns == 3)
+#else
 	template <typename enable_type = component_type>
-	matrix& rotate(
+	constexpr matrix& rotate(
 		// clang-format off
 		std::enable_if_t<
 			num_rows == 2 && num_columns == 3,
@@ -947,6 +1242,7 @@ public:
 		> angle
 		// clang-format on
 	) noexcept
+#endif
 	{
 		static_assert(num_rows == 2 && num_columns == 3, "2x3 matrix expected");
 
@@ -954,22 +1250,20 @@ public:
 		//               | cos(a) -sin(a) 0 |
 		// this = this * | sin(a)  cos(a) 0 |
 
-		using std::cos;
-		using std::sin;
-		component_type sina = sin(angle);
-		component_type cosa = cos(angle);
+		component_type sina = math::sin(angle);
+		component_type cosa = math::cos(angle);
 
-		component_type m00 = this->row(0)[0] * cosa + this->row(0)[1] * sina;
-		component_type m10 = this->row(1)[0] * cosa + this->row(1)[1] * sina;
+		component_type m00 = this->operator[](0)[0] * cosa + this->operator[](0)[1] * sina;
+		component_type m10 = this->operator[](1)[0] * cosa + this->operator[](1)[1] * sina;
 		sina = -sina;
-		component_type m01 = this->row(0)[0] * sina + this->row(0)[1] * cosa;
-		component_type m11 = this->row(1)[0] * sina + this->row(1)[1] * cosa;
+		component_type m01 = this->operator[](0)[0] * sina + this->operator[](0)[1] * cosa;
+		component_type m11 = this->operator[](1)[0] * sina + this->operator[](1)[1] * cosa;
 
-		this->row(0)[0] = m00;
-		this->row(1)[0] = m10;
+		this->operator[](0)[0] = m00;
+		this->operator[](1)[0] = m10;
 
-		this->row(0)[1] = m01;
-		this->row(1)[1] = m11;
+		this->operator[](0)[1] = m01;
+		this->operator[](1)[1] = m11;
 
 		return *this;
 	}
@@ -977,22 +1271,26 @@ public:
 	/**
 	 * @brief Transpose this matrix.
 	 */
-	matrix& transpose() noexcept
+	constexpr matrix& transpose() noexcept
 	{
-		using std::swap;
 		using std::min;
 
 		auto square_index = min(num_rows, num_columns);
 		for (size_t r = 1; r != square_index; ++r) {
 			for (size_t c = 0; c != r; ++c) {
+				// std::swap() is not constexpr before C++20
+				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+				component_type tmp = this->operator[](r)[c];
+				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+				this->operator[](r)[c] = this->operator[](c)[r];
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-				swap(this->row(r)[c], this->row(c)[r]);
+				this->operator[](c)[r] = tmp;
 			}
 		}
 		// in case the matrix is not square, then zero out the "non-square" parts
 		if constexpr (num_columns > num_rows) {
 			for (size_t r = 0; r != num_rows; ++r) {
-				auto& cur_row = this->row(r);
+				auto& cur_row = this->operator[](r);
 				for (size_t c = num_rows; c != num_columns; ++c) {
 					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
 					cur_row[c] = component_type(0);
@@ -1001,7 +1299,7 @@ public:
 		} else {
 			static_assert(num_rows >= num_columns, "expected matrix with num_rows >= num_columns");
 			for (size_t r = num_columns; r != num_rows; ++r) {
-				this->row(r).set(component_type(0));
+				this->operator[](r).set(component_type(0));
 			}
 		}
 
@@ -1012,9 +1310,9 @@ public:
 	 * @brief Make transposed matrix.
 	 * @return a new matrix which is a transpose of this matrix.
 	 */
-	matrix tposed() const noexcept
+	constexpr matrix tposed() const noexcept
 	{
-		matrix ret;
+		matrix ret{};
 
 		using std::min;
 
@@ -1023,10 +1321,10 @@ public:
 		for (size_t r = 1; r != square_index; ++r) {
 			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
 			auto& ret_row = ret[r];
-			const auto& src_row = this->row(r);
+			const auto& src_row = this->operator[](r);
 			for (size_t c = 0; c != r; ++c) {
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-				ret_row[c] = this->row(c)[r];
+				ret_row[c] = this->operator[](c)[r];
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
 				ret[c][r] = src_row[c];
 			}
@@ -1035,14 +1333,15 @@ public:
 		// copy diagonal elements
 		for (size_t i = 0; i != square_index; ++i) {
 			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-			ret[i][i] = this->row(i)[i];
+			ret[i][i] = this->operator[](i)[i];
 		}
 
 		// in case the matrix is not square, then zero out the "non-square" parts
 		if constexpr (num_columns > num_rows) {
 			for (auto& r : ret) {
-				for (auto& c : utki::make_span(r).subspan(num_rows)) {
-					c = component_type(0);
+				for (size_t c = num_rows; c != num_columns; ++c) {
+					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+					r[c] = component_type(0);
 				}
 			}
 		} else {
@@ -1063,21 +1362,28 @@ public:
 	 * @param col - index of the column to remove.
 	 * @return minor matrix.
 	 */
+#if CFG_CPP >= 20
+	constexpr matrix<component_type, num_rows - 1, num_columns - 1> remove(size_t row, size_t col) const noexcept
+		requires(num_rows >= 2 && num_columns >= 2)
+#else
 	template <typename enable_type = component_type>
-	matrix<std::enable_if_t<(num_rows >= 2 && num_columns >= 2), enable_type>, num_rows - 1, num_columns - 1> remove(
+	constexpr matrix<std::enable_if_t<(num_rows >= 2 && num_columns >= 2), enable_type>, num_rows - 1, num_columns - 1> remove(
 		size_t row,
 		size_t col
 	) const noexcept
+#endif
 	{
-		matrix<component_type, num_rows - 1, num_columns - 1> ret;
+		matrix<component_type, num_rows - 1, num_columns - 1> ret{};
 
-		ASSERT(row < num_rows)
-		ASSERT(col < num_columns)
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(row < num_rows)
+			ASSERT(col < num_columns)
+		}
 
 		for (size_t dr = 0; dr != row; ++dr) {
 			for (size_t dc = 0; dc != col; ++dc) {
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-				ret[dr][dc] = this->row(dr)[dc];
+				ret[dr][dc] = this->operator[](dr)[dc];
 			}
 			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
 			for (size_t dc = col; dc != ret[dr].size(); ++dc) {
@@ -1091,7 +1397,7 @@ public:
 #	pragma GCC diagnostic ignored "-Wstringop-overflow"
 #endif
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-				ret[dr][dc] = this->row(dr)[dc + 1];
+				ret[dr][dc] = this->operator[](dr)[dc + 1];
 #if CFG_COMPILER == CFG_COMPILER_GCC && CFG_COMPILER_VERSION_MAJOR == 12
 #	pragma GCC diagnostic pop
 #endif
@@ -1101,12 +1407,12 @@ public:
 		for (size_t dr = row; dr != ret.size(); ++dr) {
 			for (size_t dc = 0; dc != col; ++dc) {
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-				ret[dr][dc] = this->row(dr + 1)[dc];
+				ret[dr][dc] = this->operator[](dr + 1)[dc];
 			}
 			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
 			for (size_t dc = col; dc != ret[dr].size(); ++dc) {
 				// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-				ret[dr][dc] = this->row(dr + 1)[dc + 1];
+				ret[dr][dc] = this->operator[](dr + 1)[dc + 1];
 			}
 		}
 
@@ -1121,11 +1427,16 @@ public:
 	 * @param row - index of the row to remove.
 	 * @param col - index of the column to remove.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type minor(size_t row, size_t col) const noexcept
+		requires(num_rows == num_columns && (num_rows >= 2))
+#else
 	template <typename enable_type = component_type>
-	std::enable_if_t<num_rows == num_columns && (num_rows >= 2), enable_type> minor( //
+	constexpr std::enable_if_t<num_rows == num_columns && (num_rows >= 2), enable_type> minor( //
 		size_t row,
 		size_t col
 	) const noexcept
+#endif
 	{
 		return this->remove(row, col).det();
 	}
@@ -1136,18 +1447,50 @@ public:
 	 * For 2x3 matrix the determinant is calculated as if it was a 2x2 matrix without the 3rd column.
 	 * @return matrix determinant.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type det() const noexcept
+		requires(num_rows == num_columns || (num_rows == 2 && num_columns == 3))
+#else
 	template <typename enable_type = component_type>
-	std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type> det() const noexcept
+	constexpr std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type> det() const noexcept
+#endif
 	{
 		if constexpr (num_rows == num_columns) {
+			const auto& m = *this;
 			if constexpr (num_rows == 1) {
-				return this->row(0)[0];
+				return this->operator[](0)[0];
+			} else if constexpr (num_rows == 2) {
+				return m[0][0] * m[1][1] - m[0][1] * m[1][0];
+			} else if constexpr (num_rows == 3) {
+				// expansion by first row
+				return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+					m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+					m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+			} else if constexpr (num_rows == 4) {
+				// Laplace expansion by first two rows,
+				// 2x2 sub-determinants of upper two rows
+				component_type s0 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+				component_type s1 = m[0][0] * m[1][2] - m[0][2] * m[1][0];
+				component_type s2 = m[0][0] * m[1][3] - m[0][3] * m[1][0];
+				component_type s3 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+				component_type s4 = m[0][1] * m[1][3] - m[0][3] * m[1][1];
+				component_type s5 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+
+				// 2x2 sub-determinants of lower two rows
+				component_type c5 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+				component_type c4 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+				component_type c3 = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+				component_type c2 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+				component_type c1 = m[2][0] * m[3][2] - m[2][2] * m[3][0];
+				component_type c0 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+
+				return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 			} else {
 				component_type ret = 0;
 				component_type sign = 1;
 				for (size_t i = 0; i != num_columns; ++i, sign = -sign) {
 					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-					ret += sign * this->row(0)[i] * this->minor(0, i);
+					ret += sign * this->operator[](0)[i] * this->minor(0, i);
 				}
 				return ret;
 			}
@@ -1166,40 +1509,88 @@ public:
 
 			// i.e. same formulae
 
-			return this->row(0)[0] * this->row(1)[1] - this->row(0)[1] * this->row(1)[0];
+			return this->operator[](0)[0] * this->operator[](1)[1] - this->operator[](0)[1] * this->operator[](1)[0];
 		}
 	}
 
-	/**
-	 * @brief Calculate inverse of the matrix.
-	 * The resulting inverse matrix M^-1 is to multiply this matrix to get identity matrix.
-	 *     M * M^-1 = I
-	 *     M^-1 * M = I
-	 * Defined only for square matrices and 2x3 matrix. The 2x3 matrix, before the inversion, is converted to
-	 * 3x3 matrix by adding (0, 0, 1) as a last row, then inverted as square matrix, then the last row of the
-	 * inversion resulting matrix is discarded.
-	 * @return right inverse matrix of this matrix.
-	 */
-	template <typename enable_type = component_type>
-	matrix<
-		std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type>,
-		num_rows,
-		num_columns>
-	inv() const noexcept
+private:
+	// Calculate adjugate matrix (i.e. transposed matrix of cofactors) and determinant.
+	// For 2x2, 3x3 and 4x4 matrices closed-form expressions are used, in case of 4x4 matrix
+	// the cofactors are expressed via 2x2 sub-determinants shared between the cofactors.
+	// For bigger matrices the cofactors are calculated via minors.
+#if CFG_CPP >= 20
+	constexpr std::pair<matrix, component_type> adj_det() const noexcept
+		requires(num_rows == num_columns)
+#else
+	template <typename enable_type = matrix>
+	constexpr std::pair<std::enable_if_t<num_rows == num_columns, enable_type>, component_type> adj_det() const noexcept
+#endif
 	{
-		if constexpr (num_rows == num_columns) {
-			if constexpr (num_rows == 1) {
-				return component_type(1) / this->row(0)[0];
-			} else {
-				component_type d = this->det();
 
-				// calculate matrix of minors
-				static_assert(num_rows == num_columns, "expected square matrix");
-				matrix<component_type, num_rows, num_columns> mm;
-
-				for (size_t r = 0; r != num_rows; ++r) {
-					component_type sign = r % 2 == 0 ? component_type(1) : component_type(-1);
-					for (size_t c = 0; c != num_columns; ++c) {
+		const auto& m = *this;
+		matrix a{};
+
+		if constexpr (num_rows == 2) {
+			a[0][0] = m[1][1];
+			a[0][1] = -m[0][1];
+			a[1][0] = -m[1][0];
+			a[1][1] = m[0][0];
+			return {a, m[0][0] * m[1][1] - m[0][1] * m[1][0]};
+		} else if constexpr (num_rows == 3) {
+			a[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+			a[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+			a[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+			a[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+			a[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+			a[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+			a[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+			a[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+			a[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+			// expansion by first row, reusing the cofactors
+			return {a, m[0][0] * a[0][0] + m[0][1] * a[1][0] + m[0][2] * a[2][0]};
+		} else if constexpr (num_rows == 4) {
+			// 2x2 sub-determinants of upper two rows
+			component_type s0 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+			component_type s1 = m[0][0] * m[1][2] - m[0][2] * m[1][0];
+			component_type s2 = m[0][0] * m[1][3] - m[0][3] * m[1][0];
+			component_type s3 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+			component_type s4 = m[0][1] * m[1][3] - m[0][3] * m[1][1];
+			component_type s5 = m[0][2] * m[1][3] - m[0][3] * m[1][2];
+
+			// 2x2 sub-determinants of lower two rows
+			component_type c5 = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+			component_type c4 = m[2][1] * m[3][3] - m[2][3] * m[3][1];
+			component_type c3 = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+			component_type c2 = m[2][0] * m[3][3] - m[2][3] * m[3][0];
+			component_type c1 = m[2][0] * m[3][2] - m[2][2] * m[3][0];
+			component_type c0 = m[2][0] * m[3][1] - m[2][1] * m[3][0];
+
+			a[0][0] = m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3;
+			a[0][1] = -m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3;
+			a[0][2] = m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3;
+			a[0][3] = -m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3;
+
+			a[1][0] = -m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1;
+			a[1][1] = m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1;
+			a[1][2] = -m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1;
+			a[1][3] = m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1;
+
+			a[2][0] = m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0;
+			a[2][1] = -m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0;
+			a[2][2] = m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0;
+			a[2][3] = -m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0;
+
+			a[3][0] = -m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0;
+			a[3][1] = m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0;
+			a[3][2] = -m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0;
+			a[3][3] = m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0;
+
+			return {a, s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0};
+		} else {
+			for (size_t r = 0; r != num_rows; ++r) {
+				component_type sign = r % 2 == 0 ? component_type(1) : component_type(-1);
+				for (size_t c = 0; c != num_columns; ++c) {
 // GCC 13 false-positively complains, when using -O3 optimization level:
 //     error: ‘void* __builtin_memcpy(void*, const void*, long unsigned int)’ offset [24, 36] is out of the bounds [0, 16] of object ‘ret’ with type ‘r4::matrix<float, 2, 2>’ [-Werror=array-bounds=]
 //     error: ‘void* __builtin_memcpy(void*, const void*, long unsigned int)’ writing between 4 and 8 bytes into a region of size 0 overflows the destination [-Werror=stringop-overflow=]
@@ -1209,51 +1600,324 @@ public:
 #	pragma GCC diagnostic ignored "-Warray-bounds"
 #	pragma GCC diagnostic ignored "-Wstringop-overflow"
 #endif
-						// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-						mm[r][c] = sign * this->minor(r, c);
+					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+					a[r][c] = sign * this->minor(r, c);
 #if CFG_COMPILER == CFG_COMPILER_GCC && CFG_COMPILER_VERSION_MAJOR == 13
 #	pragma GCC diagnostic pop
 #endif
-						sign = -sign;
-					}
+					sign = -sign;
 				}
+			}
+			a.transpose();
+			return {a, this->det()};
+		}
+	}
+
+	// Calculate inverse of affine transformation matrix, i.e. 4x4 matrix with last row (0, 0, 0, 1) or 2x3 matrix.
+	// The linear block is inverted and the translation is transformed by the inverted linear block:
+	//     | A t |^-1   | A^-1  -A^-1 * t |
+	//     | 0 1 |    = | 0     1         |
+	// Returns the inverse matrix and the determinant of the linear block, which equals to the determinant
+	// of the whole matrix.
+	// member template to avoid instantiation along with explicit instantiation of the matrix class
+	template <typename enable_type = component_type>
+	constexpr std::pair<matrix, component_type> affine_inv_det() const noexcept
+	{
+		constexpr size_t n = num_columns - 1;
 
-				mm.transpose();
-				mm /= d;
-				return mm;
+		auto [a, det] = this->template submatrix<0, 0, n, n>().inv_det();
+
+		std::pair<matrix, component_type> ret;
+		ret.second = det;
+
+		auto& m = *this;
+		auto& res = ret.first;
+		for (size_t r = 0; r != n; ++r) {
+			component_type t = 0;
+			for (size_t c = 0; c != n; ++c) {
+				res[r][c] = a[r][c];
+				t += a[r][c] * m[c][n];
 			}
+			res[r][n] = -t;
+		}
+
+		if constexpr (num_rows == num_columns) {
+			res[n].set(0);
+			res[n][n] = component_type(1);
+		}
+
+		return ret;
+	}
+
+	// check if the matrix has (0, ..., 0, 1) as a last row, 2x3 matrix is always affine
+	template <typename enable_type = component_type>
+	constexpr bool is_affine() const noexcept
+	{
+		if constexpr (num_rows == num_columns) {
+			constexpr size_t n = num_columns - 1;
+			for (size_t c = 0; c != n; ++c) {
+				if (this->operator[](n)[c] != component_type(0)) {
+					return false;
+				}
+			}
+			return this->operator[](n)[n] == component_type(1);
 		} else {
-			static_assert(num_rows == 2 && num_columns == 3, "expected 2x3 matrix");
+			return true;
+		}
+	}
 
-			matrix<component_type, 3, 3> m{
-				this->row(0),
-				this->row(1),
-				{0, 0, 1}
-			};
+	// check if the linear block of the matrix is orthonormal, i.e. A * A^T = I
+	template <typename enable_type = component_type>
+	constexpr bool is_linear_block_orthonormal() const noexcept
+	{
+		constexpr size_t n = num_columns - 1;
+
+		// rotations composed from several floating or fixed point matrices accumulate some error, so be tolerant to it
+		const component_type tolerance =
+			std::numeric_limits<component_type>::is_integer ? component_type(0) : component_type(1e-3);
+
+		auto& m = *this;
+		for (size_t i = 0; i != n; ++i) {
+			for (size_t j = 0; j != n; ++j) {
+				component_type d = 0;
+				for (size_t k = 0; k != n; ++k) {
+					d += m[i][k] * m[j][k];
+				}
+				component_type expected = i == j ? component_type(1) : component_type(0);
+				if (d > expected + tolerance || expected > d + tolerance) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
 
-			m.invert();
+	// Multiply this matrix from the right by 3x3 matrix K extended to the size of this matrix with identity:
+	//     M = M * | K 0 |
+	//             | 0 1 |
+	// Only the first 3 columns of this matrix change.
+	template <typename enable_type = component_type>
+	constexpr void right_mul_linear_block(const matrix<enable_type, 3, 3>& k) noexcept
+	{
+		static_assert(num_columns >= 3, "expected matrix with at least 3 columns");
 
-			return {m[0], m[1]};
+		for (auto& r : *this) {
+			component_type r0 = r[0];
+			component_type r1 = r[1];
+			component_type r2 = r[2];
+			r[0] = r0 * k[0][0] + r1 * k[1][0] + r2 * k[2][0];
+			r[1] = r0 * k[0][1] + r1 * k[1][1] + r2 * k[2][1];
+			r[2] = r0 * k[0][2] + r1 * k[1][2] + r2 * k[2][2];
 		}
 	}
 
+public:
+	/**
+	 * @brief Calculate inverse and determinant of the matrix.
+	 * Same as inv(), but also returns determinant of this matrix, so that caller can detect
+	 * singular (non-invertible) matrices. Calculating both at once is cheaper than calling det() and inv().
+	 * For 2x3 matrix the determinant is calculated as if it was a 2x2 matrix without the 3rd column, see det().
+	 * For 4x4 float matrix SSE accelerated implementation is used, if available.
+	 * @return pair of inverse matrix and determinant of this matrix. If the determinant is zero,
+	 *         then the matrix is not invertible. In that case the returned inverse matrix is the adjugate matrix
+	 *         divided by zero for floating point components, i.e. it contains infinities and NaNs,
+	 *         and the adjugate matrix itself for integral components.
+	 */
+#if CFG_CPP >= 20
+	constexpr std::pair<matrix, component_type> inv_det() const noexcept
+		requires(num_rows == num_columns || (num_rows == 2 && num_columns == 3))
+#else
+	template <typename enable_type = component_type>
+	constexpr std::pair<
+		matrix<
+			std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type>,
+			num_rows,
+			num_columns>,
+		component_type>
+	inv_det() const noexcept
+#endif
+	{
+		if constexpr (num_rows == num_columns) {
+			if constexpr (num_rows == 1) {
+				return {
+					matrix{vector<component_type, 1>{component_type(1) / this->operator[](0)[0]}},
+					this->operator[](0)[0]
+				};
+			} else {
+				if constexpr (simd_kernels::enabled) {
+					if (!simd::is_constant_evaluated()) {
+						std::pair<matrix, component_type> ret;
+						ret.second = simd_kernels::inv_det(this->front().data(), ret.first.front().data());
+						return ret;
+					}
+				}
+
+				auto ret = this->adj_det();
+				// avoid division by zero, which is undefined behaviour for integral types
+				if (!std::is_integral_v<component_type> || ret.second != component_type(0)) {
+					ret.first /= ret.second;
+				}
+				return ret;
+			}
+		} else {
+			static_assert(num_rows == 2 && num_columns == 3, "expected 2x3 matrix");
+
+			// 2x3 matrix is always affine, no need to promote it to 3x3
+			return this->affine_inv_det();
+		}
+	}
+
+	/**
+	 * @brief Calculate inverse of the matrix.
+	 * The resulting inverse matrix M^-1 is to multiply this matrix to get identity matrix.
+	 *     M * M^-1 = I
+	 *     M^-1 * M = I
+	 * Defined only for square matrices and 2x3 matrix. The 2x3 matrix is treated as 3x3 matrix with (0, 0, 1)
+	 * as a last row, so it is inverted as affine transformation, see inv_affine().
+	 * Use inv_det() to also get the determinant for detecting singular matrices.
+	 * @return right inverse matrix of this matrix.
+	 */
+#if CFG_CPP >= 20
+	constexpr matrix inv() const noexcept
+		requires(num_rows == num_columns || (num_rows == 2 && num_columns == 3))
+#else
+	template <typename enable_type = component_type>
+	constexpr matrix<
+		std::enable_if_t<num_rows == num_columns || (num_rows == 2 && num_columns == 3), enable_type>,
+		num_rows,
+		num_columns>
+	inv() const noexcept
+#endif
+	{
+		return this->inv_det().first;
+	}
+
 	/**
 	 * @brief Invert this matrix.
 	 * @return reference to this matrix.
 	 */
-	matrix& invert() noexcept
+	constexpr matrix& invert() noexcept
 	{
 		this->operator=(this->inv());
 		return *this;
 	}
 
+	/**
+	 * @brief Calculate inverse of affine transformation matrix.
+	 * Defined only for 4x4 matrix and 2x3 matrix. The 4x4 matrix must have (0, 0, 0, 1) as a last row,
+	 * which is checked by assertion in debug build. The 2x3 matrix is always affine.
+	 * Only the linear 3x3 (2x2 for 2x3 matrix) block is inverted, and the translation column
+	 * is transformed by the inverted block, which is several times cheaper than inv().
+	 * @return inverse matrix of this matrix.
+	 */
+#if CFG_CPP >= 20
+	constexpr matrix inv_affine() const noexcept
+		requires((num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3))
+#else
+	template <typename enable_type = component_type>
+	constexpr matrix<
+		std::enable_if_t<(num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3), enable_type>,
+		num_rows,
+		num_columns>
+	inv_affine() const noexcept
+#endif
+	{
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(this->is_affine())
+		}
+		return this->affine_inv_det().first;
+	}
+
+	/**
+	 * @brief Invert this affine transformation matrix.
+	 * See inv_affine() for details.
+	 * @return reference to this matrix.
+	 */
+#if CFG_CPP >= 20
+	constexpr matrix& invert_affine() noexcept
+		requires((num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3))
+#else
+	template <typename enable_type = matrix>
+	constexpr std::enable_if_t<(num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3), enable_type&>
+	invert_affine() noexcept
+#endif
+	{
+		this->operator=(this->inv_affine());
+		return *this;
+	}
+
+	/**
+	 * @brief Calculate inverse of rigid transformation matrix.
+	 * Defined only for 4x4 matrix and 2x3 matrix. The matrix must be affine, and its linear
+	 * 3x3 (2x2 for 2x3 matrix) block must be a pure rotation, i.e. orthonormal matrix.
+	 * This is checked by assertion in debug build.
+	 * The linear block is transposed and the translation is rotated by the transposed block and negated.
+	 * No division is involved, so this is the cheapest way to invert, for example, a camera or a bone transformation.
+	 * @return inverse matrix of this matrix.
+	 */
+#if CFG_CPP >= 20
+	constexpr matrix inv_rigid() const noexcept
+		requires((num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3))
+#else
+	template <typename enable_type = component_type>
+	constexpr matrix<
+		std::enable_if_t<(num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3), enable_type>,
+		num_rows,
+		num_columns>
+	inv_rigid() const noexcept
+#endif
+	{
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(this->is_affine())
+			ASSERT(this->is_linear_block_orthonormal())
+		}
+
+		constexpr size_t n = num_columns - 1;
+
+		auto& m = *this;
+		matrix ret{};
+		for (size_t r = 0; r != n; ++r) {
+			component_type t = 0;
+			for (size_t c = 0; c != n; ++c) {
+				ret[r][c] = m[c][r];
+				t += m[c][r] * m[c][n];
+			}
+			ret[r][n] = -t;
+		}
+
+		if constexpr (num_rows == num_columns) {
+			ret[n].set(0);
+			ret[n][n] = component_type(1);
+		}
+
+		return ret;
+	}
+
+	/**
+	 * @brief Invert this rigid transformation matrix.
+	 * See inv_rigid() for details.
+	 * @return reference to this matrix.
+	 */
+#if CFG_CPP >= 20
+	constexpr matrix& invert_rigid() noexcept
+		requires((num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3))
+#else
+	template <typename enable_type = matrix>
+	constexpr std::enable_if_t<(num_rows == 4 && num_columns == 4) || (num_rows == 2 && num_columns == 3), enable_type&>
+	invert_rigid() noexcept
+#endif
+	{
+		this->operator=(this->inv_rigid());
+		return *this;
+	}
+
 	/**
 	 * @brief Snap each matrix component to 0.
 	 * For each component, set it to 0 if its absolute value does not exceed the given threshold.
 	 * @param threshold - the snapping threshold.
 	 * @return reference to this matrix.
 	 */
-	matrix& snap_to_zero(component_type threshold) noexcept
+	constexpr matrix& snap_to_zero(component_type threshold) noexcept
 	{
 		for (auto& r : *this) {
 			r.snap_to_zero(threshold);
@@ -1265,21 +1929,13 @@ public:
 	 * @brief Set each element of this matrix to a given number.
 	 * @param num - number to set each matrix element to.
 	 */
-	matrix& set(component_type num) noexcept
+	constexpr matrix& set(component_type num) noexcept
 	{
 		for (auto& e : *this) {
 			e.set(num);
 		}
 		return *this;
 	}
-
-	friend std::ostream& operator<<(std::ostream& s, const matrix& mat)
-	{
-		for (auto& r : mat) {
-			s << "|" << r << std::endl;
-		}
-		return s;
-	};
 };
 
 template <class component_type>
@@ -1295,3 +1951,21 @@ static_assert(
 );
 
 } // namespace r4
+
+// The r4 library contains explicit instantiations of matrices of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class matrix<float, 2, 3>;
+extern template class matrix<float, 3, 3>;
+extern template class matrix<float, 4, 4>;
+extern template class matrix<double, 2, 3>;
+extern template class matrix<double, 3, 3>;
+extern template class matrix<double, 4, 4>;
+extern template class matrix<int, 2, 3>;
+extern template class matrix<int, 3, 3>;
+extern template class matrix<int, 4, 4>;
+
+} // namespace r4
+#endif
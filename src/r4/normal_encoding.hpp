@@ -0,0 +1,556 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace r4 {
+
+namespace normal_encoding_internal {
+
+// SIMD registers holding 'size' components of a batch of vectors, one register per component.
+// std::array is not used, since GCC warns about ignored attributes of SIMD register types used as template arguments.
+template <typename batch, size_t size>
+struct components {
+	// NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, modernize-avoid-c-arrays)
+	typename batch::register_type c[size];
+
+	typename batch::register_type& operator[](size_t i) noexcept
+	{
+		ASSERT(i < size)
+		return this->c[i]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+	}
+
+	const typename batch::register_type& operator[](size_t i) const noexcept
+	{
+		ASSERT(i < size)
+		return this->c[i]; // NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+	}
+};
+
+// Operations shared by the encodings, implemented for any simd::batch of floats.
+// Single normals are processed with the same batch, with all lanes holding the same vector,
+// so that the results do not depend on whether the normal is encoded alone or in a span.
+template <typename batch>
+struct ops {
+	using reg = typename batch::register_type;
+
+	static reg broadcast(float v) noexcept
+	{
+		return batch::broadcast(v);
+	}
+
+	static reg abs(reg a) noexcept
+	{
+		return batch::max(a, batch::sub(broadcast(0), a));
+	}
+
+	// 1 for non-negative values, -1 for negative values
+	static reg sign(reg a) noexcept
+	{
+		return batch::select(batch::less(a, broadcast(0)), broadcast(-1), broadcast(1));
+	}
+
+	// round to nearest even, for values of magnitude less than 2^22
+	static reg round(reg a) noexcept
+	{
+		const reg magic = broadcast(12582912.0f); // 1.5 * 2^23
+		return batch::sub(batch::add(a, magic), magic);
+	}
+
+	// clamp to [-1, 1], NaN becomes 1
+	static reg clamp(reg a) noexcept
+	{
+		return batch::max(broadcast(-1), batch::min(broadcast(1), a));
+	}
+
+	// [-1, 1] -> [-max_code, max_code]
+	static reg to_snorm(reg a, float max_code) noexcept
+	{
+		return round(batch::mul(clamp(a), broadcast(max_code)));
+	}
+
+	// [-max_code - 1, max_code] -> [-1, 1]
+	static reg from_snorm(reg c, float max_code) noexcept
+	{
+		return batch::max(broadcast(-1), batch::mul(c, broadcast(1 / max_code)));
+	}
+
+	// [-1, 1] -> [0, max_code]
+	static reg to_unorm(reg a, float max_code) noexcept
+	{
+		const reg half = broadcast(0.5f);
+		return round(batch::mul(batch::add(batch::mul(clamp(a), half), half), broadcast(max_code)));
+	}
+
+	// [0, max_code] -> [-1, 1]
+	static reg from_unorm(reg c, float max_code) noexcept
+	{
+		return batch::sub(batch::mul(c, broadcast(2 / max_code)), broadcast(1));
+	}
+
+	static void normalize(components<batch, 3>& n) noexcept
+	{
+		reg d = batch::mul(n[0], n[0]);
+		d = batch::add(d, batch::mul(n[1], n[1]));
+		d = batch::add(d, batch::mul(n[2], n[2]));
+		d = batch::div(broadcast(1), batch::sqrt(d));
+		for (size_t i = 0; i != 3; ++i) {
+			n[i] = batch::mul(n[i], d);
+		}
+	}
+
+	// project the unit vector to the octahedron and unfold the octahedron to [-1, 1] x [-1, 1] square
+	static components<batch, 2> to_octahedral(const components<batch, 3>& n) noexcept
+	{
+		const reg l1 = batch::add(batch::add(abs(n[0]), abs(n[1])), abs(n[2]));
+		const reg inv_l1 = batch::div(broadcast(1), l1);
+		const reg u = batch::mul(n[0], inv_l1);
+		const reg v = batch::mul(n[1], inv_l1);
+
+		// the lower hemisphere is folded over the diagonals of the square
+		const reg one = broadcast(1);
+		const reg folded_u = batch::mul(batch::sub(one, abs(v)), sign(u));
+		const reg folded_v = batch::mul(batch::sub(one, abs(u)), sign(v));
+		const auto lower = batch::less(n[2], broadcast(0));
+
+		return {batch::select(lower, folded_u, u), batch::select(lower, folded_v, v)};
+	}
+
+	static components<batch, 3> from_octahedral(const components<batch, 2>& p) noexcept
+	{
+		const reg zero = broadcast(0);
+
+		components<batch, 3> n = {p[0], p[1], batch::sub(batch::sub(broadcast(1), abs(p[0])), abs(p[1]))};
+
+		// unfold the lower hemisphere
+		const reg t = batch::max(zero, batch::sub(zero, n[2]));
+		n[0] = batch::sub(n[0], batch::mul(t, sign(n[0])));
+		n[1] = batch::sub(n[1], batch::mul(t, sign(n[1])));
+
+		normalize(n);
+		return n;
+	}
+};
+
+// integer codes of a single encoded vector
+template <size_t size>
+using codes = std::array<int32_t, size>;
+
+// maximal value of signed normalized integer of given number of bits
+template <unsigned num_bits>
+constexpr float max_snorm = float((1 << (num_bits - 1)) - 1);
+
+// maximal value of unsigned normalized integer of given number of bits
+template <unsigned num_bits>
+constexpr float max_unorm = float((1 << num_bits) - 1);
+
+template <typename int_type>
+struct octahedral {
+	using encoded_type = vector2<int_type>;
+
+	constexpr static size_t num_codes = 2;
+
+	constexpr static auto max_code = max_snorm<sizeof(int_type) * 8>;
+
+	template <typename batch>
+	static components<batch, num_codes> encode(
+		const components<batch, 3>& n
+	) noexcept
+	{
+		using ops = normal_encoding_internal::ops<batch>;
+		auto p = ops::to_octahedral(n);
+		return {ops::to_snorm(p[0], max_code), ops::to_snorm(p[1], max_code)};
+	}
+
+	template <typename batch>
+	static components<batch, 3> decode(
+		const components<batch, num_codes>& c
+	) noexcept
+	{
+		using ops = normal_encoding_internal::ops<batch>;
+		return ops::from_octahedral({ops::from_snorm(c[0], max_code), ops::from_snorm(c[1], max_code)});
+	}
+
+	static encoded_type pack(const codes<num_codes>& c) noexcept
+	{
+		return {int_type(c[0]), int_type(c[1])};
+	}
+
+	static codes<num_codes> unpack(const encoded_type& e) noexcept
+	{
+		return {e[0], e[1]};
+	}
+};
+
+// 10 bits per component in bits [0:9], [10:19] and [20:29], bits [30:31] are zero
+template <bool is_signed>
+struct packed_10_10_10_2 {
+	using encoded_type = uint32_t;
+
+	constexpr static size_t num_codes = 3;
+
+	constexpr static unsigned num_bits = 10;
+	constexpr static uint32_t mask = (1 << num_bits) - 1;
+
+	template <typename batch>
+	static typename batch::register_type to_code(typename batch::register_type a) noexcept
+	{
+		if constexpr (is_signed) {
+			return ops<batch>::to_snorm(a, max_snorm<num_bits>);
+		} else {
+			return ops<batch>::to_unorm(a, max_unorm<num_bits>);
+		}
+	}
+
+	template <typename batch>
+	static typename batch::register_type from_code(typename batch::register_type c) noexcept
+	{
+		if constexpr (is_signed) {
+			return ops<batch>::from_snorm(c, max_snorm<num_bits>);
+		} else {
+			return ops<batch>::from_unorm(c, max_unorm<num_bits>);
+		}
+	}
+
+	template <typename batch>
+	static components<batch, num_codes> encode(const components<batch, 3>& n) noexcept
+	{
+		return {to_code<batch>(n[0]), to_code<batch>(n[1]), to_code<batch>(n[2])};
+	}
+
+	template <typename batch>
+	static components<batch, 3> decode(const components<batch, num_codes>& c) noexcept
+	{
+		components<batch, 3> n = {from_code<batch>(c[0]), from_code<batch>(c[1]), from_code<batch>(c[2])};
+		ops<batch>::normalize(n);
+		return n;
+	}
+
+	// two's complement representation of negative values is truncated to 10 bits
+	static uint32_t to_bits(int32_t code) noexcept
+	{
+		return uint32_t(code) & mask;
+	}
+
+	// takes the lower 10 bits
+	static int32_t from_bits(uint32_t bits) noexcept
+	{
+		if constexpr (is_signed) {
+			// sign extend
+			constexpr unsigned shift = 32 - num_bits;
+			return int32_t(bits << shift) >> shift;
+		} else {
+			return int32_t(bits & mask);
+		}
+	}
+
+	static encoded_type pack(const codes<num_codes>& c) noexcept
+	{
+		return to_bits(c[0]) | (to_bits(c[1]) << num_bits) | (to_bits(c[2]) << (2 * num_bits));
+	}
+
+	static codes<num_codes> unpack(encoded_type e) noexcept
+	{
+		return {from_bits(e), from_bits(e >> num_bits), from_bits(e >> (2 * num_bits))};
+	}
+};
+
+template <typename int_type>
+struct snorm {
+	using encoded_type = vector3<int_type>;
+
+	constexpr static size_t num_codes = 3;
+
+	constexpr static auto max_code = max_snorm<sizeof(int_type) * 8>;
+
+	template <typename batch>
+	static components<batch, num_codes> encode(
+		const components<batch, 3>& n
+	) noexcept
+	{
+		using ops = normal_encoding_internal::ops<batch>;
+		return {ops::to_snorm(n[0], max_code), ops::to_snorm(n[1], max_code), ops::to_snorm(n[2], max_code)};
+	}
+
+	template <typename batch>
+	static components<batch, 3> decode(
+		const components<batch, num_codes>& c
+	) noexcept
+	{
+		using ops = normal_encoding_internal::ops<batch>;
+		components<batch, 3> n = {
+			ops::from_snorm(c[0], max_code),
+			ops::from_snorm(c[1], max_code),
+			ops::from_snorm(c[2], max_code)
+		};
+		ops::normalize(n);
+		return n;
+	}
+
+	static encoded_type pack(const codes<num_codes>& c) noexcept
+	{
+		return {int_type(c[0]), int_type(c[1]), int_type(c[2])};
+	}
+
+	static codes<num_codes> unpack(const encoded_type& e) noexcept
+	{
+		return {e[0], e[1], e[2]};
+	}
+};
+
+} // namespace normal_encoding_internal
+
+/**
+ * @brief Compact encodings of unit 3d vectors.
+ * The encodings are used as template arguments of r4::encode_normal(), r4::decode_normal(),
+ * r4::encode_normals() and r4::decode_normals() functions.
+ * Each encoding defines the encoded_type, i.e. the type of the encoded normal.
+ * The encoders expect unit vectors, decoders return unit vectors.
+ * The error bounds are for the angle between unit vector and the result of its encoding and decoding.
+ */
+namespace normal_encoding {
+
+/**
+ * @brief Octahedral encoding in two 16-bit signed normalized integers.
+ * The vector is projected to the octahedron, which is unfolded to a square.
+ * The coordinates in the square are stored as r4::vector2<int16_t>, ready for RG16_SNORM texture or vertex format.
+ * 4 bytes per normal, the error is less than 0.004 degrees.
+ */
+struct octahedral16 : public normal_encoding_internal::octahedral<int16_t> {};
+
+/**
+ * @brief Octahedral encoding in two 8-bit signed normalized integers.
+ * Same as octahedral16, but the coordinates are stored as r4::vector2<int8_t>, ready for RG8_SNORM format.
+ * 2 bytes per normal, the error is less than 1 degree.
+ */
+struct octahedral8 : public normal_encoding_internal::octahedral<int8_t> {};
+
+/**
+ * @brief Unsigned normalized 10-bit components packed into 32-bit integer.
+ * Components are mapped from [-1, 1] to [0, 1023] and stored in bits [0:9], [10:19] and [20:29]
+ * of uint32_t, bits [30:31] are zero. This is RGB10_A2_UNORM format.
+ * 4 bytes per normal, the error is less than 0.1 degree.
+ */
+struct unorm_10_10_10_2 : public normal_encoding_internal::packed_10_10_10_2<false> {};
+
+/**
+ * @brief Signed normalized 10-bit components packed into 32-bit integer.
+ * Components are mapped from [-1, 1] to [-511, 511] and stored in two's complement form in bits [0:9], [10:19] and [20:29]
+ * of uint32_t, bits [30:31] are zero. This is RGB10_A2_SNORM format.
+ * 4 bytes per normal, the error is less than 0.1 degree.
+ */
+struct snorm_10_10_10_2 : public normal_encoding_internal::packed_10_10_10_2<true> {};
+
+/**
+ * @brief Three 16-bit signed normalized components.
+ * Components are mapped from [-1, 1] to [-32767, 32767] and stored as r4::vector3<int16_t>.
+ * 6 bytes per normal, the error is less than 0.002 degrees.
+ */
+struct snorm16 : public normal_encoding_internal::snorm<int16_t> {};
+
+} // namespace normal_encoding
+
+/**
+ * @brief Encode unit vector.
+ * The result is same as of r4::encode_normals() for the same vector.
+ * @tparam encoding_type - one of the encodings from r4::normal_encoding namespace.
+ * @param n - unit vector to encode.
+ * @return Encoded vector.
+ */
+template <typename encoding_type>
+typename encoding_type::encoded_type encode_normal(const vector3<float>& n) noexcept
+{
+	using batch = simd::batch<float>;
+	constexpr size_t num_codes = encoding_type::num_codes;
+
+	// all lanes hold the same vector
+	auto c = encoding_type::template encode<batch>({
+		batch::broadcast(n[0]), //
+		batch::broadcast(n[1]),
+		batch::broadcast(n[2])
+	});
+
+	alignas(sizeof(typename batch::register_type)) std::array<int32_t, batch::width> codes{};
+
+	normal_encoding_internal::codes<num_codes> lane;
+	for (size_t k = 0; k != num_codes; ++k) {
+		batch::store_int32(codes.data(), c[k]);
+		lane[k] = codes.front();
+	}
+	return encoding_type::pack(lane);
+}
+
+/**
+ * @brief Decode unit vector.
+ * The result is same as of r4::decode_normals() for the same encoded vector.
+ * @tparam encoding_type - one of the encodings from r4::normal_encoding namespace.
+ * @param e - encoded vector.
+ * @return Decoded unit vector.
+ */
+template <typename encoding_type>
+vector3<float> decode_normal(const typename encoding_type::encoded_type& e) noexcept
+{
+	using batch = simd::batch<float>;
+	constexpr size_t num_codes = encoding_type::num_codes;
+
+	auto lane = encoding_type::unpack(e);
+
+	// all lanes hold the same vector, the codes are small enough to be converted to float exactly
+	normal_encoding_internal::components<batch, num_codes> c;
+	for (size_t k = 0; k != num_codes; ++k) {
+		c[k] = batch::broadcast(float(lane[k]));
+	}
+
+	auto n = encoding_type::template decode<batch>(c);
+
+	alignas(sizeof(typename batch::register_type)) std::array<float, batch::width> values{};
+
+	vector3<float> ret;
+	for (size_t k = 0; k != 3; ++k) {
+		batch::store_aligned(values.data(), n[k]);
+		ret[k] = values.front();
+	}
+	return ret;
+}
+
+/**
+ * @brief Encode array of unit vectors.
+ * The vectors are processed several at a time using SIMD, if available.
+ * The results are same as of r4::encode_normal() for each vector.
+ * @tparam encoding_type - one of the encodings from r4::normal_encoding namespace.
+ * @param in - unit vectors to encode.
+ * @param out - encoded vectors, must be of the same size as the input span.
+ */
+template <typename encoding_type>
+void encode_normals(
+	utki::span<const vector3<float>> in,
+	utki::span<typename encoding_type::encoded_type> out
+) noexcept
+{
+	ASSERT(in.size() == out.size())
+
+	using batch = simd::batch<float>;
+	constexpr size_t width = batch::width;
+	constexpr size_t num_codes = encoding_type::num_codes;
+
+	alignas(sizeof(typename batch::register_type)) std::array<std::array<int32_t, width>, num_codes> codes{};
+
+	size_t i = 0;
+	for (; i + width <= in.size(); i += width) {
+		normal_encoding_internal::components<batch, 3> n;
+		// the vectors are stored one after another
+		batch::load3(in[i].data(), n[0], n[1], n[2]);
+
+		auto c = encoding_type::template encode<batch>(n);
+
+		for (size_t k = 0; k != num_codes; ++k) {
+			batch::store_int32(codes[k].data(), c[k]);
+		}
+
+		for (size_t l = 0; l != width; ++l) {
+			normal_encoding_internal::codes<num_codes> lane;
+			for (size_t k = 0; k != num_codes; ++k) {
+				lane[k] = codes[k][l];
+			}
+			out[i + l] = encoding_type::pack(lane);
+		}
+	}
+
+	for (; i != in.size(); ++i) {
+		out[i] = encode_normal<encoding_type>(in[i]);
+	}
+}
+
+/**
+ * @brief Decode array of unit vectors.
+ * The vectors are processed several at a time using SIMD, if available.
+ * The results are same as of r4::decode_normal() for each encoded vector.
+ * @tparam encoding_type - one of the encodings from r4::normal_encoding namespace.
+ * @param in - encoded vectors.
+ * @param out - decoded unit vectors, must be of the same size as the input span.
+ */
+template <typename encoding_type>
+void decode_normals(
+	utki::span<const typename encoding_type::encoded_type> in,
+	utki::span<vector3<float>> out
+) noexcept
+{
+	ASSERT(in.size() == out.size())
+
+	using batch = simd::batch<float>;
+	constexpr size_t width = batch::width;
+	constexpr size_t num_codes = encoding_type::num_codes;
+
+	// The codes are unpacked a block at a time and then loaded to SIMD registers.
+	// Loading the codes right after storing them one by one would stall on store forwarding.
+	constexpr size_t block_size = 64;
+	static_assert(block_size % width == 0, "block size must be multiple of batch width");
+
+	alignas(sizeof(typename batch::register_type)) std::array<std::array<int32_t, block_size>, num_codes> codes{};
+
+	size_t i = 0;
+	while (in.size() - i >= width) {
+		const size_t size = std::min(block_size, (in.size() - i) / width * width);
+
+		for (size_t l = 0; l != size; ++l) {
+			auto lane = encoding_type::unpack(in[i + l]);
+			for (size_t k = 0; k != num_codes; ++k) {
+				codes[k][l] = lane[k];
+			}
+		}
+
+		for (size_t b = 0; b != size; b += width) {
+			normal_encoding_internal::components<batch, num_codes> c;
+			for (size_t k = 0; k != num_codes; ++k) {
+				c[k] = batch::load_int32(std::next(codes[k].data(), b));
+			}
+
+			auto n = encoding_type::template decode<batch>(c);
+
+			// the vectors are stored one after another
+			batch::store3(out[i + b].data(), n[0], n[1], n[2]);
+		}
+
+		i += size;
+	}
+
+	for (; i != in.size(); ++i) {
+		out[i] = decode_normal<encoding_type>(in[i]);
+	}
+}
+
+} // namespace r4
@@ -28,10 +28,11 @@ SOFTWARE.
 
 #include <array>
 #include <cmath>
-#include <iostream>
 
 #include <utki/debug.hpp>
 
+#include "math.hpp"
+#include "simd.hpp"
 #include "vector.hpp"
 
 namespace r4 {
@@ -45,6 +46,23 @@ class matrix;
 template <typename component_type>
 class quaternion
 {
+	// SIMD accelerated implementation of quaternion operations, if available for this quaternion type
+	using simd_kernels = simd::quaternion_kernels<component_type>;
+
+	// pointer to quaternion components in (x, y, z, w) order, the layout is checked by static_asserts
+	// after the class declaration
+	const component_type* data() const noexcept
+	{
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		return reinterpret_cast<const component_type*>(this);
+	}
+
+	component_type* data() noexcept
+	{
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		return reinterpret_cast<component_type*>(this);
+	}
+
 public:
 	/**
 	 * @brief Vector component of the quaternion.
@@ -60,7 +78,7 @@ public:
 	 * @brief x component.
 	 * Synonym of this->v.x().
 	 */
-	component_type& x() noexcept
+	constexpr component_type& x() noexcept
 	{
 		return this->v.x();
 	}
@@ -69,7 +87,7 @@ public:
 	 * @brief x component.
 	 * Synonym of this->v.x().
 	 */
-	const component_type& x() const noexcept
+	constexpr const component_type& x() const noexcept
 	{
 		return this->v.x();
 	}
@@ -78,7 +96,7 @@ public:
 	 * @brief y component.
 	 * Synonym of this->v.y().
 	 */
-	component_type& y() noexcept
+	constexpr component_type& y() noexcept
 	{
 		return this->v.y();
 	}
@@ -87,7 +105,7 @@ public:
 	 * @brief y component.
 	 * Synonym of this->v.y().
 	 */
-	const component_type& y() const noexcept
+	constexpr const component_type& y() const noexcept
 	{
 		return this->v.y();
 	}
@@ -96,7 +114,7 @@ public:
 	 * @brief z component.
 	 * Synonym of this->v.z().
 	 */
-	component_type& z() noexcept
+	constexpr component_type& z() noexcept
 	{
 		return this->v.z();
 	}
@@ -105,7 +123,7 @@ public:
 	 * @brief z component.
 	 * Synonym of this->v.z().
 	 */
-	const component_type& z() const noexcept
+	constexpr const component_type& z() const noexcept
 	{
 		return this->v.z();
 	}
@@ -114,7 +132,7 @@ public:
 	 * @brief w component.
 	 * Synonym of this->v.w().
 	 */
-	component_type& w() noexcept
+	constexpr component_type& w() noexcept
 	{
 		return this->s;
 	}
@@ -123,7 +141,7 @@ public:
 	 * @brief w component.
 	 * Synonym of this->v.w().
 	 */
-	const component_type& w() const noexcept
+	constexpr const component_type& w() const noexcept
 	{
 		return this->s;
 	}
@@ -196,7 +214,7 @@ public:
 	 * @return converted quaternion.
 	 */
 	template <typename another_component_type>
-	quaternion<another_component_type> to() noexcept
+	constexpr quaternion<another_component_type> to() const noexcept
 	{
 		return quaternion<another_component_type>{
 			this->v.template to<another_component_type>(),
@@ -208,7 +226,7 @@ public:
 	 * @brief Convert to vector4 holding components of the quaternion.
 	 * @return vector4 with components (v.x, v.y, v.z, s).
 	 */
-	vector<component_type, 4> to_vector4() const noexcept
+	constexpr vector<component_type, 4> to_vector4() const noexcept
 	{
 		return {this->v.x(), this->v.y(), this->v.z(), this->s};
 	}
@@ -220,7 +238,7 @@ public:
 	 * @return true if all componentes of this quaternion are same as of given quaternion.
 	 * @return false otherwise.
 	 */
-	bool operator==(const quaternion& q) const noexcept
+	constexpr bool operator==(const quaternion& q) const noexcept
 	{
 		return this->v == q.v && this->s == q.s;
 	}
@@ -230,7 +248,7 @@ public:
 	 * Note, complex conjugate of quaternion (x, y, z, w) is (-x, -y, -z, w).
 	 * @return quaternion instance which is a complex conjugate of this quaternion.
 	 */
-	quaternion operator!() const noexcept
+	constexpr quaternion operator!() const noexcept
 	{
 		return quaternion(-this->v, this->s);
 	}
@@ -240,7 +258,7 @@ public:
 	 *
 	 * @return negated quaternion.
 	 */
-	quaternion operator-() const noexcept
+	constexpr quaternion operator-() const noexcept
 	{
 		return quaternion(-this->v, -this->s);
 	}
@@ -251,7 +269,7 @@ public:
 	 * @param q - quaternion to add to this quaternion.
 	 * @return Reference to this quaternion object.
 	 */
-	quaternion& operator+=(const quaternion& q) noexcept
+	constexpr quaternion& operator+=(const quaternion& q) noexcept
 	{
 		this->v += q.v;
 		this->s += q.s;
@@ -264,7 +282,7 @@ public:
 	 * @param q - quaternion to add to this one.
 	 * @return A quaternion object representing sum of quaternions.
 	 */
-	quaternion operator+(const quaternion& q) const noexcept
+	constexpr quaternion operator+(const quaternion& q) const noexcept
 	{
 		return (quaternion(*this) += q);
 	}
@@ -275,7 +293,7 @@ public:
 	 * @param q - quaternion to subtract from this one.
 	 * @return result of subtraction of this quaternion and given quaternion.
 	 */
-	quaternion operator-(const quaternion& q) const noexcept
+	constexpr quaternion operator-(const quaternion& q) const noexcept
 	{
 		return this->operator+(-q);
 	}
@@ -286,7 +304,7 @@ public:
 	 * @param s - scalar value to multiply by.
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& operator*=(component_type s) noexcept
+	constexpr quaternion& operator*=(component_type s) noexcept
 	{
 		this->v *= s;
 		this->s *= s;
@@ -298,7 +316,7 @@ public:
 	 * @param s - scalar value to multiply by.
 	 * @return resulting quaternion instance.
 	 */
-	quaternion operator*(component_type s) const noexcept
+	constexpr quaternion operator*(component_type s) const noexcept
 	{
 		return (quaternion(*this) *= s);
 	}
@@ -309,7 +327,7 @@ public:
 	 * @param quat - quaternion to multiply by.
 	 * @return quaternion resulting from multiplication of given scalar by given quaternion.
 	 */
-	friend quaternion operator*(component_type num, const quaternion& quat) noexcept
+	constexpr friend quaternion operator*(component_type num, const quaternion& quat) noexcept
 	{
 		return quat * num;
 	}
@@ -320,7 +338,7 @@ public:
 	 * @param s - scalar value to divide by.
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& operator/=(component_type s) noexcept
+	constexpr quaternion& operator/=(component_type s) noexcept
 	{
 		this->v /= s;
 		this->s /= s;
@@ -332,7 +350,7 @@ public:
 	 * @param s - scalar value to divide by.
 	 * @return resulting quaternion instance.
 	 */
-	quaternion operator/(component_type s) const noexcept
+	constexpr quaternion operator/(component_type s) const noexcept
 	{
 		return (quaternion(*this) /= s);
 	}
@@ -344,9 +362,14 @@ public:
 	 * x1 * x2 + y1 * y2 + z1 * z2 + w1 * w2
 	 * @return result of the dot product.
 	 */
-	component_type dot(const quaternion& q) const noexcept
+	constexpr component_type dot(const quaternion& q) const noexcept
 	{
-		return this->v * q.v + this->s * q.s;
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::dot(this->data(), q.data());
+			}
+		}
+		return this->v.dot(q.v) + this->s * q.s;
 	}
 
 	/**
@@ -357,7 +380,7 @@ public:
 	 * @param q - quaternion to multiply by.
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& operator*=(const quaternion& q) noexcept
+	constexpr quaternion& operator*=(const quaternion& q) noexcept
 	{
 		return this->operator=(this->operator*(q));
 	}
@@ -378,9 +401,16 @@ public:
 	 * @param q - quaternion to multiply by.
 	 * @return resulting quaternion instance.
 	 */
-	quaternion operator*(const quaternion& q) const noexcept
+	constexpr quaternion operator*(const quaternion& q) const noexcept
 	{
-		return quaternion(this->s * q.v + q.s * this->v + this->v.cross(q.v), this->s * q.s - this->v * q.v);
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				quaternion ret{};
+				simd_kernels::mul(this->data(), q.data(), ret.data());
+				return ret;
+			}
+		}
+		return quaternion(this->s * q.v + q.s * this->v + this->v.cross(q.v), this->s * q.s - this->v.dot(q.v));
 	}
 
 	// TODO: remove deprecated stuff
@@ -398,7 +428,7 @@ public:
 	 * It is a unit quaternion representing no rotation.
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& set_identity() noexcept
+	constexpr quaternion& set_identity() noexcept
 	{
 		this->v.set(component_type(0));
 		this->s = component_type(1);
@@ -410,7 +440,7 @@ public:
 	 * Note, complex conjugate of quaternion (x, y, z, w) is (-x, -y, -z, w).
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& conjugate() noexcept
+	constexpr quaternion& conjugate() noexcept
 	{
 		return this->operator=(this->operator!());
 	}
@@ -420,7 +450,7 @@ public:
 	 * Note, negating quaternion means changing the sign of its every component.
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& negate() noexcept
+	constexpr quaternion& negate() noexcept
 	{
 		this->v.negate();
 		this->s = -this->s;
@@ -431,7 +461,7 @@ public:
 	 * @brief Calculate power 2 of quaternion norm.
 	 * @return power 2 of norm.
 	 */
-	component_type norm_pow2() const noexcept
+	constexpr component_type norm_pow2() const noexcept
 	{
 		return this->dot(*this);
 	}
@@ -440,10 +470,9 @@ public:
 	 * @brief Calculate quaternion norm.
 	 * @return quaternion norm.
 	 */
-	component_type norm() const noexcept
+	constexpr component_type norm() const noexcept
 	{
-		using std::sqrt;
-		return component_type(sqrt(this->norm_pow2()));
+		return component_type(math::sqrt(this->norm_pow2()));
 	}
 
 	/**
@@ -452,8 +481,14 @@ public:
 	 * If it is a quaternion of zero norm, then the result is undefined.
 	 * @return reference to this quaternion instance.
 	 */
-	quaternion& normalize() noexcept
+	constexpr quaternion& normalize() noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::normalize(this->data(), this->data());
+				return *this;
+			}
+		}
 		return (*this) /= this->norm();
 	}
 
@@ -464,7 +499,7 @@ public:
 	 *
 	 * @return inverted quaternion.
 	 */
-	quaternion inv() const noexcept
+	constexpr quaternion inv() const noexcept
 	{
 		return this->operator!() / this->norm_pow2();
 	}
@@ -477,7 +512,7 @@ public:
 	 *
 	 * @return inverted unit quaternion.
 	 */
-	quaternion inv_unit() const noexcept
+	constexpr quaternion inv_unit() const noexcept
 	{
 		return this->operator!();
 	}
@@ -487,7 +522,7 @@ public:
 	 *
 	 * @return reference to this quaternion.
 	 */
-	quaternion& invert() noexcept
+	constexpr quaternion& invert() noexcept
 	{
 		return this->operator=(this->inv());
 	}
@@ -498,7 +533,7 @@ public:
 	 *
 	 * @return reference to this quaternion.
 	 */
-	quaternion& invert_unit() noexcept
+	constexpr quaternion& invert_unit() noexcept
 	{
 		return this->operator=(this->inv_unit());
 	}
@@ -513,7 +548,7 @@ public:
 	 * @param angle - rotation angle.
 	 * @return Reference to this quaternion object.
 	 */
-	quaternion& set_rotation(
+	constexpr quaternion& set_rotation(
 		component_type axis_x,
 		component_type axis_y,
 		component_type axis_z,
@@ -531,7 +566,7 @@ public:
 	 * @param angle - rotation angle.
 	 * @return Reference to this quaternion object.
 	 */
-	quaternion& set_rotation(const vector<component_type, 3>& axis, component_type angle) noexcept;
+	constexpr quaternion& set_rotation(const vector<component_type, 3>& axis, component_type angle) noexcept;
 
 	/**
 	 * @brief Initialize rotation.
@@ -542,7 +577,7 @@ public:
 	 * @param rot - rotation vector.
 	 * @return Reference to this quaternion object.
 	 */
-	quaternion& set_rotation(const vector<component_type, 3>& rot) noexcept;
+	constexpr quaternion& set_rotation(const vector<component_type, 3>& rot) noexcept;
 
 	/**
 	 * @brief Convert this quaternion to 4x4 matrix.
@@ -550,13 +585,19 @@ public:
 	 * to a rotation matrix.
 	 * @return Rotation matrix.
 	 */
+#if CFG_CPP >= 20
+	template <size_t dimension>
+		requires(dimension == 3 || dimension == 4)
+	constexpr matrix<component_type, dimension, dimension> to_matrix() const noexcept;
+#else
 	template <size_t dimension>
-	matrix< //
+	constexpr matrix< //
 		std::enable_if_t<dimension == 3 || dimension == 4, component_type>,
 		dimension,
 		dimension //
 		>
 	to_matrix() const noexcept;
+#endif
 
 	/**
 	 * @brief Spherical linear interpolation.
@@ -617,6 +658,11 @@ public:
 		}
 
 		// Calculate the x, y, z and w values for the interpolated quaternion.
+		if constexpr (simd_kernels::enabled) {
+			quaternion ret;
+			simd_kernels::blend(this->data(), sc1, quat.data(), sc2 * sign, ret.data());
+			return ret;
+		}
 		return (*this) * sc1 + quat * (sc2 * sign);
 	}
 
@@ -631,7 +677,7 @@ public:
 	 * @param vec - vector to rotate.
 	 * @return delta vector between initial and rotated vectors.
 	 */
-	vector3<component_type> rotation_delta(const vector3<component_type>& vec) const
+	constexpr vector3<component_type> rotation_delta(const vector3<component_type>& vec) const
 	{
 		// assuming unit quaternion here
 		return (this->v.cross(vec) * this->s + this->v * vec * this->v - this->v.norm_pow2() * vec) * 2;
@@ -644,16 +690,17 @@ public:
 	 * @param vec - vector to rotate.
 	 * @return a vector rotated by this unit quaternion.
 	 */
-	vector3<component_type> rot(const vector3<component_type>& vec) const
+	constexpr vector3<component_type> rot(const vector3<component_type>& vec) const
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3<component_type> ret{};
+				simd_kernels::rot(this->data(), vec.data(), ret.data());
+				return ret;
+			}
+		}
 		return vec + this->rotation_delta(vec);
 	}
-
-	friend std::ostream& operator<<(std::ostream& s, const quaternion<component_type>& quat)
-	{
-		s << "(" << quat.x() << " " << quat.y() << " " << quat.z() << " " << quat.w() << ")";
-		return s;
-	}
 };
 
 } // namespace r4
@@ -663,13 +710,15 @@ public:
 namespace r4 {
 
 template <class component_type>
-constexpr quaternion<component_type>::quaternion(const vector<component_type, 3>& rot) noexcept
+constexpr quaternion<component_type>::quaternion(const vector<component_type, 3>& rot) noexcept :
+	v(0),
+	s(0)
 {
 	this->set_rotation(rot);
 }
 
 template <class component_type>
-quaternion<component_type>& quaternion<component_type>::set_rotation(const vector<component_type, 3>& rot) noexcept
+constexpr quaternion<component_type>& quaternion<component_type>::set_rotation(const vector<component_type, 3>& rot) noexcept
 {
 	component_type mag = rot.norm();
 	if (mag != 0) {
@@ -681,27 +730,44 @@ quaternion<component_type>& quaternion<component_type>::set_rotation(const vecto
 }
 
 template <class component_type>
-quaternion<component_type>& quaternion<component_type>::set_rotation(
+constexpr quaternion<component_type>& quaternion<component_type>::set_rotation(
 	const vector<component_type, 3>& axis,
 	component_type angle
 ) noexcept
 {
-	using std::sin;
-	using std::cos;
-	this->s = component_type(cos(angle / 2));
-	this->v = axis * component_type(sin(angle / 2));
+	this->s = component_type(math::cos(angle / 2));
+	this->v = axis * component_type(math::sin(angle / 2));
 	return *this;
 }
 
+#if CFG_CPP >= 20
+template <class component_type>
+template <size_t dimension>
+	requires(dimension == 3 || dimension == 4)
+constexpr matrix<component_type, dimension, dimension> quaternion<component_type>::to_matrix() const noexcept
+#else
 template <class component_type>
 template <size_t dimension>
-matrix<std::enable_if_t<dimension == 3 || dimension == 4, component_type>, dimension, dimension> quaternion<
+constexpr matrix<std::enable_if_t<dimension == 3 || dimension == 4, component_type>, dimension, dimension> quaternion<
 	component_type>::to_matrix() const noexcept
+#endif
 {
 	return matrix<component_type, dimension, dimension>(*this);
 }
 
 static_assert(sizeof(quaternion<float>) == sizeof(float) * 4, "size mismatch");
 static_assert(sizeof(quaternion<double>) == sizeof(double) * 4, "size mismatch");
+static_assert(std::is_standard_layout_v<quaternion<float>>, "quaternion<float> must be standard layout");
+
+} // namespace r4
+
+// The r4 library contains explicit instantiations of quaternions of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class quaternion<float>;
+extern template class quaternion<double>;
 
 } // namespace r4
+#endif
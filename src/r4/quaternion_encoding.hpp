@@ -0,0 +1,337 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "quaternion.hpp"
+#include "simd.hpp"
+
+namespace r4 {
+
+namespace quaternion_encoding_internal {
+
+// index of the largest component followed by codes of the other three components
+using codes = std::array<int32_t, 4>;
+
+// Quantization shared by the smallest three encodings.
+// The largest by magnitude component of a unit quaternion is restored from the other three,
+// which are in [-1/sqrt(2), 1/sqrt(2)] range and are stored as signed normalized integers of 'num_bits' bits.
+template <unsigned num_bits>
+struct smallest_three {
+	constexpr static float max_code = float((1 << (num_bits - 1)) - 1);
+
+	constexpr static float sqrt2 = 1.41421356f;
+
+	constexpr static uint32_t mask = (uint32_t(1) << num_bits) - 1;
+
+	static codes quantize(const quaternion<float>& q) noexcept
+	{
+		const std::array<float, 4> c = {q.x(), q.y(), q.z(), q.w()};
+
+		size_t largest = 0;
+		for (size_t i = 1; i != c.size(); ++i) {
+			using std::abs;
+			if (abs(c[i]) > abs(c[largest])) {
+				largest = i;
+			}
+		}
+
+		// q and -q represent the same rotation, so the sign is chosen to make the largest component positive
+		const float scale = c[largest] < 0 ? -sqrt2 : sqrt2;
+
+		codes ret{};
+		ret[0] = int32_t(largest);
+
+		auto dst = std::next(ret.begin());
+		for (size_t i = 0; i != c.size(); ++i) {
+			if (i == largest) {
+				continue;
+			}
+			*dst = int32_t(std::lround(std::clamp(c[i] * scale, -1.0f, 1.0f) * max_code));
+			++dst;
+		}
+
+		return ret;
+	}
+
+	// index and codes are converted to floats, the components are returned in (x, y, z, w) order
+	template <typename batch>
+	static void dequantize(
+		typename batch::register_type index,
+		typename batch::register_type a,
+		typename batch::register_type b,
+		typename batch::register_type c,
+		typename batch::register_type& x,
+		typename batch::register_type& y,
+		typename batch::register_type& z,
+		typename batch::register_type& w
+	) noexcept
+	{
+		using reg = typename batch::register_type;
+
+		const reg zero = batch::broadcast(0);
+		const reg scale = batch::broadcast(1 / (sqrt2 * max_code));
+
+		a = batch::mul(a, scale);
+		b = batch::mul(b, scale);
+		c = batch::mul(c, scale);
+
+		// the quantization errors may make the sum of squares exceed 1
+		reg l = batch::sub(batch::broadcast(1), batch::mul(a, a));
+		l = batch::sub(l, batch::mul(b, b));
+		l = batch::sub(l, batch::mul(c, c));
+		l = batch::sqrt(batch::max(zero, l));
+
+		auto is = [&](float i) {
+			return batch::equal(index, batch::broadcast(i));
+		};
+
+		x = batch::select(is(0), l, a);
+		y = batch::select(is(1), l, batch::select(is(0), a, b));
+		z = batch::select(is(2), l, batch::select(batch::less(index, batch::broadcast(2)), b, c));
+		w = batch::select(is(3), l, c);
+	}
+
+	// two's complement representation of negative values is truncated to 'num_bits' bits
+	static uint32_t to_bits(int32_t code) noexcept
+	{
+		return uint32_t(code) & mask;
+	}
+
+	// takes the lower 'num_bits' bits and sign extends
+	static int32_t from_bits(uint32_t bits) noexcept
+	{
+		constexpr unsigned shift = 32 - num_bits;
+		return int32_t(bits << shift) >> shift;
+	}
+};
+
+} // namespace quaternion_encoding_internal
+
+/**
+ * @brief Compact encodings of unit quaternions.
+ * The encodings are used as template arguments of r4::compress_quaternion(), r4::decompress_quaternion(),
+ * r4::compress_quaternions() and r4::decompress_quaternions() functions.
+ * Each encoding defines the encoded_type, i.e. the type of the compressed quaternion.
+ * The "smallest three" encodings store the index of the largest by magnitude component and the other three components.
+ * Since q and -q represent the same rotation, the quaternion is negated if needed to make the largest component positive,
+ * so it is restored as sqrt(1 - a^2 - b^2 - c^2). The decompressed quaternion is either the original one or its negation.
+ * The compressors expect unit quaternions, decompressors return unit quaternions.
+ * The error bounds are for the angle of rotation from the original quaternion to the decompressed one.
+ */
+namespace quaternion_encoding {
+
+/**
+ * @brief Smallest three components in 10 bits each, packed into 32-bit integer.
+ * The components are stored in two's complement form in bits [0:9], [10:19] and [20:29],
+ * the index of the largest component is in bits [30:31].
+ * 4 bytes per quaternion, the error is less than 0.3 degrees.
+ */
+struct smallest_three32 : public quaternion_encoding_internal::smallest_three<10> {
+	using encoded_type = uint32_t;
+
+	static encoded_type pack(const quaternion_encoding_internal::codes& c) noexcept
+	{
+		return to_bits(c[1]) | (to_bits(c[2]) << 10) | (to_bits(c[3]) << 20) | (uint32_t(c[0]) << 30);
+	}
+
+	static quaternion_encoding_internal::codes unpack(encoded_type e) noexcept
+	{
+		return {int32_t(e >> 30), from_bits(e), from_bits(e >> 10), from_bits(e >> 20)};
+	}
+};
+
+/**
+ * @brief Smallest three components in 15 bits each, stored in three 16-bit integers.
+ * Each component is stored in two's complement form in bits [0:14] of its integer,
+ * bit 15 of the first and the second integers hold the lower and the upper bits of the index of the largest component.
+ * 6 bytes per quaternion, the error is less than 0.01 degrees.
+ */
+struct smallest_three48 : public quaternion_encoding_internal::smallest_three<15> {
+	using encoded_type = std::array<uint16_t, 3>;
+
+	static encoded_type pack(const quaternion_encoding_internal::codes& c) noexcept
+	{
+		const auto index = uint32_t(c[0]);
+		return {
+			uint16_t(to_bits(c[1]) | ((index & 1) << 15)),
+			uint16_t(to_bits(c[2]) | ((index >> 1) << 15)),
+			uint16_t(to_bits(c[3]))
+		};
+	}
+
+	static quaternion_encoding_internal::codes unpack(const encoded_type& e) noexcept
+	{
+		return {int32_t((e[0] >> 15) | ((e[1] >> 15) << 1)), from_bits(e[0]), from_bits(e[1]), from_bits(e[2])};
+	}
+};
+
+} // namespace quaternion_encoding
+
+/**
+ * @brief Compress unit quaternion.
+ * @tparam encoding_type - one of the encodings from r4::quaternion_encoding namespace.
+ * @param q - unit quaternion to compress.
+ * @return Compressed quaternion.
+ */
+template <typename encoding_type>
+typename encoding_type::encoded_type compress_quaternion(const quaternion<float>& q) noexcept
+{
+	return encoding_type::pack(encoding_type::quantize(q));
+}
+
+/**
+ * @brief Compress array of unit quaternions.
+ * @tparam encoding_type - one of the encodings from r4::quaternion_encoding namespace.
+ * @param in - unit quaternions to compress.
+ * @param out - compressed quaternions, must be of the same size as the input span.
+ */
+template <typename encoding_type>
+void compress_quaternions(
+	utki::span<const quaternion<float>> in,
+	utki::span<typename encoding_type::encoded_type> out
+) noexcept
+{
+	ASSERT(in.size() == out.size())
+
+	std::transform(in.begin(), in.end(), out.begin(), [](const auto& q) {
+		return compress_quaternion<encoding_type>(q);
+	});
+}
+
+/**
+ * @brief Decompress unit quaternion.
+ * The result is same as of r4::decompress_quaternions() for the same compressed quaternion.
+ * @tparam encoding_type - one of the encodings from r4::quaternion_encoding namespace.
+ * @param e - compressed quaternion.
+ * @return Decompressed unit quaternion.
+ */
+template <typename encoding_type>
+quaternion<float> decompress_quaternion(const typename encoding_type::encoded_type& e) noexcept
+{
+	using batch = simd::batch<float>;
+	using reg = typename batch::register_type;
+
+	const auto c = encoding_type::unpack(e);
+
+	// all lanes hold the same quaternion, the codes are small enough to be converted to float exactly
+	reg x;
+	reg y;
+	reg z;
+	reg w;
+	encoding_type::template dequantize<batch>(
+		batch::broadcast(float(c[0])),
+		batch::broadcast(float(c[1])),
+		batch::broadcast(float(c[2])),
+		batch::broadcast(float(c[3])),
+		x,
+		y,
+		z,
+		w
+	);
+
+	alignas(sizeof(reg)) std::array<float, batch::width * 4> values{};
+	batch::store4(values.data(), x, y, z, w);
+
+	return {values[0], values[1], values[2], values[3]};
+}
+
+/**
+ * @brief Decompress array of unit quaternions.
+ * The quaternions are processed several at a time using SIMD, if available.
+ * The results are same as of r4::decompress_quaternion() for each compressed quaternion.
+ * @tparam encoding_type - one of the encodings from r4::quaternion_encoding namespace.
+ * @param in - compressed quaternions.
+ * @param out - decompressed unit quaternions, must be of the same size as the input span.
+ */
+template <typename encoding_type>
+void decompress_quaternions(
+	utki::span<const typename encoding_type::encoded_type> in,
+	utki::span<quaternion<float>> out
+) noexcept
+{
+	ASSERT(in.size() == out.size())
+
+	using batch = simd::batch<float>;
+	using reg = typename batch::register_type;
+	constexpr size_t width = batch::width;
+
+	// The codes of a block of quaternions are unpacked before loading them to registers,
+	// so that the loads do not wait for the recent narrow stores to the same memory.
+	constexpr size_t block_size = 64;
+	static_assert(block_size % width == 0, "block size must be multiple of batch width");
+
+	alignas(sizeof(reg)) std::array<std::array<int32_t, block_size>, 4> codes{};
+
+	size_t i = 0;
+	while (in.size() - i >= width) {
+		const size_t size = std::min(block_size, (in.size() - i) / width * width);
+
+		for (size_t l = 0; l != size; ++l) {
+			const auto c = encoding_type::unpack(in[i + l]);
+			for (size_t k = 0; k != c.size(); ++k) {
+				codes[k][l] = c[k];
+			}
+		}
+
+		for (size_t b = 0; b != size; b += width) {
+			reg x;
+			reg y;
+			reg z;
+			reg w;
+			encoding_type::template dequantize<batch>(
+				batch::load_int32(std::next(codes[0].data(), b)),
+				batch::load_int32(std::next(codes[1].data(), b)),
+				batch::load_int32(std::next(codes[2].data(), b)),
+				batch::load_int32(std::next(codes[3].data(), b)),
+				x,
+				y,
+				z,
+				w
+			);
+
+			// the quaternions are stored one after another in (x, y, z, w) order
+			batch::store4(&out[i + b].x(), x, y, z, w);
+		}
+
+		i += size;
+	}
+
+	for (; i != in.size(); ++i) {
+		out[i] = decompress_quaternion<encoding_type>(in[i]);
+	}
+}
+
+} // namespace r4
@@ -27,7 +27,6 @@ SOFTWARE.
 #pragma once
 
 #include <algorithm>
-#include <iostream>
 
 #include "segment2.hpp"
 #include "vector.hpp"
@@ -105,7 +104,7 @@ public:
 	 * @return true if two rectangles are equal, i.e. their origin points and dimensions are equal.
 	 * @return false otherwise.
 	 */
-	bool operator==(const rectangle& r) const noexcept
+	constexpr bool operator==(const rectangle& r) const noexcept
 	{
 		return this->p == r.p && this->d == r.d;
 	}
@@ -114,7 +113,7 @@ public:
 	 * @brief Get center point of the rectangle.
 	 * @return vector2 representing the center point of the rectangle.
 	 */
-	vector2<component_type> center() const noexcept
+	constexpr vector2<component_type> center() const noexcept
 	{
 		return this->p + this->d / 2;
 	}
@@ -124,7 +123,7 @@ public:
 	 * Move the rectangle so that its center point coincides with the given point.
 	 * @param new_center - new center point of the rectangle.
 	 */
-	void move_center_to(const vector2<component_type>& new_center) noexcept
+	constexpr void move_center_to(const vector2<component_type>& new_center) noexcept
 	{
 		this->p = new_center - this->d / 2;
 	}
@@ -135,7 +134,7 @@ public:
 	 * @return true if the rectangle overlaps the given point.
 	 * @return false otherwise.
 	 */
-	bool overlaps(const vector2<component_type>& point) const noexcept
+	constexpr bool overlaps(const vector2<component_type>& point) const noexcept
 	{
 		return point.x() >= this->p.x() && point.y() >= this->p.y() && point.x() < this->x2() && point.y() < this->y2();
 	}
@@ -147,7 +146,7 @@ public:
 	 * @return true if the rectangle fully contains the given rectangle.
 	 * @return false otherwise.
 	 */
-	bool contains(const rectangle& rect) const noexcept
+	constexpr bool contains(const rectangle& rect) const noexcept
 	{
 		auto this_x2y2 = this->x2_y2();
 		auto rect_x2y2 = rect.x2_y2();
@@ -167,7 +166,7 @@ public:
 	 * @param rect - rectangle to intersect this rectnagle with.
 	 * @return referenct to this rectangle.
 	 */
-	rectangle& intersect(const rectangle& rect) noexcept
+	constexpr rectangle& intersect(const rectangle& rect) noexcept
 	{
 		using std::min;
 		using std::max;
@@ -185,7 +184,7 @@ public:
 	 * @param rect - rectangle to get intersection with.
 	 * @return Intersection rectangle.
 	 */
-	rectangle intersection(const rectangle& rect) const noexcept
+	constexpr rectangle intersection(const rectangle& rect) const noexcept
 	{
 		return rectangle(*this).intersect(rect);
 	}
@@ -195,7 +194,7 @@ public:
 	 * @param rect - rectangle to unite this rectangle with.
 	 * @return reference to this rectangle.
 	 */
-	rectangle& unite(const rectangle& rect) noexcept
+	constexpr rectangle& unite(const rectangle& rect) noexcept
 	{
 		using std::min;
 		using std::max;
@@ -212,7 +211,7 @@ public:
 	 * @param rect - rectianlge to get union with.
 	 * @return Union of rectangles.
 	 */
-	rectangle union_rect(const rectangle& rect)
+	constexpr rectangle union_rect(const rectangle& rect)
 	{
 		return rectangle(*this).unite(rect);
 	}
@@ -221,7 +220,7 @@ public:
 	 * @brief Get point of the rectangle with maxium X and Y coordinates.
 	 * @return point of the rectangle with maximal X anf Y coordinates.
 	 */
-	vector2<component_type> x2_y2() const noexcept
+	constexpr vector2<component_type> x2_y2() const noexcept
 	{
 		return this->p + this->d;
 	}
@@ -230,7 +229,7 @@ public:
 	 * @brief Get point of the rectangle with minimal X and maximal Y coordinates.
 	 * @return point of the rectangle with minimal X and maximal Y coordinates.
 	 */
-	vector2<component_type> x1_y2() const noexcept
+	constexpr vector2<component_type> x1_y2() const noexcept
 	{
 		return vector2<component_type>(this->p.x(), this->y2());
 	}
@@ -239,7 +238,7 @@ public:
 	 * @brief Get maximal Y coordinate.
 	 * @return maximal Y coordinate of the rectangle's point.
 	 */
-	component_type y2() const noexcept
+	constexpr component_type y2() const noexcept
 	{
 		return this->p.y() + this->d.y();
 	}
@@ -248,7 +247,7 @@ public:
 	 * @brief Get x+width coordinate.
 	 * @return x+width coordinate of the rectangle.
 	 */
-	component_type x2() const noexcept
+	constexpr component_type x2() const noexcept
 	{
 		return this->p.x() + this->d.x();
 	}
@@ -257,7 +256,7 @@ public:
 	 * @brief Get point of the rectangle with maximal X and minimal Y coordinates.
 	 * @return point of the rectangle with maximal X and minimal Y coordinates.
 	 */
-	vector2<component_type> x2_y1() const noexcept
+	constexpr vector2<component_type> x2_y1() const noexcept
 	{
 		return vector2<component_type>(this->x2(), this->p.y());
 	}
@@ -270,7 +269,7 @@ public:
 	 * @return converted vector2.
 	 */
 	template <class another_component_type>
-	rectangle<another_component_type> to() const noexcept
+	constexpr rectangle<another_component_type> to() const noexcept
 	{
 		return rectangle<another_component_type>{
 			this->p.template to<another_component_type>(),
@@ -278,11 +277,63 @@ public:
 		};
 	}
 
-	friend std::ostream& operator<<(std::ostream& s, const rectangle<component_type>& rect)
+	/**
+	 * @brief Round components to nearest and convert to rectangle with different type of component.
+	 * Position and dimensions are rounded separately, see r4::vector::to_rounded().
+	 * @return converted rectangle.
+	 */
+	template <class another_component_type>
+	rectangle<another_component_type> to_rounded() const noexcept
+	{
+		return from_vector4(this->to_vector4().template to_rounded<another_component_type>());
+	}
+
+	/**
+	 * @brief Round components towards negative infinity and convert to rectangle with different type of component.
+	 * Position and dimensions are rounded separately, see r4::vector::to_floored().
+	 * @return converted rectangle.
+	 */
+	template <class another_component_type>
+	rectangle<another_component_type> to_floored() const noexcept
+	{
+		return from_vector4(this->to_vector4().template to_floored<another_component_type>());
+	}
+
+	/**
+	 * @brief Round components towards positive infinity and convert to rectangle with different type of component.
+	 * Position and dimensions are rounded separately, see r4::vector::to_ceiled().
+	 * @return converted rectangle.
+	 */
+	template <class another_component_type>
+	rectangle<another_component_type> to_ceiled() const noexcept
+	{
+		return from_vector4(this->to_vector4().template to_ceiled<another_component_type>());
+	}
+
+private:
+	// all 4 components are converted at once
+	vector4<component_type> to_vector4() const noexcept
+	{
+		return {this->p.x(), this->p.y(), this->d.x(), this->d.y()};
+	}
+
+	template <class another_component_type>
+	static rectangle<another_component_type> from_vector4(const vector4<another_component_type>& v) noexcept
 	{
-		s << "(" << rect.p << ")(" << rect.d << ")";
-		return s;
+		return {v.x(), v.y(), v.z(), v.w()};
 	}
 };
 
 } // namespace r4
+
+// The r4 library contains explicit instantiations of rectangles of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class rectangle<float>;
+extern template class rectangle<double>;
+extern template class rectangle<int>;
+
+} // namespace r4
+#endif
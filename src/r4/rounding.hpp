@@ -0,0 +1,195 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <type_traits>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "rectangle.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace r4 {
+
+namespace rounding_internal {
+
+enum class mode {
+	nearest,
+	down,
+	up
+};
+
+// pointers to the components of the vectors and rectangles, which are stored one after another without padding
+
+template <typename component_type, size_t dimension>
+const component_type* data(const vector<component_type, dimension>& v) noexcept
+{
+	return v.data();
+}
+
+template <typename component_type, size_t dimension>
+component_type* data(vector<component_type, dimension>& v) noexcept
+{
+	return v.data();
+}
+
+template <typename component_type>
+const component_type* data(const rectangle<component_type>& r) noexcept
+{
+	static_assert(sizeof(rectangle<component_type>) == sizeof(component_type) * 4, "rectangle has padding");
+	return r.p.data();
+}
+
+template <typename component_type>
+component_type* data(rectangle<component_type>& r) noexcept
+{
+	static_assert(sizeof(rectangle<component_type>) == sizeof(component_type) * 4, "rectangle has padding");
+	return r.p.data();
+}
+
+template <mode rounding_mode, typename to_type, typename from_type>
+auto convert_one(const from_type& v) noexcept
+{
+	if constexpr (rounding_mode == mode::nearest) {
+		return v.template to_rounded<to_type>();
+	} else if constexpr (rounding_mode == mode::down) {
+		return v.template to_floored<to_type>();
+	} else {
+		return v.template to_ceiled<to_type>();
+	}
+}
+
+// 'num_components' is number of components of a single element, i.e. of a vector or of a rectangle
+template <mode rounding_mode, size_t num_components, typename from_type, typename to_type>
+void convert(utki::span<const from_type> in, utki::span<to_type> out) noexcept
+{
+	ASSERT(in.size() == out.size())
+
+	using from_component_type = std::remove_const_t<std::remove_pointer_t<decltype(data(in.front()))>>;
+	using to_component_type = std::remove_pointer_t<decltype(data(out.front()))>;
+
+	// 4 elements are converted as a single vector, so that SIMD registers are filled with components
+	constexpr size_t group_size = 4;
+	using rounding_kernels =
+		simd::rounding_conversion_kernels<from_component_type, to_component_type, group_size * num_components>;
+
+	size_t i = 0;
+	if constexpr (rounding_kernels::enabled) {
+		for (; i + group_size <= in.size(); i += group_size) {
+			if constexpr (rounding_mode == mode::nearest) {
+				rounding_kernels::round(data(in[i]), data(out[i]));
+			} else if constexpr (rounding_mode == mode::down) {
+				rounding_kernels::floor(data(in[i]), data(out[i]));
+			} else {
+				rounding_kernels::ceil(data(in[i]), data(out[i]));
+			}
+		}
+	}
+
+	for (; i != in.size(); ++i) {
+		out[i] = convert_one<rounding_mode, to_component_type>(in[i]);
+	}
+}
+
+} // namespace rounding_internal
+
+/**
+ * @brief Round vector components to nearest and convert to vectors with different type of component.
+ * Same as r4::vector::to_rounded() for each vector, but processes several vectors at a time.
+ * @param in - vectors to convert.
+ * @param out - span to store converted vectors to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type, size_t dimension>
+void to_rounded(utki::span<const vector<from_type, dimension>> in, utki::span<vector<to_type, dimension>> out) noexcept
+{
+	rounding_internal::convert<rounding_internal::mode::nearest, dimension>(in, out);
+}
+
+/**
+ * @brief Round vector components towards negative infinity and convert to vectors with different type of component.
+ * Same as r4::vector::to_floored() for each vector, but processes several vectors at a time.
+ * @param in - vectors to convert.
+ * @param out - span to store converted vectors to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type, size_t dimension>
+void to_floored(utki::span<const vector<from_type, dimension>> in, utki::span<vector<to_type, dimension>> out) noexcept
+{
+	rounding_internal::convert<rounding_internal::mode::down, dimension>(in, out);
+}
+
+/**
+ * @brief Round vector components towards positive infinity and convert to vectors with different type of component.
+ * Same as r4::vector::to_ceiled() for each vector, but processes several vectors at a time.
+ * @param in - vectors to convert.
+ * @param out - span to store converted vectors to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type, size_t dimension>
+void to_ceiled(utki::span<const vector<from_type, dimension>> in, utki::span<vector<to_type, dimension>> out) noexcept
+{
+	rounding_internal::convert<rounding_internal::mode::up, dimension>(in, out);
+}
+
+/**
+ * @brief Round rectangle components to nearest and convert to rectangles with different type of component.
+ * Same as r4::rectangle::to_rounded() for each rectangle, but processes several rectangles at a time.
+ * @param in - rectangles to convert.
+ * @param out - span to store converted rectangles to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type>
+void to_rounded(utki::span<const rectangle<from_type>> in, utki::span<rectangle<to_type>> out) noexcept
+{
+	rounding_internal::convert<rounding_internal::mode::nearest, 4>(in, out);
+}
+
+/**
+ * @brief Round rectangle components towards negative infinity and convert to rectangles with different type of component.
+ * Same as r4::rectangle::to_floored() for each rectangle, but processes several rectangles at a time.
+ * @param in - rectangles to convert.
+ * @param out - span to store converted rectangles to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type>
+void to_floored(utki::span<const rectangle<from_type>> in, utki::span<rectangle<to_type>> out) noexcept
+{
+	rounding_internal::convert<rounding_internal::mode::down, 4>(in, out);
+}
+
+/**
+ * @brief Round rectangle components towards positive infinity and convert to rectangles with different type of component.
+ * Same as r4::rectangle::to_ceiled() for each rectangle, but processes several rectangles at a time.
+ * @param in - rectangles to convert.
+ * @param out - span to store converted rectangles to. Must have same size as the input span.
+ */
+template <typename from_type, typename to_type>
+void to_ceiled(utki::span<const rectangle<from_type>> in, utki::span<rectangle<to_type>> out) noexcept
+{
+	rounding_internal::convert<rounding_internal::mode::up, 4>(in, out);
+}
+
+} // namespace r4
@@ -61,7 +61,7 @@ public:
 	 * @brief Get (x1, y2) point.
 	 * @return (x1, y2) point.
 	 */
-	vector2<component_type> x1_y2() const noexcept
+	constexpr vector2<component_type> x1_y2() const noexcept
 	{
 		return {this->p1.x(), this->p2.y()};
 	}
@@ -70,7 +70,7 @@ public:
 	 * @brief Get (x2, y1) point.
 	 * @return (x2, y1) point.
 	 */
-	vector2<component_type> x2_y1() const noexcept
+	constexpr vector2<component_type> x2_y1() const noexcept
 	{
 		return {this->p2.x(), this->p1.y()};
 	}
@@ -79,7 +79,7 @@ public:
 	 * @brief Get x2 - x1.
 	 * @return x2 - x1.
 	 */
-	component_type dx() const noexcept
+	constexpr component_type dx() const noexcept
 	{
 		return this->p2.x() - this->p1.x();
 	}
@@ -88,7 +88,7 @@ public:
 	 * @brief Get y2 - y1.
 	 * @return y2 - y1.
 	 */
-	component_type dy() const noexcept
+	constexpr component_type dy() const noexcept
 	{
 		return this->p2.y() - this->p1.y();
 	}
@@ -97,7 +97,7 @@ public:
 	 * @brief Get (dx, dy) vector.
 	 * @return (dx, dy) vector.
 	 */
-	vector2<component_type> dx_dy() const noexcept
+	constexpr vector2<component_type> dx_dy() const noexcept
 	{
 		return this->p2 - this->p1;
 	}
@@ -106,7 +106,7 @@ public:
 	 * @brief Get minimal x coordinate.
 	 * @return Minimal x coordinate from the two segment points.
 	 */
-	component_type min_x() const noexcept
+	constexpr component_type min_x() const noexcept
 	{
 		using std::min;
 		return min(this->p1.x(), this->p2.x());
@@ -116,7 +116,7 @@ public:
 	 * @brief Get minimal y coordinate.
 	 * @return Minimal y coordinate from the two segment points.
 	 */
-	component_type min_y() const noexcept
+	constexpr component_type min_y() const noexcept
 	{
 		using std::min;
 		return min(this->p1.y(), this->p2.y());
@@ -126,7 +126,7 @@ public:
 	 * @brief Get maximal x coordinate.
 	 * @return Maximal x coordinate from the two segment points.
 	 */
-	component_type max_x() const noexcept
+	constexpr component_type max_x() const noexcept
 	{
 		using std::max;
 		return max(this->p1.x(), this->p2.x());
@@ -136,7 +136,7 @@ public:
 	 * @brief Get maximal y coordinate.
 	 * @return Maximal y coordinate from the two segment points.
 	 */
-	component_type max_y() const noexcept
+	constexpr component_type max_y() const noexcept
 	{
 		using std::max;
 		return max(this->p1.y(), this->p2.y());
@@ -146,7 +146,7 @@ public:
 	 * @brief Get width of the segment's bounding box.
 	 * @return horizontal distance from leftmost point to rightmost point. Always positive.
 	 */
-	component_type width() const noexcept
+	constexpr component_type width() const noexcept
 	{
 		// the underlying type can be unsigned, so do not use abs(dx)
 		if (this->p1.x() <= this->p2.x()) {
@@ -160,7 +160,7 @@ public:
 	 * @brief Get height of the segment's bounding box.
 	 * @return vertical distance from topmost point to bottommost point. Always positive.
 	 */
-	component_type height() const noexcept
+	constexpr component_type height() const noexcept
 	{
 		// the underlying type can be unsigned, so do not use abs(dy)
 		if (this->p1.y() <= this->p2.y()) {
@@ -174,7 +174,7 @@ public:
 	 * @brief Get dimensions of the segment's bounding box.
 	 * @return (width, height) vector. Always positive.
 	 */
-	vector2<component_type> dims() const noexcept
+	constexpr vector2<component_type> dims() const noexcept
 	{
 		using std::max;
 		return {this->width(), this->height()};
@@ -186,7 +186,7 @@ public:
 	 * minimal possible values of the value_type representing components of p1 and p2.
 	 * @return reference to this object.
 	 */
-	segment2& set_empty_bounding_box() noexcept
+	constexpr segment2& set_empty_bounding_box() noexcept
 	{
 		using std::numeric_limits;
 		using limits = numeric_limits<typename decltype(this->p1)::value_type>;
@@ -202,7 +202,7 @@ public:
 	 * @param seg - another segment to unite this one with.
 	 * @return reference to this object.
 	 */
-	segment2& unite(const segment2& seg) noexcept
+	constexpr segment2& unite(const segment2& seg) noexcept
 	{
 		using std::min;
 		using std::max;
@@ -215,3 +215,15 @@ public:
 };
 
 } // namespace r4
+
+// The r4 library contains explicit instantiations of segments of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class segment2<float>;
+extern template class segment2<double>;
+extern template class segment2<int>;
+
+} // namespace r4
+#endif
@@ -0,0 +1,1759 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include <utki/config.hpp>
+
+// SIMD instruction sets available at compile time.
+// Define R4_NO_SIMD to force the scalar implementation of all operations.
+#ifndef R4_NO_SIMD
+#	if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define R4_SIMD_SSE2
+#	endif
+#	if defined(__SSE4_1__) || (defined(_MSC_VER) && defined(__AVX__))
+#		define R4_SIMD_SSE4_1
+#	endif
+#	if defined(__AVX__)
+#		define R4_SIMD_AVX
+#	endif
+#	if defined(__AVX512F__)
+#		define R4_SIMD_AVX512
+#	endif
+// MSVC does not define a macro for F16C, all CPUs supporting AVX2 also support F16C
+#	if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#		define R4_SIMD_F16C
+#	endif
+#endif
+
+// The explicit instantiations in the r4 library are compiled with the default settings, i.e. with SIMD up to SSE2.
+// Inline functions compiled with other SIMD or debug settings would have different bodies for same symbols,
+// which violates the one definition rule.
+#if defined(R4_EXTERN_TEMPLATES) && \
+	(defined(R4_NO_SIMD) || defined(R4_DEBUG_FAST) || defined(R4_SIMD_SSE4_1) || defined(R4_SIMD_AVX))
+#	error "R4_EXTERN_TEMPLATES cannot be used with R4_NO_SIMD, R4_DEBUG_FAST or SSE4.1 and AVX instructions enabled"
+#endif
+
+#ifdef R4_SIMD_SSE2
+#	include <emmintrin.h>
+#endif
+#ifdef R4_SIMD_SSE4_1
+#	include <smmintrin.h>
+#endif
+#if defined(R4_SIMD_AVX) || defined(R4_SIMD_F16C)
+#	include <immintrin.h>
+#endif
+
+namespace r4::simd {
+
+/**
+ * @brief Check if the function is being evaluated in constant expression context.
+ * SIMD intrinsics cannot be used in constant expressions, so the accelerated code paths
+ * of constexpr functions are guarded by this check.
+ * @return true if called within constant expression evaluation.
+ * @return false otherwise.
+ */
+constexpr bool is_constant_evaluated() noexcept
+{
+#if CFG_CPP >= 20
+	return std::is_constant_evaluated();
+#elif CFG_COMPILER == CFG_COMPILER_GCC || CFG_COMPILER == CFG_COMPILER_CLANG || CFG_COMPILER == CFG_COMPILER_MSVC
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+}
+
+/**
+ * @brief Component-wise kernels for r4::vector.
+ * The generic template is not accelerated, r4::vector falls back to scalar implementation in that case.
+ * Specializations operate on pointers to vector components, which are not required to be aligned.
+ * @tparam component_type - vector component type.
+ * @tparam dimension - vector dimension.
+ */
+template <typename component_type, size_t dimension>
+struct vector_kernels {
+	constexpr static bool enabled = false;
+};
+
+#ifdef R4_SIMD_SSE2
+
+template <>
+struct vector_kernels<float, 4> {
+	constexpr static bool enabled = true;
+
+	static __m128 load(const float* p) noexcept
+	{
+		return _mm_loadu_ps(p);
+	}
+
+	static void store(float* p, __m128 v) noexcept
+	{
+		_mm_storeu_ps(p, v);
+	}
+
+	static __m128 sign_mask() noexcept
+	{
+		return _mm_set1_ps(-0.0f);
+	}
+
+	static void set(float* res, float num) noexcept
+	{
+		store(res, _mm_set1_ps(num));
+	}
+
+	static void add(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_add_ps(load(a), load(b)));
+	}
+
+	static void add(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm_add_ps(load(a), _mm_set1_ps(num)));
+	}
+
+	static void sub(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_sub_ps(load(a), load(b)));
+	}
+
+	static void mul(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_mul_ps(load(a), load(b)));
+	}
+
+	static void mul(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm_mul_ps(load(a), _mm_set1_ps(num)));
+	}
+
+	static void div(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_div_ps(load(a), load(b)));
+	}
+
+	static void div(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm_div_ps(load(a), _mm_set1_ps(num)));
+	}
+
+	static void negate(const float* a, float* res) noexcept
+	{
+		store(res, _mm_xor_ps(load(a), sign_mask()));
+	}
+
+	static void abs(const float* a, float* res) noexcept
+	{
+		store(res, _mm_andnot_ps(sign_mask(), load(a)));
+	}
+
+	// operands are swapped to get exactly the std::min() and std::max() semantics
+	// for equal values and NaNs, i.e. to return first argument in those cases
+
+	static void min(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_min_ps(load(b), load(a)));
+	}
+
+	static void max(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_max_ps(load(b), load(a)));
+	}
+
+	static float reduce_add(__m128 v) noexcept
+	{
+		// (x, y, z, w) + (y, x, w, z) = (x + y, x + y, z + w, z + w)
+		__m128 s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		// (x + y) + (z + w)
+		s = _mm_add_ss(s, _mm_movehl_ps(s, s));
+		return _mm_cvtss_f32(s);
+	}
+
+	static float reduce_min(__m128 v) noexcept
+	{
+		__m128 s = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		s = _mm_min_ss(s, _mm_movehl_ps(s, s));
+		return _mm_cvtss_f32(s);
+	}
+
+	static float reduce_max(__m128 v) noexcept
+	{
+		__m128 s = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		s = _mm_max_ss(s, _mm_movehl_ps(s, s));
+		return _mm_cvtss_f32(s);
+	}
+
+	static float dot(const float* a, const float* b) noexcept
+	{
+#	ifdef R4_SIMD_SSE4_1
+		return _mm_cvtss_f32(_mm_dp_ps(load(a), load(b), 0xf1));
+#	else
+		return reduce_add(_mm_mul_ps(load(a), load(b)));
+#	endif
+	}
+
+	static float sum(const float* a) noexcept
+	{
+		return reduce_add(load(a));
+	}
+
+	static float min_component(const float* a) noexcept
+	{
+		return reduce_min(load(a));
+	}
+
+	static float max_component(const float* a) noexcept
+	{
+		return reduce_max(load(a));
+	}
+
+#	ifdef R4_SIMD_SSE4_1
+	constexpr static bool has_rounding = true;
+
+	static void floor(const float* a, float* res) noexcept
+	{
+		store(res, _mm_floor_ps(load(a)));
+	}
+
+	static void ceil(const float* a, float* res) noexcept
+	{
+		store(res, _mm_ceil_ps(load(a)));
+	}
+#	else
+	constexpr static bool has_rounding = false;
+#	endif
+};
+
+#endif // ~R4_SIMD_SSE2
+
+#ifdef R4_SIMD_AVX
+
+template <>
+struct vector_kernels<double, 4> {
+	constexpr static bool enabled = true;
+
+	static __m256d load(const double* p) noexcept
+	{
+		return _mm256_loadu_pd(p);
+	}
+
+	static void store(double* p, __m256d v) noexcept
+	{
+		_mm256_storeu_pd(p, v);
+	}
+
+	static __m256d sign_mask() noexcept
+	{
+		return _mm256_set1_pd(-0.0);
+	}
+
+	static void set(double* res, double num) noexcept
+	{
+		store(res, _mm256_set1_pd(num));
+	}
+
+	static void add(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_add_pd(load(a), load(b)));
+	}
+
+	static void add(const double* a, double num, double* res) noexcept
+	{
+		store(res, _mm256_add_pd(load(a), _mm256_set1_pd(num)));
+	}
+
+	static void sub(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_sub_pd(load(a), load(b)));
+	}
+
+	static void mul(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_mul_pd(load(a), load(b)));
+	}
+
+	static void mul(const double* a, double num, double* res) noexcept
+	{
+		store(res, _mm256_mul_pd(load(a), _mm256_set1_pd(num)));
+	}
+
+	static void div(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_div_pd(load(a), load(b)));
+	}
+
+	static void div(const double* a, double num, double* res) noexcept
+	{
+		store(res, _mm256_div_pd(load(a), _mm256_set1_pd(num)));
+	}
+
+	static void negate(const double* a, double* res) noexcept
+	{
+		store(res, _mm256_xor_pd(load(a), sign_mask()));
+	}
+
+	static void abs(const double* a, double* res) noexcept
+	{
+		store(res, _mm256_andnot_pd(sign_mask(), load(a)));
+	}
+
+	// operands are swapped to get exactly the std::min() and std::max() semantics
+	// for equal values and NaNs, i.e. to return first argument in those cases
+
+	static void min(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_min_pd(load(b), load(a)));
+	}
+
+	static void max(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_max_pd(load(b), load(a)));
+	}
+
+	static double reduce_add(__m256d v) noexcept
+	{
+		// (x + z, y + w)
+		__m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		// (x + z) + (y + w)
+		s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+		return _mm_cvtsd_f64(s);
+	}
+
+	static double reduce_min(__m256d v) noexcept
+	{
+		__m128d s = _mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		s = _mm_min_sd(s, _mm_unpackhi_pd(s, s));
+		return _mm_cvtsd_f64(s);
+	}
+
+	static double reduce_max(__m256d v) noexcept
+	{
+		__m128d s = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		s = _mm_max_sd(s, _mm_unpackhi_pd(s, s));
+		return _mm_cvtsd_f64(s);
+	}
+
+	static double dot(const double* a, const double* b) noexcept
+	{
+		return reduce_add(_mm256_mul_pd(load(a), load(b)));
+	}
+
+	static double sum(const double* a) noexcept
+	{
+		return reduce_add(load(a));
+	}
+
+	static double min_component(const double* a) noexcept
+	{
+		return reduce_min(load(a));
+	}
+
+	static double max_component(const double* a) noexcept
+	{
+		return reduce_max(load(a));
+	}
+
+	constexpr static bool has_rounding = true;
+
+	static void floor(const double* a, double* res) noexcept
+	{
+		store(res, _mm256_floor_pd(load(a)));
+	}
+
+	static void ceil(const double* a, double* res) noexcept
+	{
+		store(res, _mm256_ceil_pd(load(a)));
+	}
+};
+
+// wide vectors, e.g. for feature descriptors or skinning weights
+
+template <>
+struct vector_kernels<float, 8> {
+	constexpr static bool enabled = true;
+
+	// Load as two 128-bit halves. Compilers copy 8 component vectors with 128-bit moves, and a 256-bit load
+	// from a just copied vector cannot be forwarded from the two stores, which stalls the pipeline.
+	static __m256 load(const float* p) noexcept
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(std::next(p, 4)), 1);
+	}
+
+	static void store(float* p, __m256 v) noexcept
+	{
+		_mm256_storeu_ps(p, v);
+	}
+
+	static __m256 sign_mask() noexcept
+	{
+		return _mm256_set1_ps(-0.0f);
+	}
+
+	static void set(float* res, float num) noexcept
+	{
+		store(res, _mm256_set1_ps(num));
+	}
+
+	static void add(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm256_add_ps(load(a), load(b)));
+	}
+
+	static void add(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm256_add_ps(load(a), _mm256_set1_ps(num)));
+	}
+
+	static void sub(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm256_sub_ps(load(a), load(b)));
+	}
+
+	static void mul(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm256_mul_ps(load(a), load(b)));
+	}
+
+	static void mul(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm256_mul_ps(load(a), _mm256_set1_ps(num)));
+	}
+
+	static void div(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm256_div_ps(load(a), load(b)));
+	}
+
+	static void div(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm256_div_ps(load(a), _mm256_set1_ps(num)));
+	}
+
+	static void negate(const float* a, float* res) noexcept
+	{
+		store(res, _mm256_xor_ps(load(a), sign_mask()));
+	}
+
+	static void abs(const float* a, float* res) noexcept
+	{
+		store(res, _mm256_andnot_ps(sign_mask(), load(a)));
+	}
+
+	// operands are swapped to get exactly the std::min() and std::max() semantics
+	// for equal values and NaNs, i.e. to return first argument in those cases
+
+	static void min(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm256_min_ps(load(b), load(a)));
+	}
+
+	static void max(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm256_max_ps(load(b), load(a)));
+	}
+
+	static float reduce_add(__m256 v) noexcept
+	{
+		// (0 + 4, 1 + 5, 2 + 6, 3 + 7)
+		__m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		// (0 + 4 + 2 + 6, 1 + 5 + 3 + 7)
+		s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(s);
+	}
+
+	static float reduce_min(__m256 v) noexcept
+	{
+		__m128 s = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		s = _mm_min_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_min_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(s);
+	}
+
+	static float reduce_max(__m256 v) noexcept
+	{
+		__m128 s = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		s = _mm_max_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_max_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(s);
+	}
+
+	static float dot(const float* a, const float* b) noexcept
+	{
+		return reduce_add(_mm256_mul_ps(load(a), load(b)));
+	}
+
+	static float sum(const float* a) noexcept
+	{
+		return reduce_add(load(a));
+	}
+
+	static float min_component(const float* a) noexcept
+	{
+		return reduce_min(load(a));
+	}
+
+	static float max_component(const float* a) noexcept
+	{
+		return reduce_max(load(a));
+	}
+
+	constexpr static bool has_rounding = true;
+
+	static void floor(const float* a, float* res) noexcept
+	{
+		store(res, _mm256_floor_ps(load(a)));
+	}
+
+	static void ceil(const float* a, float* res) noexcept
+	{
+		store(res, _mm256_ceil_ps(load(a)));
+	}
+};
+
+#	ifdef R4_SIMD_AVX512
+
+template <>
+struct vector_kernels<float, 16> {
+private:
+	// GCC 12 issues false -Wuninitialized warnings for some of the AVX-512 intrinsics which use
+	// _mm512_undefined_ps() internally, so masked forms of those with all lanes enabled are used instead
+	constexpr static __mmask16 all_lanes = 0xffff;
+
+	static __m512 swap_halves(__m512 v) noexcept
+	{
+		return _mm512_mask_shuffle_f32x4(v, all_lanes, v, v, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+
+	static __m512 swap_quarters(__m512 v) noexcept
+	{
+		return _mm512_mask_shuffle_f32x4(v, all_lanes, v, v, _MM_SHUFFLE(2, 3, 0, 1));
+	}
+
+	static __m512 swap_pairs(__m512 v) noexcept
+	{
+		return _mm512_mask_permute_ps(v, all_lanes, v, _MM_SHUFFLE(1, 0, 3, 2));
+	}
+
+	static __m512 swap_neighbours(__m512 v) noexcept
+	{
+		return _mm512_mask_permute_ps(v, all_lanes, v, _MM_SHUFFLE(2, 3, 0, 1));
+	}
+
+	static __m512 min(__m512 a, __m512 b) noexcept
+	{
+		return _mm512_mask_min_ps(a, all_lanes, a, b);
+	}
+
+	static __m512 max(__m512 a, __m512 b) noexcept
+	{
+		return _mm512_mask_max_ps(a, all_lanes, a, b);
+	}
+
+public:
+	constexpr static bool enabled = true;
+
+	static __m512 load(const float* p) noexcept
+	{
+		return _mm512_loadu_ps(p);
+	}
+
+	static void store(float* p, __m512 v) noexcept
+	{
+		_mm512_storeu_ps(p, v);
+	}
+
+	static void set(float* res, float num) noexcept
+	{
+		store(res, _mm512_set1_ps(num));
+	}
+
+	static void add(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm512_add_ps(load(a), load(b)));
+	}
+
+	static void add(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm512_add_ps(load(a), _mm512_set1_ps(num)));
+	}
+
+	static void sub(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm512_sub_ps(load(a), load(b)));
+	}
+
+	static void mul(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm512_mul_ps(load(a), load(b)));
+	}
+
+	static void mul(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm512_mul_ps(load(a), _mm512_set1_ps(num)));
+	}
+
+	static void div(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm512_div_ps(load(a), load(b)));
+	}
+
+	static void div(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm512_div_ps(load(a), _mm512_set1_ps(num)));
+	}
+
+	static void negate(const float* a, float* res) noexcept
+	{
+		// floating point xor needs AVX-512DQ, integer xor is in AVX-512F
+		store(
+			res,
+			_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(load(a)), _mm512_set1_epi32(int32_t(0x80000000))))
+		);
+	}
+
+	static void abs(const float* a, float* res) noexcept
+	{
+		store(res, _mm512_abs_ps(load(a)));
+	}
+
+	// operands are swapped to get exactly the std::min() and std::max() semantics
+	// for equal values and NaNs, i.e. to return first argument in those cases
+
+	static void min(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, min(load(b), load(a)));
+	}
+
+	static void max(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, max(load(b), load(a)));
+	}
+
+	static float reduce_add(__m512 v) noexcept
+	{
+		v = _mm512_add_ps(v, swap_halves(v));
+		v = _mm512_add_ps(v, swap_quarters(v));
+		v = _mm512_add_ps(v, swap_pairs(v));
+		v = _mm512_add_ps(v, swap_neighbours(v));
+		return _mm512_cvtss_f32(v);
+	}
+
+	static float reduce_min(__m512 v) noexcept
+	{
+		v = min(v, swap_halves(v));
+		v = min(v, swap_quarters(v));
+		v = min(v, swap_pairs(v));
+		v = min(v, swap_neighbours(v));
+		return _mm512_cvtss_f32(v);
+	}
+
+	static float reduce_max(__m512 v) noexcept
+	{
+		v = max(v, swap_halves(v));
+		v = max(v, swap_quarters(v));
+		v = max(v, swap_pairs(v));
+		v = max(v, swap_neighbours(v));
+		return _mm512_cvtss_f32(v);
+	}
+
+	static float dot(const float* a, const float* b) noexcept
+	{
+		return reduce_add(_mm512_mul_ps(load(a), load(b)));
+	}
+
+	static float sum(const float* a) noexcept
+	{
+		return reduce_add(load(a));
+	}
+
+	static float min_component(const float* a) noexcept
+	{
+		return reduce_min(load(a));
+	}
+
+	static float max_component(const float* a) noexcept
+	{
+		return reduce_max(load(a));
+	}
+
+	constexpr static bool has_rounding = true;
+
+	static void floor(const float* a, float* res) noexcept
+	{
+		__m512 v = load(a);
+		store(res, _mm512_mask_roundscale_ps(v, all_lanes, v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+	}
+
+	static void ceil(const float* a, float* res) noexcept
+	{
+		__m512 v = load(a);
+		store(res, _mm512_mask_roundscale_ps(v, all_lanes, v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+	}
+};
+
+#	else
+
+// 16 component vector as two 8 component halves
+template <>
+struct vector_kernels<float, 16> {
+private:
+	using half_kernels = vector_kernels<float, 8>;
+
+	constexpr static size_t half = 8;
+
+	static const float* high(const float* p) noexcept
+	{
+		return std::next(p, half);
+	}
+
+	static float* high(float* p) noexcept
+	{
+		return std::next(p, half);
+	}
+
+public:
+	constexpr static bool enabled = true;
+
+	static void set(float* res, float num) noexcept
+	{
+		half_kernels::set(res, num);
+		half_kernels::set(high(res), num);
+	}
+
+	static void add(const float* a, const float* b, float* res) noexcept
+	{
+		half_kernels::add(a, b, res);
+		half_kernels::add(high(a), high(b), high(res));
+	}
+
+	static void add(const float* a, float num, float* res) noexcept
+	{
+		half_kernels::add(a, num, res);
+		half_kernels::add(high(a), num, high(res));
+	}
+
+	static void sub(const float* a, const float* b, float* res) noexcept
+	{
+		half_kernels::sub(a, b, res);
+		half_kernels::sub(high(a), high(b), high(res));
+	}
+
+	static void mul(const float* a, const float* b, float* res) noexcept
+	{
+		half_kernels::mul(a, b, res);
+		half_kernels::mul(high(a), high(b), high(res));
+	}
+
+	static void mul(const float* a, float num, float* res) noexcept
+	{
+		half_kernels::mul(a, num, res);
+		half_kernels::mul(high(a), num, high(res));
+	}
+
+	static void div(const float* a, const float* b, float* res) noexcept
+	{
+		half_kernels::div(a, b, res);
+		half_kernels::div(high(a), high(b), high(res));
+	}
+
+	static void div(const float* a, float num, float* res) noexcept
+	{
+		half_kernels::div(a, num, res);
+		half_kernels::div(high(a), num, high(res));
+	}
+
+	static void negate(const float* a, float* res) noexcept
+	{
+		half_kernels::negate(a, res);
+		half_kernels::negate(high(a), high(res));
+	}
+
+	static void abs(const float* a, float* res) noexcept
+	{
+		half_kernels::abs(a, res);
+		half_kernels::abs(high(a), high(res));
+	}
+
+	static void min(const float* a, const float* b, float* res) noexcept
+	{
+		half_kernels::min(a, b, res);
+		half_kernels::min(high(a), high(b), high(res));
+	}
+
+	static void max(const float* a, const float* b, float* res) noexcept
+	{
+		half_kernels::max(a, b, res);
+		half_kernels::max(high(a), high(b), high(res));
+	}
+
+	static float dot(const float* a, const float* b) noexcept
+	{
+		return half_kernels::reduce_add(_mm256_add_ps(
+			_mm256_mul_ps(half_kernels::load(a), half_kernels::load(b)),
+			_mm256_mul_ps(half_kernels::load(high(a)), half_kernels::load(high(b)))
+		));
+	}
+
+	static float sum(const float* a) noexcept
+	{
+		return half_kernels::reduce_add(_mm256_add_ps(half_kernels::load(a), half_kernels::load(high(a))));
+	}
+
+	static float min_component(const float* a) noexcept
+	{
+		return half_kernels::reduce_min(_mm256_min_ps(half_kernels::load(a), half_kernels::load(high(a))));
+	}
+
+	static float max_component(const float* a) noexcept
+	{
+		return half_kernels::reduce_max(_mm256_max_ps(half_kernels::load(a), half_kernels::load(high(a))));
+	}
+
+	constexpr static bool has_rounding = true;
+
+	static void floor(const float* a, float* res) noexcept
+	{
+		half_kernels::floor(a, res);
+		half_kernels::floor(high(a), high(res));
+	}
+
+	static void ceil(const float* a, float* res) noexcept
+	{
+		half_kernels::ceil(a, res);
+		half_kernels::ceil(high(a), high(res));
+	}
+};
+
+#	endif // ~R4_SIMD_AVX512
+
+#endif // ~R4_SIMD_AVX
+
+/**
+ * @brief Component type conversion kernels for r4::vector::to().
+ * The generic template is not accelerated, r4::vector converts the components one by one in that case.
+ * Specializations are defined next to the component types they convert, e.g. in r4/half.hpp.
+ * @tparam from_type - source component type.
+ * @tparam to_type - destination component type.
+ * @tparam dimension - vector dimension.
+ */
+template <typename from_type, typename to_type, size_t dimension>
+struct conversion_kernels {
+	constexpr static bool enabled = false;
+};
+
+/**
+ * @brief Rounding conversion kernels for r4::vector::to_rounded(), to_floored() and to_ceiled().
+ * The generic template is not accelerated, r4::vector rounds and converts the components one by one in that case.
+ * round() rounds halfway cases away from zero, same as std::round().
+ * @tparam from_type - source component type.
+ * @tparam to_type - destination component type.
+ * @tparam dimension - vector dimension.
+ */
+template <typename from_type, typename to_type, size_t dimension>
+struct rounding_conversion_kernels {
+	constexpr static bool enabled = false;
+};
+
+#ifdef R4_SIMD_SSE2
+
+// The float components are truncated with cvttps2dq and then corrected by 1 where needed.
+// The fractional part a - trunc(a) is exact, so the results are same as of std::round(),
+// std::floor() and std::ceil() followed by conversion to int32_t.
+// cvtps2dq is not used for rounding to nearest since it rounds halfway cases to even.
+template <size_t dimension>
+struct rounding_conversion_kernels<float, int32_t, dimension> {
+private:
+	constexpr static size_t tail = dimension % 4;
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+
+	// load the last 1 to 3 components, the rest of the lanes are zero
+	static __m128 load_tail(const float* p) noexcept
+	{
+		if constexpr (tail == 1) {
+			return _mm_load_ss(p);
+		} else {
+			// load via __m128i pointer, which may alias any data, unlike double pointer
+			__m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+			if constexpr (tail == 2) {
+				return xy;
+			} else {
+				return _mm_movelh_ps(xy, _mm_load_ss(std::next(p, 2)));
+			}
+		}
+	}
+
+	static void store_tail(int32_t* p, __m128i v) noexcept
+	{
+		if constexpr (tail == 1) {
+			*p = _mm_cvtsi128_si32(v);
+		} else {
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(p), v);
+			if constexpr (tail == 3) {
+				*std::next(p, 2) = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+			}
+		}
+	}
+
+	template <typename operation_type>
+	static void convert(const float* in, int32_t* out, operation_type op) noexcept
+	{
+		size_t i = 0;
+		for (; i + 4 <= dimension; i += 4) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(std::next(out, i)), op(_mm_loadu_ps(std::next(in, i))));
+		}
+		if constexpr (tail != 0) {
+			store_tail(std::next(out, i), op(load_tail(std::next(in, i))));
+		}
+	}
+
+	// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+	static __m128i round4(__m128 a) noexcept
+	{
+		__m128i t = _mm_cvttps_epi32(a);
+		__m128 f = _mm_sub_ps(a, _mm_cvtepi32_ps(t));
+		// comparison masks are -1 in the lanes where the condition holds
+		__m128i up = _mm_castps_si128(_mm_cmpge_ps(f, _mm_set1_ps(0.5f)));
+		__m128i down = _mm_castps_si128(_mm_cmple_ps(f, _mm_set1_ps(-0.5f)));
+		return _mm_add_epi32(_mm_sub_epi32(t, up), down);
+	}
+
+	static __m128i floor4(__m128 a) noexcept
+	{
+		__m128i t = _mm_cvttps_epi32(a);
+		return _mm_add_epi32(t, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(t), a)));
+	}
+
+	static __m128i ceil4(__m128 a) noexcept
+	{
+		__m128i t = _mm_cvttps_epi32(a);
+		return _mm_sub_epi32(t, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(t), a)));
+	}
+
+public:
+	constexpr static bool enabled = true;
+
+	static void round(const float* in, int32_t* out) noexcept
+	{
+		convert(in, out, round4);
+	}
+
+	static void floor(const float* in, int32_t* out) noexcept
+	{
+		convert(in, out, floor4);
+	}
+
+	static void ceil(const float* in, int32_t* out) noexcept
+	{
+		convert(in, out, ceil4);
+	}
+};
+
+#endif // ~R4_SIMD_SSE2
+
+/**
+ * @brief Kernels for r4::vector3a.
+ * Same as 4 component vector kernels, but the 4th component is padding which
+ * does not take part in the dot and cross products.
+ * The 4th component of the results of other operations is unspecified.
+ * @tparam component_type - vector component type.
+ */
+template <typename component_type>
+struct vector3a_kernels {
+	constexpr static bool enabled = false;
+};
+
+#ifdef R4_SIMD_SSE2
+
+template <>
+struct vector3a_kernels<float> : public vector_kernels<float, 4> {
+private:
+	// (x, y, z, w) -> (y, z, x, w)
+	static __m128 yzx(__m128 v) noexcept
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	// the padding lane of the divisor is set to 1, so that the zero padding lane of the dividend
+	// gives 0 instead of 0/0, which is NaN and raises FE_INVALID floating point exception
+	static __m128 unit_padding(__m128 v) noexcept
+	{
+#	ifdef R4_SIMD_SSE4_1
+		return _mm_blend_ps(v, _mm_set1_ps(1), 0x8);
+#	else
+		return _mm_or_ps(_mm_and_ps(v, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))), _mm_set_ps(1, 0, 0, 0));
+#	endif
+	}
+
+public:
+	static void div(const float* a, const float* b, float* res) noexcept
+	{
+		store(res, _mm_div_ps(load(a), unit_padding(load(b))));
+	}
+
+	static void div(const float* a, float num, float* res) noexcept
+	{
+		store(res, _mm_div_ps(load(a), _mm_set_ps(1, num, num, num)));
+	}
+
+	static float dot(const float* a, const float* b) noexcept
+	{
+#	ifdef R4_SIMD_SSE4_1
+		return _mm_cvtss_f32(_mm_dp_ps(load(a), load(b), 0x71));
+#	else
+		__m128 m = _mm_mul_ps(load(a), load(b));
+		// (x + y) + z
+		__m128 s = _mm_add_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+		s = _mm_add_ss(s, _mm_movehl_ps(m, m));
+		return _mm_cvtss_f32(s);
+#	endif
+	}
+
+	static void cross(const float* a, const float* b, float* res) noexcept
+	{
+		__m128 va = load(a);
+		__m128 vb = load(b);
+		// a * b.yzx - a.yzx * b = (a x b).zxy
+		store(res, yzx(_mm_sub_ps(_mm_mul_ps(va, yzx(vb)), _mm_mul_ps(yzx(va), vb))));
+	}
+};
+
+#endif // ~R4_SIMD_SSE2
+
+#ifdef R4_SIMD_AVX
+
+template <>
+struct vector3a_kernels<double> : public vector_kernels<double, 4> {
+private:
+	// (x, y, z, w) -> (y, z, x, w)
+	static __m256d yzx(__m256d v) noexcept
+	{
+		// (z, y, x, w)
+		__m256d t = _mm256_blend_pd(v, _mm256_permute2f128_pd(v, v, 0x01), 0x5);
+		// swap the lower pair
+		return _mm256_permute_pd(t, 0x9);
+	}
+
+	// the padding lane of the divisor is set to 1 to avoid 0/0 in the padding lane, see vector3a_kernels<float>
+	static __m256d unit_padding(__m256d v) noexcept
+	{
+		return _mm256_blend_pd(v, _mm256_set1_pd(1), 0x8);
+	}
+
+public:
+	static void div(const double* a, const double* b, double* res) noexcept
+	{
+		store(res, _mm256_div_pd(load(a), unit_padding(load(b))));
+	}
+
+	static void div(const double* a, double num, double* res) noexcept
+	{
+		store(res, _mm256_div_pd(load(a), _mm256_set_pd(1, num, num, num)));
+	}
+
+	static double dot(const double* a, const double* b) noexcept
+	{
+		__m256d m = _mm256_mul_pd(load(a), load(b));
+		__m128d lo = _mm256_castpd256_pd128(m);
+		// (x + z) + y
+		__m128d s = _mm_add_sd(lo, _mm256_extractf128_pd(m, 1));
+		s = _mm_add_sd(s, _mm_unpackhi_pd(lo, lo));
+		return _mm_cvtsd_f64(s);
+	}
+
+	static void cross(const double* a, const double* b, double* res) noexcept
+	{
+		__m256d va = load(a);
+		__m256d vb = load(b);
+		// a * b.yzx - a.yzx * b = (a x b).zxy
+		store(res, yzx(_mm256_sub_pd(_mm256_mul_pd(va, yzx(vb)), _mm256_mul_pd(yzx(va), vb))));
+	}
+};
+
+#endif // ~R4_SIMD_AVX
+
+/**
+ * @brief Kernels for r4::matrix.
+ * The generic template is not accelerated, r4::matrix falls back to scalar implementation in that case.
+ * Specializations operate on pointers to row-major matrix elements, which are not required to be aligned.
+ * @tparam component_type - matrix element type.
+ * @tparam num_rows - number of matrix rows.
+ * @tparam num_columns - number of matrix columns.
+ */
+template <typename component_type, size_t num_rows, size_t num_columns>
+struct matrix_kernels {
+	constexpr static bool enabled = false;
+};
+
+#ifdef R4_SIMD_SSE2
+
+template <>
+struct matrix_kernels<float, 4, 4> {
+	constexpr static bool enabled = true;
+
+private:
+	template <int x, int y, int z, int w>
+	static __m128 swizzle(__m128 v) noexcept
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x));
+	}
+
+	// (a[x], a[y], b[z], b[w])
+	template <int x, int y, int z, int w>
+	static __m128 shuffle(__m128 a, __m128 b) noexcept
+	{
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+	}
+
+	// 2x2 matrices are stored in a register in row-major order: (m00, m01, m10, m11)
+
+	// A * B
+	static __m128 mat2_mul(__m128 a, __m128 b) noexcept
+	{
+		return _mm_add_ps(
+			_mm_mul_ps(a, swizzle<0, 3, 0, 3>(b)), //
+			_mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b))
+		);
+	}
+
+	// adj(A) * B
+	static __m128 mat2_adj_mul(__m128 a, __m128 b) noexcept
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b), //
+			_mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b))
+		);
+	}
+
+	// A * adj(B)
+	static __m128 mat2_mul_adj(__m128 a, __m128 b) noexcept
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)), //
+			_mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b))
+		);
+	}
+
+public:
+	/**
+	 * @brief Calculate inverse and determinant of 4x4 matrix.
+	 * Uses block-wise inversion, the matrix is split to four 2x2 blocks
+	 *     | A B |
+	 *     | C D |
+	 * and the inverse is expressed via adjugates and determinants of the blocks.
+	 * @param m - pointer to 16 elements of the matrix to invert.
+	 * @param res - pointer to 16 elements of the resulting inverse matrix.
+	 * @return determinant of the matrix.
+	 */
+	static float inv_det(const float* m, float* res) noexcept
+	{
+		const __m128 r0 = _mm_loadu_ps(m);
+		const __m128 r1 = _mm_loadu_ps(std::next(m, 4));
+		const __m128 r2 = _mm_loadu_ps(std::next(m, 8));
+		const __m128 r3 = _mm_loadu_ps(std::next(m, 12));
+
+		// 2x2 blocks
+		const __m128 a = _mm_movelh_ps(r0, r1);
+		const __m128 b = _mm_movehl_ps(r1, r0);
+		const __m128 c = _mm_movelh_ps(r2, r3);
+		const __m128 d = _mm_movehl_ps(r3, r2);
+
+		// determinants of the blocks as (|A|, |B|, |C|, |D|)
+		const __m128 det_sub = _mm_sub_ps(
+			_mm_mul_ps(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)),
+			_mm_mul_ps(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3))
+		);
+		const __m128 det_a = swizzle<0, 0, 0, 0>(det_sub);
+		const __m128 det_b = swizzle<1, 1, 1, 1>(det_sub);
+		const __m128 det_c = swizzle<2, 2, 2, 2>(det_sub);
+		const __m128 det_d = swizzle<3, 3, 3, 3>(det_sub);
+
+		// let M^-1 = 1 / |M| * | X Y |
+		//                      | Z W |
+
+		const __m128 d_c = mat2_adj_mul(d, c);
+		const __m128 a_b = mat2_adj_mul(a, b);
+
+		// adj(X) = |D| * A - B * (adj(D) * C)
+		__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_mul(b, d_c));
+		// adj(W) = |A| * D - C * (adj(A) * B)
+		__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_mul(c, a_b));
+		// adj(Y) = |B| * C - D * adj(adj(A) * B)
+		__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_mul_adj(d, a_b));
+		// adj(Z) = |C| * B - A * adj(adj(D) * C)
+		__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_mul_adj(a, d_c));
+
+		// |M| = |A| * |D| + |B| * |C| - tr((adj(A) * B) * (adj(D) * C))
+		__m128 tr = _mm_mul_ps(a_b, swizzle<0, 2, 1, 3>(d_c));
+		tr = _mm_add_ps(tr, swizzle<2, 3, 0, 1>(tr));
+		tr = _mm_add_ps(tr, swizzle<1, 0, 3, 2>(tr));
+		const __m128 det_m = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+
+		// divide by (|M|, -|M|, -|M|, |M|), the signs are needed for adjugate
+		const __m128 divisor = _mm_xor_ps(det_m, _mm_setr_ps(0.0f, -0.0f, -0.0f, 0.0f));
+
+		x = _mm_div_ps(x, divisor);
+		y = _mm_div_ps(y, divisor);
+		z = _mm_div_ps(z, divisor);
+		w = _mm_div_ps(w, divisor);
+
+		// finish taking adjugate of the blocks and store
+		_mm_storeu_ps(res, shuffle<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(std::next(res, 4), shuffle<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(std::next(res, 8), shuffle<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(std::next(res, 12), shuffle<2, 0, 2, 0>(z, w));
+
+		return _mm_cvtss_f32(det_m);
+	}
+};
+
+#endif // ~R4_SIMD_SSE2
+
+/**
+ * @brief Kernels for r4::quaternion.
+ * The generic template is not accelerated, r4::quaternion falls back to scalar implementation in that case.
+ * Specializations operate on pointers to quaternion components in (x, y, z, w) order,
+ * which is the memory layout of r4::quaternion, i.e. vector part followed by scalar part.
+ * Pointers are not required to be aligned.
+ * @tparam component_type - quaternion component type.
+ */
+template <typename component_type>
+struct quaternion_kernels {
+	constexpr static bool enabled = false;
+};
+
+#ifdef R4_SIMD_SSE2
+
+template <>
+struct quaternion_kernels<float> {
+	constexpr static bool enabled = true;
+
+private:
+	template <int x, int y, int z, int w>
+	static __m128 swizzle(__m128 v) noexcept
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x));
+	}
+
+	static __m128 load3(const float* p) noexcept
+	{
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p)), _mm_load_ss(std::next(p, 2)));
+	}
+
+	static void store3(float* p, __m128 v) noexcept
+	{
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+		_mm_store_ss(std::next(p, 2), _mm_movehl_ps(v, v));
+	}
+
+	// cross product of x, y, z lanes, w lane of the result is zero for finite inputs
+	static __m128 cross(__m128 a, __m128 b) noexcept
+	{
+		return _mm_sub_ps(
+			_mm_mul_ps(swizzle<1, 2, 0, 3>(a), swizzle<2, 0, 1, 3>(b)),
+			_mm_mul_ps(swizzle<2, 0, 1, 3>(a), swizzle<1, 2, 0, 3>(b))
+		);
+	}
+
+	static __m128 dot(__m128 a, __m128 b) noexcept
+	{
+#	ifdef R4_SIMD_SSE4_1
+		return _mm_dp_ps(a, b, 0xff);
+#	else
+		__m128 m = _mm_mul_ps(a, b);
+		m = _mm_add_ps(m, swizzle<1, 0, 3, 2>(m));
+		return _mm_add_ps(m, swizzle<2, 3, 0, 1>(m));
+#	endif
+	}
+
+public:
+	static float dot(const float* a, const float* b) noexcept
+	{
+		return _mm_cvtss_f32(dot(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+	}
+
+	// Hamilton product a * b
+	static void mul(const float* a, const float* b, float* res) noexcept
+	{
+		__m128 qa = _mm_loadu_ps(a);
+		__m128 qb = _mm_loadu_ps(b);
+
+		// res = aw * (bx, by, bz, bw)
+		//     + ax * (bw, -bz, by, -bx)
+		//     + ay * (bz, bw, -bx, -by)
+		//     + az * (-by, bx, bw, -bz)
+		__m128 r = _mm_mul_ps(swizzle<3, 3, 3, 3>(qa), qb);
+
+		__m128 t = _mm_mul_ps(swizzle<0, 0, 0, 0>(qa), swizzle<3, 2, 1, 0>(qb));
+		r = _mm_add_ps(r, _mm_xor_ps(t, _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f)));
+
+		t = _mm_mul_ps(swizzle<1, 1, 1, 1>(qa), swizzle<2, 3, 0, 1>(qb));
+		r = _mm_add_ps(r, _mm_xor_ps(t, _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f)));
+
+		t = _mm_mul_ps(swizzle<2, 2, 2, 2>(qa), swizzle<1, 0, 3, 2>(qb));
+		r = _mm_add_ps(r, _mm_xor_ps(t, _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f)));
+
+		_mm_storeu_ps(res, r);
+	}
+
+	// rotate 3d vector by unit quaternion
+	static void rot(const float* q, const float* vec, float* res) noexcept
+	{
+		__m128 qq = _mm_loadu_ps(q);
+		__m128 v = load3(vec);
+
+		// t = 2 * (q.v x v)
+		// res = v + q.s * t + q.v x t
+		__m128 t = cross(qq, v);
+		t = _mm_add_ps(t, t);
+
+		__m128 r = _mm_add_ps(v, _mm_mul_ps(swizzle<3, 3, 3, 3>(qq), t));
+		r = _mm_add_ps(r, cross(qq, t));
+
+		store3(res, r);
+	}
+
+	static void normalize(const float* q, float* res) noexcept
+	{
+		__m128 qq = _mm_loadu_ps(q);
+		_mm_storeu_ps(res, _mm_div_ps(qq, _mm_sqrt_ps(dot(qq, qq))));
+	}
+
+	// res = a * sa + b * sb
+	static void blend(const float* a, float sa, const float* b, float sb, float* res) noexcept
+	{
+		_mm_storeu_ps(
+			res,
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(sa)), _mm_mul_ps(_mm_loadu_ps(b), _mm_set1_ps(sb)))
+		);
+	}
+};
+
+#endif // ~R4_SIMD_SSE2
+
+/**
+ * @brief Operations on a batch of scalars packed into a SIMD register.
+ * Used by the bulk kernels which process several elements per iteration.
+ * The generic template is a single lane batch, i.e. plain scalar operations.
+ * Mask values are represented by a register_type with all bits set in the lanes
+ * where the condition holds (for the scalar batch it is just a bool).
+ * @tparam component_type - scalar type.
+ */
+template <typename component_type>
+struct batch {
+	using register_type = component_type;
+	using mask_type = bool;
+
+	constexpr static size_t width = 1;
+
+	static register_type load(const component_type* p) noexcept
+	{
+		return *p;
+	}
+
+	static register_type load_aligned(const component_type* p) noexcept
+	{
+		return *p;
+	}
+
+	static void store(component_type* p, register_type v) noexcept
+	{
+		*p = v;
+	}
+
+	static void store_aligned(component_type* p, register_type v) noexcept
+	{
+		*p = v;
+	}
+
+	static register_type broadcast(component_type v) noexcept
+	{
+		return v;
+	}
+
+	static register_type add(register_type a, register_type b) noexcept
+	{
+		return a + b;
+	}
+
+	static register_type sub(register_type a, register_type b) noexcept
+	{
+		return a - b;
+	}
+
+	static register_type mul(register_type a, register_type b) noexcept
+	{
+		return a * b;
+	}
+
+	static register_type div(register_type a, register_type b) noexcept
+	{
+		return a / b;
+	}
+
+	static register_type sqrt(register_type a) noexcept
+	{
+		using std::sqrt;
+		return register_type(sqrt(a));
+	}
+
+	static register_type min(register_type a, register_type b) noexcept
+	{
+		return b < a ? b : a;
+	}
+
+	static register_type max(register_type a, register_type b) noexcept
+	{
+		return a < b ? b : a;
+	}
+
+	static mask_type equal(register_type a, register_type b) noexcept
+	{
+		return a == b;
+	}
+
+	static mask_type less(register_type a, register_type b) noexcept
+	{
+		return a < b;
+	}
+
+	static register_type select(mask_type m, register_type a, register_type b) noexcept
+	{
+		return m ? a : b;
+	}
+
+	// The following operations are provided only by the batches of floats.
+
+	// load 'width' 3d vectors stored one after another, one register per vector component
+	static void load3(const component_type* p, register_type& x, register_type& y, register_type& z) noexcept
+	{
+		x = p[0];
+		y = p[1];
+		z = p[2];
+	}
+
+	// store 'width' 3d vectors one after another, reverse of load3()
+	static void store3(component_type* p, register_type x, register_type y, register_type z) noexcept
+	{
+		p[0] = x;
+		p[1] = y;
+		p[2] = z;
+	}
+
+	// store 'width' 4d vectors one after another, one register per vector component
+	static void store4(component_type* p, register_type x, register_type y, register_type z, register_type w) noexcept
+	{
+		p[0] = x;
+		p[1] = y;
+		p[2] = z;
+		p[3] = w;
+	}
+
+	// load and convert integers
+	static register_type load_int32(const int32_t* p) noexcept
+	{
+		return register_type(*p);
+	}
+
+	// convert to integers, rounding towards zero, and store
+	static void store_int32(int32_t* p, register_type v) noexcept
+	{
+		*p = int32_t(v);
+	}
+};
+
+#if defined(R4_SIMD_SSE2)
+
+namespace batch_internal {
+
+// 4 3d vectors are stored in 3 registers as
+//     a = (x0, y0, z0, x1), b = (y1, z1, x2, y2), c = (z2, x3, y3, z3)
+
+inline void load3(const float* p, __m128& x, __m128& y, __m128& z) noexcept
+{
+	__m128 a = _mm_loadu_ps(p);
+	__m128 b = _mm_loadu_ps(std::next(p, 4));
+	__m128 c = _mm_loadu_ps(std::next(p, 8));
+
+	// (b2, b2, c1, c1)
+	__m128 t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+	x = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+
+	// (a1, a1, b0, b0), (b3, b3, c2, c2)
+	y = _mm_shuffle_ps(
+		_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+		_mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+		_MM_SHUFFLE(2, 0, 2, 0)
+	);
+
+	// (a2, a2, b1, b1)
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+inline void store3(float* p, __m128 x, __m128 y, __m128 z) noexcept
+{
+	// (x0, y0, x1, y1), (x2, y2, x3, y3)
+	__m128 xy_lo = _mm_unpacklo_ps(x, y);
+	__m128 xy_hi = _mm_unpackhi_ps(x, y);
+
+	// (z0, z0, x1, x1)
+	__m128 a = _mm_shuffle_ps(xy_lo, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+
+	// (y1, y1, z1, z1)
+	__m128 b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy_hi, _MM_SHUFFLE(1, 0, 2, 0));
+
+	// (z2, z2, x3, x3), (y3, y3, z3, z3)
+	__m128 c = _mm_shuffle_ps(
+		_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+		_mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+		_MM_SHUFFLE(2, 0, 2, 0)
+	);
+
+	_mm_storeu_ps(p, a);
+	_mm_storeu_ps(std::next(p, 4), b);
+	_mm_storeu_ps(std::next(p, 8), c);
+}
+
+inline void store4(float* p, __m128 x, __m128 y, __m128 z, __m128 w) noexcept
+{
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	_mm_storeu_ps(p, x);
+	_mm_storeu_ps(std::next(p, 4), y);
+	_mm_storeu_ps(std::next(p, 8), z);
+	_mm_storeu_ps(std::next(p, 12), w);
+}
+
+} // namespace batch_internal
+
+#endif
+
+#if defined(R4_SIMD_AVX)
+
+template <>
+struct batch<float> {
+	using register_type = __m256;
+	using mask_type = __m256;
+
+	constexpr static size_t width = 8;
+
+	// clang-format off
+	static register_type load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+	static register_type load_aligned(const float* p) noexcept { return _mm256_load_ps(p); }
+	static void store(float* p, register_type v) noexcept { _mm256_storeu_ps(p, v); }
+	static void store_aligned(float* p, register_type v) noexcept { _mm256_store_ps(p, v); }
+	static register_type broadcast(float v) noexcept { return _mm256_set1_ps(v); }
+	static register_type add(register_type a, register_type b) noexcept { return _mm256_add_ps(a, b); }
+	static register_type sub(register_type a, register_type b) noexcept { return _mm256_sub_ps(a, b); }
+	static register_type mul(register_type a, register_type b) noexcept { return _mm256_mul_ps(a, b); }
+	static register_type div(register_type a, register_type b) noexcept { return _mm256_div_ps(a, b); }
+	static register_type sqrt(register_type a) noexcept { return _mm256_sqrt_ps(a); }
+	static register_type min(register_type a, register_type b) noexcept { return _mm256_min_ps(b, a); }
+	static register_type max(register_type a, register_type b) noexcept { return _mm256_max_ps(b, a); }
+	static mask_type equal(register_type a, register_type b) noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	static mask_type less(register_type a, register_type b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static register_type select(mask_type m, register_type a, register_type b) noexcept { return _mm256_blendv_ps(b, a, m); }
+	// clang-format on
+
+	static void load3(const float* p, register_type& x, register_type& y, register_type& z) noexcept
+	{
+		__m128 x_lo;
+		__m128 y_lo;
+		__m128 z_lo;
+		__m128 x_hi;
+		__m128 y_hi;
+		__m128 z_hi;
+		batch_internal::load3(p, x_lo, y_lo, z_lo);
+		batch_internal::load3(std::next(p, 12), x_hi, y_hi, z_hi);
+		x = _mm256_insertf128_ps(_mm256_castps128_ps256(x_lo), x_hi, 1);
+		y = _mm256_insertf128_ps(_mm256_castps128_ps256(y_lo), y_hi, 1);
+		z = _mm256_insertf128_ps(_mm256_castps128_ps256(z_lo), z_hi, 1);
+	}
+
+	static void store3(float* p, register_type x, register_type y, register_type z) noexcept
+	{
+		batch_internal::store3(p, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+		batch_internal::store3(
+			std::next(p, 12),
+			_mm256_extractf128_ps(x, 1),
+			_mm256_extractf128_ps(y, 1),
+			_mm256_extractf128_ps(z, 1)
+		);
+	}
+
+	static void store4(float* p, register_type x, register_type y, register_type z, register_type w) noexcept
+	{
+		batch_internal::store4(
+			p,
+			_mm256_castps256_ps128(x),
+			_mm256_castps256_ps128(y),
+			_mm256_castps256_ps128(z),
+			_mm256_castps256_ps128(w)
+		);
+		batch_internal::store4(
+			std::next(p, 16),
+			_mm256_extractf128_ps(x, 1),
+			_mm256_extractf128_ps(y, 1),
+			_mm256_extractf128_ps(z, 1),
+			_mm256_extractf128_ps(w, 1)
+		);
+	}
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+	static register_type load_int32(const int32_t* p) noexcept
+	{
+		return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+	}
+
+	static void store_int32(int32_t* p, register_type v) noexcept
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_cvttps_epi32(v));
+	}
+
+	// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+};
+
+template <>
+struct batch<double> {
+	using register_type = __m256d;
+	using mask_type = __m256d;
+
+	constexpr static size_t width = 4;
+
+	// clang-format off
+	static register_type load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+	static register_type load_aligned(const double* p) noexcept { return _mm256_load_pd(p); }
+	static void store(double* p, register_type v) noexcept { _mm256_storeu_pd(p, v); }
+	static void store_aligned(double* p, register_type v) noexcept { _mm256_store_pd(p, v); }
+	static register_type broadcast(double v) noexcept { return _mm256_set1_pd(v); }
+	static register_type add(register_type a, register_type b) noexcept { return _mm256_add_pd(a, b); }
+	static register_type sub(register_type a, register_type b) noexcept { return _mm256_sub_pd(a, b); }
+	static register_type mul(register_type a, register_type b) noexcept { return _mm256_mul_pd(a, b); }
+	static register_type div(register_type a, register_type b) noexcept { return _mm256_div_pd(a, b); }
+	static register_type sqrt(register_type a) noexcept { return _mm256_sqrt_pd(a); }
+	static register_type min(register_type a, register_type b) noexcept { return _mm256_min_pd(b, a); }
+	static register_type max(register_type a, register_type b) noexcept { return _mm256_max_pd(b, a); }
+	static mask_type equal(register_type a, register_type b) noexcept { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+	static mask_type less(register_type a, register_type b) noexcept { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	static register_type select(mask_type m, register_type a, register_type b) noexcept { return _mm256_blendv_pd(b, a, m); }
+	// clang-format on
+};
+
+#elif defined(R4_SIMD_SSE2)
+
+template <>
+struct batch<float> {
+	using register_type = __m128;
+	using mask_type = __m128;
+
+	constexpr static size_t width = 4;
+
+	// clang-format off
+	static register_type load(const float* p) noexcept { return _mm_loadu_ps(p); }
+	static register_type load_aligned(const float* p) noexcept { return _mm_load_ps(p); }
+	static void store(float* p, register_type v) noexcept { _mm_storeu_ps(p, v); }
+	static void store_aligned(float* p, register_type v) noexcept { _mm_store_ps(p, v); }
+	static register_type broadcast(float v) noexcept { return _mm_set1_ps(v); }
+	static register_type add(register_type a, register_type b) noexcept { return _mm_add_ps(a, b); }
+	static register_type sub(register_type a, register_type b) noexcept { return _mm_sub_ps(a, b); }
+	static register_type mul(register_type a, register_type b) noexcept { return _mm_mul_ps(a, b); }
+	static register_type div(register_type a, register_type b) noexcept { return _mm_div_ps(a, b); }
+	static register_type sqrt(register_type a) noexcept { return _mm_sqrt_ps(a); }
+	static register_type min(register_type a, register_type b) noexcept { return _mm_min_ps(b, a); }
+	static register_type max(register_type a, register_type b) noexcept { return _mm_max_ps(b, a); }
+	static mask_type equal(register_type a, register_type b) noexcept { return _mm_cmpeq_ps(a, b); }
+	static mask_type less(register_type a, register_type b) noexcept { return _mm_cmplt_ps(a, b); }
+	static register_type select(mask_type m, register_type a, register_type b) noexcept { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+	// clang-format on
+
+	static void load3(const float* p, register_type& x, register_type& y, register_type& z) noexcept
+	{
+		batch_internal::load3(p, x, y, z);
+	}
+
+	static void store3(float* p, register_type x, register_type y, register_type z) noexcept
+	{
+		batch_internal::store3(p, x, y, z);
+	}
+
+	static void store4(float* p, register_type x, register_type y, register_type z, register_type w) noexcept
+	{
+		batch_internal::store4(p, x, y, z, w);
+	}
+
+	// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+	static register_type load_int32(const int32_t* p) noexcept
+	{
+		return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+	}
+
+	static void store_int32(int32_t* p, register_type v) noexcept
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v));
+	}
+
+	// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+};
+
+template <>
+struct batch<double> {
+	using register_type = __m128d;
+	using mask_type = __m128d;
+
+	constexpr static size_t width = 2;
+
+	// clang-format off
+	static register_type load(const double* p) noexcept { return _mm_loadu_pd(p); }
+	static register_type load_aligned(const double* p) noexcept { return _mm_load_pd(p); }
+	static void store(double* p, register_type v) noexcept { _mm_storeu_pd(p, v); }
+	static void store_aligned(double* p, register_type v) noexcept { _mm_store_pd(p, v); }
+	static register_type broadcast(double v) noexcept { return _mm_set1_pd(v); }
+	static register_type add(register_type a, register_type b) noexcept { return _mm_add_pd(a, b); }
+	static register_type sub(register_type a, register_type b) noexcept { return _mm_sub_pd(a, b); }
+	static register_type mul(register_type a, register_type b) noexcept { return _mm_mul_pd(a, b); }
+	static register_type div(register_type a, register_type b) noexcept { return _mm_div_pd(a, b); }
+	static register_type sqrt(register_type a) noexcept { return _mm_sqrt_pd(a); }
+	static register_type min(register_type a, register_type b) noexcept { return _mm_min_pd(b, a); }
+	static register_type max(register_type a, register_type b) noexcept { return _mm_max_pd(b, a); }
+	static mask_type equal(register_type a, register_type b) noexcept { return _mm_cmpeq_pd(a, b); }
+	static mask_type less(register_type a, register_type b) noexcept { return _mm_cmplt_pd(a, b); }
+	static register_type select(mask_type m, register_type a, register_type b) noexcept { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+	// clang-format on
+};
+
+#endif
+
+} // namespace r4::simd
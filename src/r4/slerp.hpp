@@ -0,0 +1,235 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "quaternion.hpp"
+#include "simd.hpp"
+
+namespace r4 {
+
+/**
+ * @brief Accuracy mode of batched quaternion interpolation.
+ */
+enum class slerp_accuracy {
+	/**
+	 * @brief Spherical linear interpolation.
+	 * Same as quaternion::slerp(), which falls back to linear interpolation for very close quaternions.
+	 * Uses trigonometric functions, so it is the slowest mode.
+	 */
+	exact,
+
+	/**
+	 * @brief Normalized linear interpolation with corrected interpolation parameter.
+	 * The interpolation parameter is adjusted by a polynomial of t and cosine of the angle between
+	 * the quaternions, so that the result of nlerp follows slerp closely. No trigonometric functions are used.
+	 * The resulting quaternion deviates from the true slerp by less than 5e-4 (norm of the difference)
+	 * for any pair of unit quaternions.
+	 */
+	corrected_nlerp,
+
+	/**
+	 * @brief Normalized linear interpolation.
+	 * The result lies on the same arc as slerp, but the angular velocity is not constant.
+	 * The deviation from the true slerp grows with the angle between the quaternions, reaching about 0.075
+	 * (norm of the difference) for quaternions which are 180 degrees of rotation apart.
+	 */
+	nlerp
+};
+
+namespace slerp_internal {
+
+template <bool corrected, typename component_type>
+void nlerp(
+	utki::span<const quaternion<component_type>> a,
+	utki::span<const quaternion<component_type>> b,
+	utki::span<const component_type> t,
+	utki::span<quaternion<component_type>> out
+) noexcept
+{
+	using batch = simd::batch<component_type>;
+	using reg = typename batch::register_type;
+	constexpr size_t width = batch::width;
+
+	// Quaternions are stored as array of structures, so components of 'width' quaternions
+	// are gathered to the buffers to be loaded to SIMD registers, one register per component.
+	alignas(sizeof(reg)) std::array<std::array<component_type, width>, 4> qa{};
+	alignas(sizeof(reg)) std::array<std::array<component_type, width>, 4> qb{};
+	alignas(sizeof(reg)) std::array<component_type, width> tt{};
+
+	const reg zero = batch::broadcast(component_type(0));
+	const reg one = batch::broadcast(component_type(1));
+	const reg minus_one = batch::broadcast(component_type(-1));
+
+	for (size_t i = 0; i < a.size(); i += width) {
+		using std::min;
+		size_t count = min(width, a.size() - i);
+
+		for (size_t l = 0; l != width; ++l) {
+			if (l < count) {
+				const auto& p = a[i + l];
+				const auto& q = b[i + l];
+				for (size_t c = 0; c != 3; ++c) {
+					qa[c][l] = p.v[c];
+					qb[c][l] = q.v[c];
+				}
+				qa[3][l] = p.s;
+				qb[3][l] = q.s;
+				tt[l] = t[i + l];
+			} else {
+				// pad with identity quaternions
+				for (size_t c = 0; c != 3; ++c) {
+					qa[c][l] = component_type(0);
+					qb[c][l] = component_type(0);
+				}
+				qa[3][l] = component_type(1);
+				qb[3][l] = component_type(1);
+				tt[l] = component_type(0);
+			}
+		}
+
+		std::array<reg, 4> ra;
+		std::array<reg, 4> rb;
+		for (size_t c = 0; c != 4; ++c) {
+			ra[c] = batch::load_aligned(qa[c].data());
+			rb[c] = batch::load_aligned(qb[c].data());
+		}
+		reg rt = batch::load_aligned(tt.data());
+
+		// cosine of the angle between quaternions
+		reg d = batch::mul(ra[0], rb[0]);
+		for (size_t c = 1; c != 4; ++c) {
+			d = batch::add(d, batch::mul(ra[c], rb[c]));
+		}
+
+		// q and -q represent same rotation, take the shortest arc
+		reg sign = batch::select(batch::less(d, zero), minus_one, one);
+		d = batch::mul(d, sign);
+
+		if constexpr (corrected) {
+			// Correct the interpolation parameter by the polynomial fitted to minimize the
+			// difference from slerp, see "Approximating slerp" by A. Kapoulkine.
+			//     A = 1.0904 + d * (-3.2452 + d * (3.55645 - d * 1.43519))
+			//     B = 0.848013 + d * (-1.06021 + d * 0.215638)
+			//     k = A * (t - 0.5)^2 + B
+			//     t' = t + t * (t - 0.5) * (t - 1) * k
+			auto c = [](double v) {
+				return batch::broadcast(component_type(v));
+			};
+
+			reg ka = batch::add(c(3.55645), batch::mul(d, c(-1.43519)));
+			ka = batch::add(c(-3.2452), batch::mul(d, ka));
+			ka = batch::add(c(1.0904), batch::mul(d, ka));
+
+			reg kb = batch::add(c(-1.06021), batch::mul(d, c(0.215638)));
+			kb = batch::add(c(0.848013), batch::mul(d, kb));
+
+			reg th = batch::sub(rt, c(0.5));
+			reg k = batch::add(batch::mul(ka, batch::mul(th, th)), kb);
+
+			rt = batch::add(rt, batch::mul(batch::mul(rt, th), batch::mul(batch::sub(rt, one), k)));
+		}
+
+		reg sa = batch::sub(one, rt);
+		reg sb = batch::mul(rt, sign);
+
+		std::array<reg, 4> r;
+		for (size_t c = 0; c != 4; ++c) {
+			r[c] = batch::add(batch::mul(ra[c], sa), batch::mul(rb[c], sb));
+		}
+
+		reg n = batch::mul(r[0], r[0]);
+		for (size_t c = 1; c != 4; ++c) {
+			n = batch::add(n, batch::mul(r[c], r[c]));
+		}
+		n = batch::div(one, batch::sqrt(n));
+
+		for (size_t c = 0; c != 4; ++c) {
+			batch::store_aligned(qa[c].data(), batch::mul(r[c], n));
+		}
+
+		for (size_t l = 0; l != count; ++l) {
+			auto& o = out[i + l];
+			for (size_t c = 0; c != 3; ++c) {
+				o.v[c] = qa[c][l];
+			}
+			o.s = qa[3][l];
+		}
+	}
+}
+
+} // namespace slerp_internal
+
+/**
+ * @brief Interpolate arrays of unit quaternions.
+ * For each index i calculates interpolation between quaternions a[i] and b[i] with parameter t[i].
+ * The nlerp based modes are processed several quaternions at a time using SIMD, if available.
+ * All spans must be of the same size. The output span can be the same as one of the input spans.
+ * @param a - quaternions to interpolate from.
+ * @param b - quaternions to interpolate to.
+ * @param t - interpolation parameters, values from [0 : 1].
+ * @param out - resulting interpolated quaternions.
+ * @param accuracy - accuracy mode of the interpolation.
+ */
+template <typename component_type>
+void slerp(
+	utki::span<const quaternion<component_type>> a,
+	utki::span<const quaternion<component_type>> b,
+	utki::span<const component_type> t,
+	utki::span<quaternion<component_type>> out,
+	slerp_accuracy accuracy = slerp_accuracy::exact
+) noexcept
+{
+	static_assert(std::is_floating_point_v<component_type>, "only floating point quaternions are supported");
+
+	ASSERT(a.size() == b.size())
+	ASSERT(a.size() == t.size())
+	ASSERT(a.size() == out.size())
+
+	switch (accuracy) {
+		case slerp_accuracy::exact:
+			for (size_t i = 0; i != a.size(); ++i) {
+				out[i] = a[i].slerp(b[i], t[i]);
+			}
+			break;
+		case slerp_accuracy::corrected_nlerp:
+			slerp_internal::nlerp<true>(a, b, t, out);
+			break;
+		case slerp_accuracy::nlerp:
+			slerp_internal::nlerp<false>(a, b, t, out);
+			break;
+	}
+}
+
+} // namespace r4
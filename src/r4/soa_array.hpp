@@ -0,0 +1,636 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace r4 {
+
+/**
+ * @brief Structure-of-arrays container of vectors.
+ * Stores a sequence of vectors so that each vector component is stored in its own
+ * contiguous stream, i.e. all x components go first, then all y components and so on.
+ * Each stream is aligned to soa_array::alignment bytes. This layout allows processing
+ * of several vectors per iteration with SIMD instructions, see the batched operations.
+ * @tparam component_type - vector component type.
+ * @tparam dimension - vector dimension.
+ */
+template <typename component_type, size_t dimension>
+class soa_array
+{
+	static_assert(dimension > 0, "soa_array vector dimension must be above zero");
+	static_assert(std::is_trivially_copyable_v<component_type>, "soa_array component type must be trivially copyable");
+
+public:
+	using value_type = vector<component_type, dimension>;
+
+	/**
+	 * @brief Alignment of component streams in bytes.
+	 * Equals to typical cache line size, which is also enough for any SIMD register.
+	 */
+	constexpr static size_t alignment = 64;
+
+	static_assert(alignment % sizeof(component_type) == 0, "component size must be a divisor of stream alignment");
+
+private:
+	using batch = simd::batch<component_type>;
+
+	struct aligned_deleter {
+		void operator()(component_type* p) const noexcept
+		{
+			::operator delete(p, std::align_val_t(alignment));
+		}
+	};
+
+	std::unique_ptr<component_type[], aligned_deleter> buffer;
+
+	size_t num_elements = 0;
+
+	// number of components allocated for each stream,
+	// always a multiple of number of components fitting into the alignment
+	size_t stream_capacity = 0;
+
+	static size_t round_up_capacity(size_t size) noexcept
+	{
+		constexpr size_t granularity = alignment / sizeof(component_type);
+		return (size + granularity - 1) / granularity * granularity;
+	}
+
+	void reallocate(size_t new_capacity)
+	{
+		ASSERT(new_capacity % (alignment / sizeof(component_type)) == 0)
+		ASSERT(new_capacity >= this->num_elements)
+
+		decltype(this->buffer) new_buffer;
+		if (new_capacity != 0) {
+			new_buffer.reset(static_cast<component_type*>(
+				::operator new(new_capacity * dimension * sizeof(component_type), std::align_val_t(alignment))
+			));
+			// zero out the whole buffer, so that padding is always initialized
+			std::fill_n(new_buffer.get(), new_capacity * dimension, component_type(0));
+
+			for (size_t c = 0; c != dimension; ++c) {
+				std::copy_n(
+					std::next(this->buffer.get(), c * this->stream_capacity),
+					this->num_elements,
+					std::next(new_buffer.get(), c * new_capacity)
+				);
+			}
+		}
+
+		this->buffer = std::move(new_buffer);
+		this->stream_capacity = new_capacity;
+	}
+
+public:
+	/**
+	 * @brief Proxy reference to an element of the soa_array.
+	 * Since components of a single vector are not stored contiguously,
+	 * the elements cannot be accessed by a real reference. This proxy object
+	 * provides access to the element's components and converts to vector value.
+	 */
+	class reference
+	{
+		friend class soa_array;
+
+		soa_array& owner;
+		size_t index;
+
+		reference(soa_array& owner, size_t index) noexcept :
+			owner(owner),
+			index(index)
+		{}
+
+	public:
+		reference(const reference&) = default;
+		reference(reference&&) = default;
+
+		~reference() = default;
+
+		/**
+		 * @brief Get vector value of the element.
+		 * @return vector value.
+		 */
+		operator value_type() const noexcept
+		{
+			return this->owner.get(this->index);
+		}
+
+		/**
+		 * @brief Assign vector value to the element.
+		 * @param vec - vector value to assign.
+		 * @return reference to this proxy object.
+		 */
+		reference& operator=(const value_type& vec) noexcept
+		{
+			this->owner.set(this->index, vec);
+			return *this;
+		}
+
+		/**
+		 * @brief Assign value of another element.
+		 * @param r - proxy reference to the element to take the value from.
+		 * @return reference to this proxy object.
+		 */
+		reference& operator=(const reference& r) noexcept
+		{
+			return this->operator=(value_type(r));
+		}
+
+		reference& operator=(reference&& r) noexcept
+		{
+			return this->operator=(value_type(r));
+		}
+
+		/**
+		 * @brief Access element's component.
+		 * @param component - index of the component.
+		 * @return reference to the component.
+		 */
+		component_type& operator[](size_t component) const noexcept
+		{
+			return this->owner.stream(component)[this->index];
+		}
+	};
+
+	/**
+	 * @brief Create empty soa_array.
+	 */
+	soa_array() = default;
+
+	/**
+	 * @brief Create soa_array of given size.
+	 * All vectors are initialized to zero.
+	 * @param size - number of vectors in the array.
+	 */
+	explicit soa_array(size_t size)
+	{
+		this->resize(size);
+	}
+
+	/**
+	 * @brief Create soa_array from array of structures.
+	 * @param vecs - vectors to initialize the array with.
+	 */
+	explicit soa_array(utki::span<const value_type> vecs)
+	{
+		this->resize(vecs.size());
+		for (size_t i = 0; i != vecs.size(); ++i) {
+			this->set(i, vecs[i]);
+		}
+	}
+
+	soa_array(const soa_array& a)
+	{
+		this->reallocate(round_up_capacity(a.num_elements));
+		this->num_elements = a.num_elements;
+		for (size_t c = 0; c != dimension; ++c) {
+			auto s = a.stream(c);
+			std::copy(s.begin(), s.end(), this->stream(c).begin());
+		}
+	}
+
+	soa_array& operator=(const soa_array& a)
+	{
+		if (this == &a) {
+			return *this;
+		}
+		soa_array copy(a);
+		return this->operator=(std::move(copy));
+	}
+
+	soa_array(soa_array&& a) noexcept :
+		buffer(std::move(a.buffer)),
+		num_elements(a.num_elements),
+		stream_capacity(a.stream_capacity)
+	{
+		a.num_elements = 0;
+		a.stream_capacity = 0;
+	}
+
+	soa_array& operator=(soa_array&& a) noexcept
+	{
+		this->buffer = std::move(a.buffer);
+		this->num_elements = a.num_elements;
+		this->stream_capacity = a.stream_capacity;
+		a.num_elements = 0;
+		a.stream_capacity = 0;
+		return *this;
+	}
+
+	~soa_array() = default;
+
+	/**
+	 * @brief Get number of vectors in the array.
+	 * @return number of vectors.
+	 */
+	size_t size() const noexcept
+	{
+		return this->num_elements;
+	}
+
+	/**
+	 * @brief Check if the array is empty.
+	 * @return true if the array has no vectors.
+	 * @return false otherwise.
+	 */
+	bool empty() const noexcept
+	{
+		return this->num_elements == 0;
+	}
+
+	/**
+	 * @brief Get number of vectors the array can hold without reallocation.
+	 * @return capacity of the array.
+	 */
+	size_t capacity() const noexcept
+	{
+		return this->stream_capacity;
+	}
+
+	/**
+	 * @brief Reserve memory.
+	 * @param size - number of vectors to reserve memory for.
+	 */
+	void reserve(size_t size)
+	{
+		if (size <= this->stream_capacity) {
+			return;
+		}
+		this->reallocate(round_up_capacity(size));
+	}
+
+	/**
+	 * @brief Change size of the array.
+	 * Newly added vectors are initialized to zero.
+	 * @param size - new number of vectors in the array.
+	 */
+	void resize(size_t size)
+	{
+		if (size > this->stream_capacity) {
+			this->reallocate(round_up_capacity(size));
+		} else if (size < this->num_elements) {
+			this->num_elements = size;
+			this->zero_padding();
+		}
+		this->num_elements = size;
+	}
+
+	/**
+	 * @brief Add vector to the end of the array.
+	 * @param vec - vector to add.
+	 */
+	void push_back(const value_type& vec)
+	{
+		if (this->num_elements == this->stream_capacity) {
+			using std::max;
+			this->reallocate(round_up_capacity(max(this->stream_capacity * 2, size_t(1))));
+		}
+		++this->num_elements;
+		this->set(this->num_elements - 1, vec);
+	}
+
+	/**
+	 * @brief Get component stream.
+	 * @param component - index of the vector component.
+	 * @return span of values of the given component of all vectors. The span's data is aligned to soa_array::alignment.
+	 */
+	utki::span<component_type> stream(size_t component) noexcept
+	{
+		ASSERT(component < dimension)
+		return utki::make_span(std::next(this->buffer.get(), component * this->stream_capacity), this->num_elements);
+	}
+
+	/**
+	 * @brief Get component stream.
+	 * @param component - index of the vector component.
+	 * @return span of values of the given component of all vectors. The span's data is aligned to soa_array::alignment.
+	 */
+	utki::span<const component_type> stream(size_t component) const noexcept
+	{
+		ASSERT(component < dimension)
+		return utki::make_span(
+			static_cast<const component_type*>(std::next(this->buffer.get(), component * this->stream_capacity)),
+			this->num_elements
+		);
+	}
+
+	/**
+	 * @brief Get vector value.
+	 * @param index - index of the vector.
+	 * @return vector value.
+	 */
+	value_type get(size_t index) const noexcept
+	{
+		ASSERT(index < this->num_elements)
+		value_type ret;
+		for (size_t c = 0; c != dimension; ++c) {
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+			ret[c] = this->buffer[c * this->stream_capacity + index];
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief Set vector value.
+	 * @param index - index of the vector.
+	 * @param vec - vector value to set.
+	 */
+	void set(size_t index, const value_type& vec) noexcept
+	{
+		ASSERT(index < this->num_elements)
+		for (size_t c = 0; c != dimension; ++c) {
+			// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+			this->buffer[c * this->stream_capacity + index] = vec[c];
+		}
+	}
+
+	/**
+	 * @brief Access vector.
+	 * @param index - index of the vector.
+	 * @return proxy reference to the vector.
+	 */
+	reference operator[](size_t index) noexcept
+	{
+		ASSERT(index < this->num_elements)
+		return reference(*this, index);
+	}
+
+	/**
+	 * @brief Get vector value.
+	 * @param index - index of the vector.
+	 * @return vector value.
+	 */
+	value_type operator[](size_t index) const noexcept
+	{
+		return this->get(index);
+	}
+
+	/**
+	 * @brief Copy vectors to array of structures.
+	 * @param out - span to copy the vectors to. Must have same size as this array.
+	 */
+	void to_aos(utki::span<value_type> out) const noexcept
+	{
+		ASSERT(out.size() == this->num_elements)
+		for (size_t i = 0; i != this->num_elements; ++i) {
+			out[i] = this->get(i);
+		}
+	}
+
+	/**
+	 * @brief Unary component-wise operation.
+	 * Perform unary operation on each component of each vector.
+	 * The result is saved into this array.
+	 * @param op - unary operation to perform on each component.
+	 * @return Reference to this array.
+	 */
+	template <typename unary_operation_type>
+	soa_array& comp_operation(unary_operation_type op)
+	{
+		for (size_t c = 0; c != dimension; ++c) {
+			auto s = this->stream(c);
+			std::transform(s.begin(), s.end(), s.begin(), op);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Binary component-wise operation.
+	 * Perform binary operation on each component of vectors of two arrays.
+	 * The result is saved into this array.
+	 * @param a - second array. Must have same size as this array.
+	 * @param op - binary operation to perform on each component.
+	 * @return Reference to this array.
+	 */
+	template <typename binary_operation_type>
+	soa_array& comp_operation(const soa_array& a, binary_operation_type op)
+	{
+		ASSERT(a.size() == this->size())
+		for (size_t c = 0; c != dimension; ++c) {
+			auto s = this->stream(c);
+			std::transform(s.begin(), s.end(), a.stream(c).begin(), s.begin(), op);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Unary component-wise operation.
+	 * Perform unary operation on each component of each vector.
+	 * @param op - unary operation to perform on each component.
+	 * @return Resulting array.
+	 */
+	template <typename unary_operation_type>
+	soa_array comp_op(unary_operation_type op) const
+	{
+		return soa_array(*this).comp_operation(op);
+	}
+
+	/**
+	 * @brief Binary component-wise operation.
+	 * Perform binary operation on each component of vectors of two arrays.
+	 * @param a - second array. Must have same size as this array.
+	 * @param op - binary operation to perform on each component.
+	 * @return Resulting array.
+	 */
+	template <typename binary_operation_type>
+	soa_array comp_op(const soa_array& a, binary_operation_type op) const
+	{
+		return soa_array(*this).comp_operation(a, op);
+	}
+
+	/**
+	 * @brief Batched dot product.
+	 * Calculates dot products of corresponding vectors of this and given arrays.
+	 * @param a - array of vectors to multiply by. Must have same size as this array.
+	 * @param out - span to store the dot products to. Must have same size as this array.
+	 */
+	void dot(const soa_array& a, utki::span<component_type> out) const noexcept
+	{
+		ASSERT(a.size() == this->size())
+		ASSERT(out.size() == this->size())
+
+		const size_t num_batched = this->num_elements / batch::width * batch::width;
+
+		for (size_t i = 0; i != num_batched; i += batch::width) {
+			auto res = batch::mul(batch::load_aligned(this->component(0, i)), batch::load_aligned(a.component(0, i)));
+			for (size_t c = 1; c != dimension; ++c) {
+				res = batch::add(
+					res,
+					batch::mul(batch::load_aligned(this->component(c, i)), batch::load_aligned(a.component(c, i)))
+				);
+			}
+			batch::store(std::next(out.data(), i), res);
+		}
+
+		for (size_t i = num_batched; i != this->num_elements; ++i) {
+			auto res = *this->component(0, i) * *a.component(0, i);
+			for (size_t c = 1; c != dimension; ++c) {
+				res += *this->component(c, i) * *a.component(c, i);
+			}
+			out[i] = res;
+		}
+	}
+
+	/**
+	 * @brief Batched calculation of power 2 of vector norms.
+	 * @param out - span to store the results to. Must have same size as this array.
+	 */
+	void norm_pow2(utki::span<component_type> out) const noexcept
+	{
+		this->dot(*this, out);
+	}
+
+	/**
+	 * @brief Batched calculation of vector norms.
+	 * @param out - span to store the results to. Must have same size as this array.
+	 */
+	void norm(utki::span<component_type> out) const noexcept
+	{
+		this->norm_pow2(out);
+
+		const size_t num_batched = this->num_elements / batch::width * batch::width;
+
+		for (size_t i = 0; i != num_batched; i += batch::width) {
+			auto p = std::next(out.data(), i);
+			batch::store(p, batch::sqrt(batch::load(p)));
+		}
+
+		for (size_t i = num_batched; i != this->num_elements; ++i) {
+			using std::sqrt;
+			out[i] = component_type(sqrt(out[i]));
+		}
+	}
+
+	/**
+	 * @brief Normalize all vectors.
+	 * Same as calling vector::normalize() for each vector of the array.
+	 * @return Reference to this array.
+	 */
+	soa_array& normalize() noexcept
+	{
+		// the streams are padded up to multiple of alignment, so the whole
+		// stream can be processed in batches without scalar tail loop
+		const size_t num_batched = round_up_capacity(this->num_elements);
+
+		const auto zero = batch::broadcast(component_type(0));
+		const auto one = batch::broadcast(component_type(1));
+
+		for (size_t i = 0; i != num_batched; i += batch::width) {
+			auto np2 = batch::mul(batch::load_aligned(this->component(0, i)), batch::load_aligned(this->component(0, i)));
+			for (size_t c = 1; c != dimension; ++c) {
+				auto v = batch::load_aligned(this->component(c, i));
+				np2 = batch::add(np2, batch::mul(v, v));
+			}
+			auto mag = batch::sqrt(np2);
+			auto is_zero = batch::equal(mag, zero);
+
+			// divide zero vectors, including the padding, by 1 to avoid 0/0,
+			// which is a crash for integer components and NaN for floating point ones
+			auto divisor = batch::select(is_zero, one, mag);
+
+			// zero vectors become (1, 0, ...)
+			auto p = this->component(0, i);
+			batch::store_aligned(p, batch::select(is_zero, one, batch::div(batch::load_aligned(p), divisor)));
+			for (size_t c = 1; c != dimension; ++c) {
+				p = this->component(c, i);
+				batch::store_aligned(p, batch::select(is_zero, zero, batch::div(batch::load_aligned(p), divisor)));
+			}
+		}
+
+		this->zero_padding();
+
+		return *this;
+	}
+
+	/**
+	 * @brief Batched linear interpolation.
+	 * Sets each vector of this array to a + (b - a) * t, where a is this array's vector
+	 * and b is the corresponding vector of the given array.
+	 * @param a - array of vectors to interpolate to. Must have same size as this array.
+	 * @param t - interpolation parameter.
+	 * @return Reference to this array.
+	 */
+	soa_array& lerp(const soa_array& a, component_type t) noexcept
+	{
+		ASSERT(a.size() == this->size())
+
+		const size_t num_batched = round_up_capacity(this->num_elements);
+
+		const auto tt = batch::broadcast(t);
+
+		for (size_t c = 0; c != dimension; ++c) {
+			for (size_t i = 0; i != num_batched; i += batch::width) {
+				auto p = this->component(c, i);
+				auto v = batch::load_aligned(p);
+				batch::store_aligned(p, batch::add(v, batch::mul(batch::sub(batch::load_aligned(a.component(c, i)), v), tt)));
+			}
+		}
+
+		return *this;
+	}
+
+private:
+	void zero_padding() noexcept
+	{
+		for (size_t c = 0; c != dimension; ++c) {
+			std::fill(
+				this->component(c, this->num_elements),
+				this->component(c, this->stream_capacity),
+				component_type(0)
+			);
+		}
+	}
+
+	component_type* component(size_t component, size_t index) noexcept
+	{
+		return std::next(this->buffer.get(), component * this->stream_capacity + index);
+	}
+
+	const component_type* component(size_t component, size_t index) const noexcept
+	{
+		return std::next(this->buffer.get(), component * this->stream_capacity + index);
+	}
+};
+
+template <typename component_type>
+using soa_array2 = soa_array<component_type, 2>;
+template <typename component_type>
+using soa_array3 = soa_array<component_type, 3>;
+template <typename component_type>
+using soa_array4 = soa_array<component_type, 4>;
+
+} // namespace r4
@@ -0,0 +1,247 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+#pragma once
+
+#include <utki/debug.hpp>
+#include <utki/span.hpp>
+
+#include "matrix.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace r4 {
+
+namespace transform_internal {
+
+enum class kind {
+	point,
+	direction,
+	homogeneous
+};
+
+template <kind transform_kind, typename component_type>
+void transform_scalar(
+	const matrix4<component_type>& m,
+	utki::span<const vector3<component_type>> in,
+	utki::span<vector3<component_type>> out
+) noexcept
+{
+	// load the matrix once
+	const component_type m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
+	const component_type m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
+	const component_type m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
+	const component_type m30 = m[3][0], m31 = m[3][1], m32 = m[3][2], m33 = m[3][3];
+
+	auto o = out.begin();
+	for (const auto& v : in) {
+		// copy the input components, the input and output spans are allowed to be the same
+		const component_type x = v[0], y = v[1], z = v[2];
+
+		if constexpr (transform_kind == kind::direction) {
+			(*o)[0] = m00 * x + m01 * y + m02 * z;
+			(*o)[1] = m10 * x + m11 * y + m12 * z;
+			(*o)[2] = m20 * x + m21 * y + m22 * z;
+		} else {
+			component_type rx = m00 * x + m01 * y + m02 * z + m03;
+			component_type ry = m10 * x + m11 * y + m12 * z + m13;
+			component_type rz = m20 * x + m21 * y + m22 * z + m23;
+			if constexpr (transform_kind == kind::homogeneous) {
+				component_type rw = m30 * x + m31 * y + m32 * z + m33;
+				rx /= rw;
+				ry /= rw;
+				rz /= rw;
+			}
+			(*o)[0] = rx;
+			(*o)[1] = ry;
+			(*o)[2] = rz;
+		}
+		++o;
+	}
+}
+
+#ifdef R4_SIMD_SSE2
+template <kind transform_kind>
+void transform_sse(
+	const matrix4<float>& m,
+	utki::span<const vector3<float>> in,
+	utki::span<vector3<float>> out
+) noexcept
+{
+	// load matrix columns once
+	const __m128 c0 = _mm_setr_ps(m[0][0], m[1][0], m[2][0], m[3][0]);
+	const __m128 c1 = _mm_setr_ps(m[0][1], m[1][1], m[2][1], m[3][1]);
+	const __m128 c2 = _mm_setr_ps(m[0][2], m[1][2], m[2][2], m[3][2]);
+	const __m128 c3 = _mm_setr_ps(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+	auto o = out.begin();
+	for (const auto& v : in) {
+		// result = c0 * x + c1 * y + c2 * z (+ c3)
+		__m128 r = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])), _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+			_mm_mul_ps(c2, _mm_set1_ps(v[2]))
+		);
+		if constexpr (transform_kind != kind::direction) {
+			r = _mm_add_ps(r, c3);
+		}
+		if constexpr (transform_kind == kind::homogeneous) {
+			r = _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
+		}
+
+		// store only 3 components, not to overwrite next vector
+		float* p = o->data();
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		_mm_storel_pi(reinterpret_cast<__m64*>(p), r);
+		_mm_store_ss(std::next(p, 2), _mm_movehl_ps(r, r));
+		++o;
+	}
+}
+#endif
+
+#ifdef R4_SIMD_AVX
+template <kind transform_kind>
+void transform_avx(
+	const matrix4<double>& m,
+	utki::span<const vector3<double>> in,
+	utki::span<vector3<double>> out
+) noexcept
+{
+	// load matrix columns once
+	const __m256d c0 = _mm256_setr_pd(m[0][0], m[1][0], m[2][0], m[3][0]);
+	const __m256d c1 = _mm256_setr_pd(m[0][1], m[1][1], m[2][1], m[3][1]);
+	const __m256d c2 = _mm256_setr_pd(m[0][2], m[1][2], m[2][2], m[3][2]);
+	const __m256d c3 = _mm256_setr_pd(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+	auto o = out.begin();
+	for (const auto& v : in) {
+		// result = c0 * x + c1 * y + c2 * z (+ c3)
+		__m256d r = _mm256_add_pd(
+			_mm256_add_pd(_mm256_mul_pd(c0, _mm256_set1_pd(v[0])), _mm256_mul_pd(c1, _mm256_set1_pd(v[1]))),
+			_mm256_mul_pd(c2, _mm256_set1_pd(v[2]))
+		);
+		if constexpr (transform_kind != kind::direction) {
+			r = _mm256_add_pd(r, c3);
+		}
+		if constexpr (transform_kind == kind::homogeneous) {
+			// broadcast w: (y, y, w, w) -> (w, w, w, w)
+			__m256d w = _mm256_permute_pd(r, 0xf);
+			r = _mm256_div_pd(r, _mm256_permute2f128_pd(w, w, 0x11));
+		}
+
+		// store only 3 components, not to overwrite next vector
+		double* p = o->data();
+		__m128d lo = _mm256_castpd256_pd128(r);
+		_mm_storeu_pd(p, lo);
+		_mm_store_sd(std::next(p, 2), _mm256_extractf128_pd(r, 1));
+		++o;
+	}
+}
+#endif
+
+template <kind transform_kind, typename component_type>
+void transform(
+	const matrix4<component_type>& m,
+	utki::span<const vector3<component_type>> in,
+	utki::span<vector3<component_type>> out
+) noexcept
+{
+	ASSERT(in.size() == out.size())
+
+#ifdef R4_SIMD_SSE2
+	if constexpr (std::is_same_v<component_type, float>) {
+		transform_sse<transform_kind>(m, in, out);
+		return;
+	}
+#endif
+#ifdef R4_SIMD_AVX
+	if constexpr (std::is_same_v<component_type, double>) {
+		transform_avx<transform_kind>(m, in, out);
+		return;
+	}
+#endif
+	transform_scalar<transform_kind>(m, in, out);
+}
+
+} // namespace transform_internal
+
+/**
+ * @brief Transform points by matrix.
+ * Each point P is transformed as M * (P, 1), the 4th component of the result is discarded.
+ * I.e. this is same as matrix::operator*(vector3), but for a batch of points.
+ * The matrix is loaded once for the whole batch.
+ * @param m - transformation matrix.
+ * @param in - points to transform.
+ * @param out - span to store transformed points to. Must have same size as the input span.
+ *              Can be the same span as the input one.
+ */
+template <typename component_type>
+void transform_points(
+	const matrix4<component_type>& m,
+	utki::span<const vector3<component_type>> in,
+	utki::span<vector3<component_type>> out
+) noexcept
+{
+	transform_internal::transform<transform_internal::kind::point>(m, in, out);
+}
+
+/**
+ * @brief Transform directions by matrix.
+ * Each direction D is transformed as M * (D, 0), i.e. translation part of the matrix is not applied.
+ * The 4th component of the result is discarded.
+ * @param m - transformation matrix.
+ * @param in - directions to transform.
+ * @param out - span to store transformed directions to. Must have same size as the input span.
+ *              Can be the same span as the input one.
+ */
+template <typename component_type>
+void transform_directions(
+	const matrix4<component_type>& m,
+	utki::span<const vector3<component_type>> in,
+	utki::span<vector3<component_type>> out
+) noexcept
+{
+	transform_internal::transform<transform_internal::kind::direction>(m, in, out);
+}
+
+/**
+ * @brief Transform points by matrix with perspective divide.
+ * Each point P is transformed as R = M * (P, 1), then the result is (R.x / R.w, R.y / R.w, R.z / R.w).
+ * @param m - transformation matrix, e.g. a projection matrix.
+ * @param in - points to transform.
+ * @param out - span to store transformed points to. Must have same size as the input span.
+ *              Can be the same span as the input one.
+ */
+template <typename component_type>
+void transform_homogeneous(
+	const matrix4<component_type>& m,
+	utki::span<const vector3<component_type>> in,
+	utki::span<vector3<component_type>> out
+) noexcept
+{
+	transform_internal::transform<transform_internal::kind::homogeneous>(m, in, out);
+}
+
+} // namespace r4
@@ -32,6 +32,9 @@ SOFTWARE.
 #include <utki/debug.hpp>
 #include <utki/math.hpp>
 
+#include "math.hpp"
+#include "simd.hpp"
+
 // Under Windows and MSVC compiler there are 'min' and 'max' macros defined for some reason, get rid of them.
 #ifdef min
 #	undef min
@@ -58,6 +61,154 @@ class vector :
 {
 	static_assert(dimension > 0, "vector size template parameter dimension must be above zero");
 
+	// SIMD accelerated implementation of component-wise operations, if available for this vector type
+	using simd_kernels = simd::vector_kernels<component_type, dimension>;
+
+	// In R4_DEBUG_FAST mode the component-wise operations on 2, 3 and 4 component vectors are
+	// unrolled with index sequences and operate on raw component pointers, so that unoptimized builds
+	// do not pay for loops, functor calls and std::array::operator[] calls.
+#ifdef R4_DEBUG_FAST
+	constexpr static bool unroll = 2 <= dimension && dimension <= 4;
+#else
+	constexpr static bool unroll = false;
+#endif
+
+	using index_sequence = std::make_index_sequence<dimension>;
+
+	template <size_t... i>
+	constexpr vector& unrolled_add(const component_type* b, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] += b[i]), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_sub(const component_type* b, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] -= b[i]), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_mul(const component_type* b, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] *= b[i]), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_div(const component_type* b, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] /= b[i]), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_add(component_type num, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] += num), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_mul(component_type num, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] *= num), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_div(component_type num, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] /= num), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_set(component_type num, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] = num), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_negate(std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		if constexpr (std::is_signed_v<component_type>) {
+			((a[i] = -a[i]), ...);
+		} else {
+			((a[i] = component_type(component_type(0) - a[i])), ...);
+		}
+		return *this;
+	}
+
+	// same as std::min() and std::max(), i.e. returns first argument if the arguments are equivalent
+	template <size_t... i>
+	constexpr vector& unrolled_min(const component_type* b, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] = b[i] < a[i] ? b[i] : a[i]), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr vector& unrolled_max(const component_type* b, std::index_sequence<i...>) noexcept
+	{
+		component_type* a = this->data();
+		((a[i] = a[i] < b[i] ? b[i] : a[i]), ...);
+		return *this;
+	}
+
+	template <size_t... i>
+	constexpr component_type unrolled_dot(const component_type* b, std::index_sequence<i...>) const noexcept
+	{
+		const component_type* a = this->data();
+		return (... + (a[i] * b[i]));
+	}
+
+	template <size_t... i>
+	constexpr static std::array<component_type, dimension> filled(component_type num, std::index_sequence<i...>) noexcept
+	{
+		return {((void)i, num)...};
+	}
+
+	template <size_t another_dimension, size_t... i>
+	constexpr static std::array<component_type, dimension> resized(
+		const vector<component_type, another_dimension>& vec,
+		std::index_sequence<i...>
+	) noexcept
+	{
+		return {(i < another_dimension ? vec.data()[i] : component_type(0))...};
+	}
+
+	template <typename unary_operation_type, size_t... i>
+	constexpr auto comp_op(unary_operation_type& op, std::index_sequence<i...>) const
+	{
+		using result_type = vector<decltype(op(std::declval<component_type>())), dimension>;
+		return result_type{op((*this)[i])...};
+	}
+
+	template <typename binary_operation_type, size_t... i>
+	constexpr auto comp_op(const vector& vec, binary_operation_type& op, std::index_sequence<i...>) const
+	{
+		using result_type = vector<
+			decltype(op(
+				std::declval<component_type>(), //
+				std::declval<component_type>()
+			)), //
+			dimension>;
+		return result_type{op((*this)[i], vec[i])...};
+	}
+
 public:
 	using base_type = std::array<component_type, dimension>;
 
@@ -96,8 +247,13 @@ public:
 	/**
 	 * @brief Second vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type& y() noexcept
+		requires(dimension > 1)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 1), enable_type&> y() noexcept
+#endif
 	{
 		return this->operator[](1);
 	}
@@ -105,8 +261,13 @@ public:
 	/**
 	 * @brief Second vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr const component_type& y() const noexcept
+		requires(dimension > 1)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 1), const enable_type&> y() const noexcept
+#endif
 	{
 		return this->operator[](1);
 	}
@@ -114,8 +275,13 @@ public:
 	/**
 	 * @brief Second vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type& g() noexcept
+		requires(dimension > 1)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 1), enable_type&> g() noexcept
+#endif
 	{
 		return this->operator[](1);
 	}
@@ -123,8 +289,13 @@ public:
 	/**
 	 * @brief Second vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr const component_type& g() const noexcept
+		requires(dimension > 1)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 1), const enable_type&> g() const noexcept
+#endif
 	{
 		return this->operator[](1);
 	}
@@ -132,8 +303,13 @@ public:
 	/**
 	 * @brief Third vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type& z() noexcept
+		requires(dimension > 2)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 2), enable_type&> z() noexcept
+#endif
 	{
 		return this->operator[](2);
 	}
@@ -141,8 +317,13 @@ public:
 	/**
 	 * @brief Third vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr const component_type& z() const noexcept
+		requires(dimension > 2)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 2), const enable_type&> z() const noexcept
+#endif
 	{
 		return this->operator[](2);
 	}
@@ -150,8 +331,13 @@ public:
 	/**
 	 * @brief Third vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type& b() noexcept
+		requires(dimension > 2)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 2), enable_type&> b() noexcept
+#endif
 	{
 		return this->operator[](2);
 	}
@@ -159,8 +345,13 @@ public:
 	/**
 	 * @brief Third vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr const component_type& b() const noexcept
+		requires(dimension > 2)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 2), const enable_type&> b() const noexcept
+#endif
 	{
 		return this->operator[](2);
 	}
@@ -168,8 +359,13 @@ public:
 	/**
 	 * @brief Fourth vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type& w() noexcept
+		requires(dimension > 3)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 3), enable_type&> w() noexcept
+#endif
 	{
 		return this->operator[](3);
 	}
@@ -177,8 +373,13 @@ public:
 	/**
 	 * @brief Fourth vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr const component_type& w() const noexcept
+		requires(dimension > 3)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 3), const enable_type&> w() const noexcept
+#endif
 	{
 		return this->operator[](3);
 	}
@@ -186,8 +387,13 @@ public:
 	/**
 	 * @brief Fourth vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr component_type& a() noexcept
+		requires(dimension > 3)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 3), enable_type&> a() noexcept
+#endif
 	{
 		return this->operator[](3);
 	}
@@ -195,8 +401,13 @@ public:
 	/**
 	 * @brief Fourth vector component.
 	 */
+#if CFG_CPP >= 20
+	constexpr const component_type& a() const noexcept
+		requires(dimension > 3)
+#else
 	template <typename enable_type = component_type>
 	constexpr std::enable_if_t<(dimension > 3), const enable_type&> a() const noexcept
+#endif
 	{
 		return this->operator[](3);
 	}
@@ -213,12 +424,18 @@ public:
 	 * Initializes vector components to given values.
 	 * @param v - parameter pack with initializing values.
 	 */
+#if CFG_CPP >= 20
+	template <typename... arguments_type>
+		requires(sizeof...(arguments_type) == dimension)
+	constexpr vector(arguments_type... v) noexcept :
+#else
 	template <
 		typename... arguments_type, //
 		std::enable_if_t<
 			sizeof...(arguments_type) == dimension, //
 			bool> = true>
 	constexpr vector(arguments_type... v) noexcept :
+#endif
 		base_type{component_type(v)...}
 	{
 		static_assert(sizeof...(v) == dimension, "number of constructor arguments is not equal to vector size");
@@ -230,12 +447,9 @@ public:
 	 * Initializes all vector components to a given value.
 	 * @param num - value to initialize all vector compone with.
 	 */
-	constexpr vector(component_type num) noexcept
-	{
-		this->comp_operation([&num](const auto&) {
-			return num;
-		});
-	}
+	constexpr vector(component_type num) noexcept :
+		base_type(filled(num, index_sequence()))
+	{}
 
 	/**
 	 * @brief Constructor.
@@ -244,14 +458,17 @@ public:
 	 * @param num - value to use for initialization of first three vector components.
 	 * @param w - value to use for initialization of fourth vector component.
 	 */
+#if CFG_CPP >= 20
+	template <typename enable_type = component_type>
+		requires(dimension == 4)
+	constexpr vector(component_type num, component_type w) noexcept
+#else
 	template <typename enable_type = component_type>
 	constexpr vector(std::enable_if_t<dimension == 4, enable_type> num, component_type w) noexcept
-	{
-		std::for_each_n(this->begin(), dimension - 1, [&num](auto& a) {
-			a = num;
-		});
-		this->back() = w;
-	}
+#endif
+		:
+		vector(num, num, num, w)
+	{}
 
 	/**
 	 * @brief Constructor.
@@ -260,8 +477,14 @@ public:
 	 * @param vec - 2d vector to use for initialization of first two vector components.
 	 * @param z - value to use for initialization of 3rd vector component.
 	 */
+#if CFG_CPP >= 20
+	template <typename enable_type = component_type>
+		requires(dimension == 3)
+	constexpr vector(const vector<component_type, 2>& vec, component_type z = 0) noexcept
+#else
 	template <typename enable_type = component_type>
 	constexpr vector(const vector<component_type, 2>& vec, std::enable_if_t<dimension == 3, enable_type> z = 0) noexcept
+#endif
 		:
 		vector(vec.x(), vec.y(), z)
 	{}
@@ -273,10 +496,9 @@ public:
 	 * @param vec - vector to use for initialization of vector components.
 	 */
 	template <size_t another_dimension>
-	constexpr vector(const vector<component_type, another_dimension>& vec) noexcept
-	{
-		this->operator=(vec);
-	}
+	constexpr vector(const vector<component_type, another_dimension>& vec) noexcept :
+		base_type(resized(vec, index_sequence()))
+	{}
 
 	/**
 	 * @brief Constructor.
@@ -286,12 +508,18 @@ public:
 	 * @param z - value to use for initialization of 3rd vector component.
 	 * @param w - value to use for initialization of 4th vector component.
 	 */
+#if CFG_CPP >= 20
+	template <typename enable_type = component_type>
+		requires(dimension == 4)
+	constexpr vector(const vector<component_type, 2>& vec, component_type z = 0, component_type w = 0) noexcept :
+#else
 	template <typename enable_type = component_type>
 	constexpr vector(
 		const vector<component_type, 2>& vec,
 		std::enable_if_t<dimension == 4, enable_type> z = 0,
 		component_type w = 0
 	) noexcept :
+#endif
 		vector(vec.x(), vec.y(), z, w)
 	{}
 
@@ -302,8 +530,14 @@ public:
 	 * @param vec - 3d vector to use for initialization of first three vector components.
 	 * @param w - value to use for initialization of 4th vector component.
 	 */
+#if CFG_CPP >= 20
+	template <typename enable_type = component_type>
+		requires(dimension == 4)
+	constexpr vector(const vector<component_type, 3>& vec, component_type w = 0) noexcept
+#else
 	template <typename enable_type = component_type>
 	constexpr vector(const vector<component_type, 3>& vec, std::enable_if_t<dimension == 4, enable_type> w = 0) noexcept
+#endif
 		:
 		vector(vec.x(), vec.y(), vec.z(), w)
 	{}
@@ -313,16 +547,89 @@ public:
 	 * Convert this vector to a vector whose component type is different from component_type.
 	 * Components are converted using constructor of target type passing the source
 	 * component as argument of the target type constructor.
+	 * Some conversions, e.g. between float and r4::half, convert all components with SIMD instructions, if available.
 	 * @return converted vector.
 	 */
 	template <typename another_component_type>
-	vector<another_component_type, dimension> to() const noexcept
-	{
-		vector<another_component_type, dimension> ret;
-		std::transform(this->begin(), this->end(), ret.begin(), [](const auto& a) {
+	constexpr vector<another_component_type, dimension> to() const noexcept
+	{
+		using conversion_kernels = simd::conversion_kernels<component_type, another_component_type, dimension>;
+		if constexpr (conversion_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector<another_component_type, dimension> res{};
+				conversion_kernels::convert(this->data(), res.data());
+				return res;
+			}
+		}
+		return this->comp_op([](const auto& a) {
 			return another_component_type(a);
 		});
-		return ret;
+	}
+
+	/**
+	 * @brief Round components to nearest and convert to vector with different type of component.
+	 * Halfway cases are rounded away from zero, i.e. the result is same as of round(v).to<another_component_type>().
+	 * Conversion of float components to int is done with SIMD instructions, if available.
+	 * The rounded components must be representable by another_component_type.
+	 * @return converted vector.
+	 */
+	template <typename another_component_type>
+	vector<another_component_type, dimension> to_rounded() const noexcept
+	{
+		using rounding_kernels = simd::rounding_conversion_kernels<component_type, another_component_type, dimension>;
+		if constexpr (rounding_kernels::enabled) {
+			vector<another_component_type, dimension> res{};
+			rounding_kernels::round(this->data(), res.data());
+			return res;
+		}
+		return this->comp_op([](const auto& a) {
+			using std::round;
+			return another_component_type(round(a));
+		});
+	}
+
+	/**
+	 * @brief Round components towards negative infinity and convert to vector with different type of component.
+	 * The result is same as of floor(v).to<another_component_type>().
+	 * Conversion of float components to int is done with SIMD instructions, if available.
+	 * The rounded components must be representable by another_component_type.
+	 * @return converted vector.
+	 */
+	template <typename another_component_type>
+	vector<another_component_type, dimension> to_floored() const noexcept
+	{
+		using rounding_kernels = simd::rounding_conversion_kernels<component_type, another_component_type, dimension>;
+		if constexpr (rounding_kernels::enabled) {
+			vector<another_component_type, dimension> res{};
+			rounding_kernels::floor(this->data(), res.data());
+			return res;
+		}
+		return this->comp_op([](const auto& a) {
+			using std::floor;
+			return another_component_type(floor(a));
+		});
+	}
+
+	/**
+	 * @brief Round components towards positive infinity and convert to vector with different type of component.
+	 * The result is same as of ceil(v).to<another_component_type>().
+	 * Conversion of float components to int is done with SIMD instructions, if available.
+	 * The rounded components must be representable by another_component_type.
+	 * @return converted vector.
+	 */
+	template <typename another_component_type>
+	vector<another_component_type, dimension> to_ceiled() const noexcept
+	{
+		using rounding_kernels = simd::rounding_conversion_kernels<component_type, another_component_type, dimension>;
+		if constexpr (rounding_kernels::enabled) {
+			vector<another_component_type, dimension> res{};
+			rounding_kernels::ceil(this->data(), res.data());
+			return res;
+		}
+		return this->comp_op([](const auto& a) {
+			using std::ceil;
+			return another_component_type(ceil(a));
+		});
 	}
 
 	/**
@@ -332,22 +639,12 @@ public:
 	 * @return Resulting vector.
 	 */
 	template <typename unary_operation_type>
-	auto comp_op(unary_operation_type op) const //
+	constexpr auto comp_op(unary_operation_type op) const //
 		-> vector<
 			decltype(op(std::declval<component_type>())), //
 			dimension>
 	{
-		vector<
-			decltype(op(std::declval<component_type>())), //
-			dimension>
-			res{};
-		std::transform(
-			this->begin(), //
-			this->end(),
-			res.begin(),
-			op
-		);
-		return res;
+		return this->comp_op(op, index_sequence());
 	}
 
 	/**
@@ -358,7 +655,7 @@ public:
 	 * @return Resulting vector.
 	 */
 	template <typename binary_operation_type>
-	auto comp_op(
+	constexpr auto comp_op(
 		const vector& vec, //
 		binary_operation_type op
 	) const
@@ -369,21 +666,7 @@ public:
 			)), //
 			dimension>
 	{
-		vector<
-			decltype(op(
-				std::declval<component_type>(), //
-				std::declval<component_type>()
-			)), //
-			dimension>
-			res{};
-		std::transform(
-			this->begin(), //
-			this->end(),
-			vec.begin(),
-			res.begin(),
-			op
-		);
-		return res;
+		return this->comp_op(vec, op, index_sequence());
 	}
 
 	/**
@@ -396,12 +679,9 @@ public:
 	template <typename unary_operation_type>
 	constexpr vector& comp_operation(unary_operation_type op)
 	{
-		std::transform(
-			this->begin(), //
-			this->end(),
-			this->begin(),
-			op
-		);
+		for (auto& c : *this) {
+			c = op(c);
+		}
 		return *this;
 	}
 
@@ -419,16 +699,41 @@ public:
 		binary_operation_type op
 	)
 	{
-		std::transform(
-			this->begin(), //
-			this->end(),
-			vec.begin(),
-			this->begin(),
-			op
-		);
+		for (size_t i = 0; i != dimension; ++i) {
+			(*this)[i] = op((*this)[i], vec[i]);
+		}
 		return *this;
 	}
 
+	/**
+	 * @brief Check vectors for equality.
+	 * Unlike the std::array comparison operator, which is constexpr only since C++20,
+	 * this one can be used in constant expressions also in C++17.
+	 * @param vec - vector to compare this vector to.
+	 * @return true if all components of this vector are equal to the corresponding components of given vector.
+	 * @return false otherwise.
+	 */
+	constexpr bool operator==(const vector& vec) const noexcept
+	{
+		for (size_t i = 0; i != dimension; ++i) {
+			if ((*this)[i] != vec[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Check vectors for inequality.
+	 * @param vec - vector to compare this vector to.
+	 * @return true if at least one component of this vector differs from the corresponding component of given vector.
+	 * @return false otherwise.
+	 */
+	constexpr bool operator!=(const vector& vec) const noexcept
+	{
+		return !this->operator==(vec);
+	}
+
 	/**
 	 * @brief Assign from another vector.
 	 * TODO:
@@ -436,36 +741,9 @@ public:
 	 * @return Reference to this vector object.
 	 */
 	template <size_t another_dimension>
-	vector& operator=(const vector<component_type, another_dimension>& vec) noexcept
-	{
-		if constexpr (another_dimension >= dimension) {
-			std::transform( //
-				this->begin(),
-				this->end(),
-				vec.begin(),
-				this->begin(),
-				[](const auto& /* a */, const auto& b) {
-					return b;
-				}
-			);
-		} else {
-			static_assert(
-				another_dimension < dimension,
-				"dimension of another vector cannot be greater than of this vector"
-			);
-			auto i = std::transform( //
-				vec.begin(),
-				vec.end(),
-				this->begin(),
-				this->begin(),
-				[](const auto& a, const auto& /* b */) {
-					return a;
-				}
-			);
-			std::transform(i, this->end(), i, [](const auto&) {
-				return component_type(0);
-			});
-		}
+	constexpr vector& operator=(const vector<component_type, another_dimension>& vec) noexcept
+	{
+		this->base_type::operator=(resized(vec, index_sequence()));
 		return *this;
 	}
 
@@ -475,7 +753,7 @@ public:
 	 * @param num - number to use for assignment.
 	 * @return Reference to this vector object.
 	 */
-	vector& operator=(component_type num) noexcept
+	constexpr vector& operator=(component_type num) noexcept
 	{
 		this->set(num);
 		return *this;
@@ -486,10 +764,16 @@ public:
 	 * @param a - parameter pack of values to set the vector to.
 	 * @return Reference to this vector object.
 	 */
+#if CFG_CPP >= 20
+	template <typename... arguments_type>
+		requires(sizeof...(arguments_type) == dimension)
+	constexpr vector& set(arguments_type... a) noexcept
+#else
 	template <typename... arguments_type>
 	// enable this method only if number of arguments passed is same as the vector dimension
-	std::enable_if_t<sizeof...(arguments_type) == dimension, vector&> //
+	constexpr std::enable_if_t<sizeof...(arguments_type) == dimension, vector&> //
 	set(arguments_type... a) noexcept
+#endif
 	{
 		this->base_type::operator=(base_type{component_type(a)...});
 		return *this;
@@ -500,8 +784,11 @@ public:
 	 * @param val - value to set vector components to.
 	 * @return Reference to this vector object.
 	 */
-	vector& set(component_type val) noexcept
+	constexpr vector& set(component_type val) noexcept
 	{
+		if constexpr (unroll) {
+			return this->unrolled_set(val, index_sequence());
+		}
 		this->comp_operation([&val](const auto&) {
 			return val;
 		});
@@ -515,32 +802,20 @@ public:
 	 * @return Reference to this vector object.
 	 */
 	template <size_t another_dimension>
-	vector& operator+=(const vector<component_type, another_dimension>& vec) noexcept
-	{
-		if constexpr (another_dimension >= dimension) {
-			std::transform( //
-				this->begin(),
-				this->end(),
-				vec.begin(),
-				this->begin(),
-				[](const auto& a, const auto& b) {
-					return a + b;
-				}
-			);
-		} else {
-			static_assert(
-				another_dimension < dimension,
-				"dimension of another vector cannot be greater than of this vector"
-			);
-			std::transform( //
-				vec.begin(),
-				vec.end(),
-				this->begin(),
-				this->begin(),
-				[](const auto& a, const auto& b) {
-					return a + b;
-				}
-			);
+	constexpr vector& operator+=(const vector<component_type, another_dimension>& vec) noexcept
+	{
+		if constexpr (another_dimension == dimension && simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::add(this->data(), vec.data(), this->data());
+				return *this;
+			}
+		}
+		if constexpr (another_dimension >= dimension && unroll) {
+			return this->unrolled_add(vec.data(), index_sequence());
+		}
+		constexpr auto num_components = another_dimension < dimension ? another_dimension : dimension;
+		for (size_t i = 0; i != num_components; ++i) {
+			(*this)[i] += vec[i];
 		}
 		return *this;
 	}
@@ -551,8 +826,18 @@ public:
 	 * @param vec - vector to add.
 	 * @return Vector resulting from vector addition.
 	 */
-	vector operator+(const vector& vec) const noexcept
+	constexpr vector operator+(const vector& vec) const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::add(this->data(), vec.data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(*this).unrolled_add(vec.data(), index_sequence());
+		}
 		return this->comp_op(
 			vec, //
 			std::plus<component_type>()
@@ -565,8 +850,17 @@ public:
 	 * @param number - number to use for addition.
 	 * @return Reference to this vector object.
 	 */
-	vector& operator+=(component_type number) noexcept
+	constexpr vector& operator+=(component_type number) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::add(this->data(), number, this->data());
+				return *this;
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_add(number, index_sequence());
+		}
 		return this->comp_operation([&number](auto& a) {
 			return a + number;
 		});
@@ -578,7 +872,7 @@ public:
 	 * @param number - number to use for addition.
 	 * @return Vector resulting from vector and number addition.
 	 */
-	vector operator+(component_type number) noexcept
+	constexpr vector operator+(component_type number) noexcept
 	{
 		return (vector(*this) += number);
 	}
@@ -590,8 +884,17 @@ public:
 	 * @return Reference to this vector object.
 	 */
 	template <size_t another_dimension>
-	vector& operator-=(const vector<component_type, another_dimension>& vec) noexcept
+	constexpr vector& operator-=(const vector<component_type, another_dimension>& vec) noexcept
 	{
+		if constexpr (another_dimension == dimension && simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::sub(this->data(), vec.data(), this->data());
+				return *this;
+			}
+		}
+		if constexpr (another_dimension >= dimension && unroll) {
+			return this->unrolled_sub(vec.data(), index_sequence());
+		}
 		(*this) += -vec;
 		return *this;
 	}
@@ -602,8 +905,18 @@ public:
 	 * @param vec - vector to subtract.
 	 * @return Vector resulting from vector subtraction.
 	 */
-	vector operator-(const vector& vec) const noexcept
+	constexpr vector operator-(const vector& vec) const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::sub(this->data(), vec.data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(*this).unrolled_sub(vec.data(), index_sequence());
+		}
 		return this->comp_op(
 			vec, //
 			std::minus<component_type>()
@@ -616,7 +929,7 @@ public:
 	 * @param number - number to subtract.
 	 * @return Reference to this vector object.
 	 */
-	vector& operator-=(component_type number) noexcept
+	constexpr vector& operator-=(component_type number) noexcept
 	{
 		(*this) += -number;
 		return *this;
@@ -628,7 +941,7 @@ public:
 	 * @param number - number to subtract.
 	 * @return Vector resulting from number subtraction.
 	 */
-	vector operator-(component_type number) noexcept
+	constexpr vector operator-(component_type number) noexcept
 	{
 		return (vector(*this) -= number);
 	}
@@ -639,12 +952,17 @@ public:
 	 * @param num - scalar to multiply by.
 	 * @return Reference to this vector object.
 	 */
-#if CFG_CPP >= 20
-	constexpr
-#endif
-		vector&
-		operator*=(component_type num) noexcept
+	constexpr vector& operator*=(component_type num) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::mul(this->data(), num, this->data());
+				return *this;
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_mul(num, index_sequence());
+		}
 		return this->comp_operation([&num](auto& a) {
 			return a * num;
 		});
@@ -656,11 +974,7 @@ public:
 	 * @param num - scalar to multiply by.
 	 * @return Vector resulting from multiplication of this vector by scalar.
 	 */
-#if CFG_CPP >= 20
-	constexpr
-#endif
-		vector
-		operator*(component_type num) const noexcept
+	constexpr vector operator*(component_type num) const noexcept
 	{
 		return (vector(*this) *= num);
 	}
@@ -671,11 +985,7 @@ public:
 	 * @param num - scalar to divide by.
 	 * @return Vector resulting from division of this vector by scalar.
 	 */
-#if CFG_CPP >= 20
-	constexpr
-#endif
-		vector
-		operator/(component_type num) const noexcept
+	constexpr vector operator/(component_type num) const noexcept
 	{
 		return vector(*this) /= num;
 	}
@@ -686,7 +996,7 @@ public:
 	 * @param vec - vector to multiply by.
 	 * @return Vector resulting from multiplication of given scalar by given vector.
 	 */
-	friend vector operator*(component_type num, const vector& vec) noexcept
+	constexpr friend vector operator*(component_type num, const vector& vec) noexcept
 	{
 		return vec * num;
 	}
@@ -697,16 +1007,21 @@ public:
 	 * @param num - scalar to divide by.
 	 * @return Reference to this vector object.
 	 */
-#if CFG_CPP >= 20
-	constexpr
-#endif
-		vector&
-		operator/=(component_type num) noexcept
+	constexpr vector& operator/=(component_type num) noexcept
 	{
 		// TODO: uncomment when there is a solution to have the assertion in constexpr context
 		// utki::assert(num != 0, [&](auto& o) {
 		// 	o << "vector::operator/=(): division by 0";
 		// });
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::div(this->data(), num, this->data());
+				return *this;
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_div(num, index_sequence());
+		}
 		return this->comp_operation([&num](auto& a) {
 			return a / num;
 		});
@@ -714,20 +1029,27 @@ public:
 
 	/**
 	 * @brief Dot product.
+	 * The SIMD implementation adds the products in different order than the scalar one,
+	 * so for floating point components the results may differ in the last bits.
 	 * @param vec - vector to multiply by.
 	 * @return Dot product of this vector and given vector.
 	 */
-	component_type dot(const vector& vec) const noexcept
+	constexpr component_type dot(const vector& vec) const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::dot(this->data(), vec.data());
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_dot(vec.data(), index_sequence());
+		}
+
 		component_type res = 0;
 
-		this->comp_op(
-			vec, //
-			[&res](const auto& a, const auto& b) {
-				res += a * b;
-				return component_type();
-			}
-		);
+		for (size_t i = 0; i != dimension; ++i) {
+			res += (*this)[i] * vec[i];
+		}
 
 		return res;
 	}
@@ -738,7 +1060,7 @@ public:
 	 * @param vec - vector to multiply by.
 	 * @return Dot product of this vector and given vector.
 	 */
-	component_type operator*(const vector& vec) const noexcept
+	constexpr component_type operator*(const vector& vec) const noexcept
 	{
 		return this->dot(vec);
 	}
@@ -751,9 +1073,14 @@ public:
 	 * @param vec - vector to multiply by.
 	 * @return Cross product of this vector by given vector.
 	 */
+#if CFG_CPP >= 20
+	constexpr std::conditional_t<dimension == 2, component_type, vector> cross(const vector& vec) const noexcept
+		requires(dimension == 2 || dimension == 3 || dimension == 4)
+#else
 	template <typename enable_type = std::conditional_t<dimension == 2, typename base_type::value_type, vector>>
-	std::enable_if_t<dimension == 2 || dimension == 3 || dimension == 4, enable_type> //
+	constexpr std::enable_if_t<dimension == 2 || dimension == 3 || dimension == 4, enable_type> //
 	cross(const vector& vec) const noexcept
+#endif
 	{
 		if constexpr (dimension == 2) {
 			return this->x() * vec.y() - this->y() * vec.x();
@@ -781,8 +1108,18 @@ public:
 	 * @param vec - vector to multiply by.
 	 * @return Vector resulting from component-wise multiplication.
 	 */
-	vector comp_mul(const vector& vec) const noexcept
+	constexpr vector comp_mul(const vector& vec) const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::mul(this->data(), vec.data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(*this).unrolled_mul(vec.data(), index_sequence());
+		}
 		return this->comp_op(vec, std::multiplies<component_type>());
 	}
 
@@ -793,8 +1130,17 @@ public:
 	 * @param vec - vector to multiply by.
 	 * @return reference to this vector.
 	 */
-	vector& comp_multiply(const vector& vec) noexcept
+	constexpr vector& comp_multiply(const vector& vec) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::mul(this->data(), vec.data(), this->data());
+				return *this;
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_mul(vec.data(), index_sequence());
+		}
 		return this->comp_operation(vec, std::multiplies<component_type>());
 	}
 
@@ -806,8 +1152,18 @@ public:
 	 * @param v - vector to divide by.
 	 * @return Vector resulting from component-wise division.
 	 */
-	vector comp_div(const vector& v) const noexcept
+	constexpr vector comp_div(const vector& v) const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::div(this->data(), v.data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(*this).unrolled_div(v.data(), index_sequence());
+		}
 		return this->comp_op(v, std::divides<component_type>());
 	}
 
@@ -818,8 +1174,17 @@ public:
 	 * @param v - vector to divide by.
 	 * @return reference to this vector instance.
 	 */
-	vector& comp_divide(const vector& v) noexcept
+	constexpr vector& comp_divide(const vector& v) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::div(this->data(), v.data(), this->data());
+				return *this;
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_div(v.data(), index_sequence());
+		}
 		return this->comp_operation(v, std::divides<component_type>());
 	}
 
@@ -828,12 +1193,12 @@ private:
 	// this is why we cannot use std::negate and introduce our own
 	// negation functor
 	struct negate_functor {
-		component_type operator()(component_type a) const
+		constexpr component_type operator()(component_type a) const
 		{
-			if constexpr (std::is_signed_v<component_type>) {
-				return -a;
-			} else {
+			if constexpr (std::is_unsigned_v<component_type>) {
 				return (~a + component_type(1));
+			} else {
+				return -a;
 			}
 		}
 	};
@@ -843,8 +1208,18 @@ public:
 	 * @brief Unary minus.
 	 * @return Negated vector.
 	 */
-	vector operator-() const noexcept
+	constexpr vector operator-() const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::negate(this->data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(*this).unrolled_negate(index_sequence());
+		}
 		return this->comp_op(negate_functor());
 	}
 
@@ -853,17 +1228,37 @@ public:
 	 * Negates this vector.
 	 * @return Reference to this vector object.
 	 */
-	vector& negate() noexcept
+	constexpr vector& negate() noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::negate(this->data(), this->data());
+				return *this;
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_negate(index_sequence());
+		}
 		return this->comp_operation(negate_functor());
 	}
 
 	/**
 	 * @brief Calculate power 2 of the vector's norm.
+	 * The SIMD implementation adds the products in different order than the scalar one,
+	 * so for floating point components the results may differ in the last bits.
 	 * @return This vector's norm to the power of 2.
 	 */
-	component_type norm_pow2() const noexcept
+	constexpr component_type norm_pow2() const noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::dot(this->data(), this->data());
+			}
+		}
+		if constexpr (unroll) {
+			return this->unrolled_dot(this->data(), index_sequence());
+		}
+
 		component_type res = 0;
 
 		for (const auto& e : *this) {
@@ -877,9 +1272,9 @@ public:
 	 * @brief Calculate vector norm.
 	 * @return Vector norm.
 	 */
-	component_type norm() const noexcept
+	constexpr component_type norm() const noexcept
 	{
-		return component_type(sqrt(this->norm_pow2()));
+		return component_type(math::sqrt(this->norm_pow2()));
 	}
 
 	/**
@@ -888,18 +1283,18 @@ public:
 	 * If norm is 0 then the result is vector (1, 0, 0, 0).
 	 * @return Reference to this vector object.
 	 */
-	vector& normalize() noexcept
+	constexpr vector& normalize() noexcept
 	{
 		component_type mag = this->norm();
-		ASSERT(mag >= component_type(0))
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(mag >= component_type(0))
+		}
 		if (mag != component_type(0)) {
 			return (*this) /= mag;
 		}
 
+		this->set(component_type(0));
 		this->x() = 1;
-		std::for_each(std::next(this->begin()), this->end(), [](const auto&) {
-			return component_type(0);
-		});
 		return *this;
 	}
 
@@ -907,11 +1302,82 @@ public:
 	 * @brief Calculate normalized vector.
 	 * @return normalized vector.
 	 */
-	vector normed() const noexcept
+	constexpr vector normed() const noexcept
 	{
 		return vector(*this).normalize();
 	}
 
+	/**
+	 * @brief Calculate sum of vector components.
+	 * The SIMD implementation adds the components in different order than the scalar one,
+	 * so for floating point components the results may differ in the last bits.
+	 * @return Sum of this vector's components.
+	 */
+	constexpr component_type sum() const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::sum(this->data());
+			}
+		}
+
+		component_type res = 0;
+
+		for (const auto& e : *this) {
+			res += e;
+		}
+
+		return res;
+	}
+
+	/**
+	 * @brief Get minimal vector component.
+	 * In case some of the components are NaN the result is unspecified, as is the sign of a zero result.
+	 * @return Minimal component of this vector.
+	 */
+	constexpr component_type min_component() const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::min_component(this->data());
+			}
+		}
+
+		component_type res = this->x();
+
+		for (const auto& e : *this) {
+			if (e < res) {
+				res = e;
+			}
+		}
+
+		return res;
+	}
+
+	/**
+	 * @brief Get maximal vector component.
+	 * In case some of the components are NaN the result is unspecified, as is the sign of a zero result.
+	 * @return Maximal component of this vector.
+	 */
+	constexpr component_type max_component() const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::max_component(this->data());
+			}
+		}
+
+		component_type res = this->x();
+
+		for (const auto& e : *this) {
+			if (res < e) {
+				res = e;
+			}
+		}
+
+		return res;
+	}
+
 	/**
 	 * @brief Rotate vector.
 	 * Defined only for 2 component vector.
@@ -920,13 +1386,16 @@ public:
 	 * @param angle - angle of rotation in radians.
 	 * @return Reference to this vector object.
 	 */
+#if CFG_CPP >= 20
+	constexpr vector& rotate(component_type angle) noexcept
+		requires(dimension == 2)
+#else
 	template <typename enable_type = component_type>
-	vector& rotate(std::enable_if_t<dimension == 2, enable_type> angle) noexcept
+	constexpr vector& rotate(std::enable_if_t<dimension == 2, enable_type> angle) noexcept
+#endif
 	{
-		using std::sin;
-		using std::cos;
-		component_type cosa = cos(angle);
-		component_type sina = sin(angle);
+		component_type cosa = math::cos(angle);
+		component_type sina = math::sin(angle);
 		component_type tmp = this->x() * cosa - this->y() * sina;
 		this->y() = this->y() * cosa + this->x() * sina;
 		this->x() = tmp;
@@ -941,8 +1410,13 @@ public:
 	 * @param angle - angle of rotation in radians.
 	 * @return Vector resulting from rotation of this vector.
 	 */
+#if CFG_CPP >= 20
+	constexpr vector rot(component_type angle) const noexcept
+		requires(dimension == 2)
+#else
 	template <typename enable_type = component_type>
-	vector rot(std::enable_if_t<dimension == 2, enable_type> angle) const noexcept
+	constexpr vector rot(std::enable_if_t<dimension == 2, enable_type> angle) const noexcept
+#endif
 	{
 		return vector(*this).rotate(angle);
 	}
@@ -967,6 +1441,13 @@ public:
 	 */
 	friend vector ceil(const vector& v) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if constexpr (simd_kernels::has_rounding) {
+				vector res{};
+				simd_kernels::ceil(v.data(), res.data());
+				return res;
+			}
+		}
 		return v.comp_op([](const auto& a) {
 			using std::ceil;
 			return component_type(ceil(a));
@@ -980,6 +1461,13 @@ public:
 	 */
 	friend vector floor(const vector& v) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if constexpr (simd_kernels::has_rounding) {
+				vector res{};
+				simd_kernels::floor(v.data(), res.data());
+				return res;
+			}
+		}
 		return v.comp_op([](const auto& a) {
 			using std::floor;
 			return component_type(floor(a));
@@ -992,11 +1480,10 @@ public:
 	 * @param threshold - the snapping threshold.
 	 * @return reference to this vector.
 	 */
-	vector& snap_to_zero(component_type threshold) noexcept
+	constexpr vector& snap_to_zero(component_type threshold) noexcept
 	{
 		return this->comp_operation([&threshold](const auto& a) {
-			using std::abs;
-			if (abs(a) <= threshold) {
+			if (math::abs(a) <= threshold) {
 				return component_type(0);
 			}
 			return a;
@@ -1008,7 +1495,7 @@ public:
 	 * @return true if all vector components are zero.
 	 * @return false otherwise.
 	 */
-	bool is_zero() const noexcept
+	constexpr bool is_zero() const noexcept
 	{
 		for (const auto& c : *this) {
 			if (c != 0) {
@@ -1023,7 +1510,7 @@ public:
 	 * @return true if at least one component of the vector is zero.
 	 * @return false otherwise.
 	 */
-	bool is_any_zero() const noexcept
+	constexpr bool is_any_zero() const noexcept
 	{
 		for (const auto& c : *this) {
 			if (c == 0) {
@@ -1038,7 +1525,7 @@ public:
 	 * @return true if all vector components are not zero.
 	 * @return false otherwise.
 	 */
-	bool is_not_zero() const noexcept
+	constexpr bool is_not_zero() const noexcept
 	{
 		for (auto& c : *this) {
 			if (c == 0) {
@@ -1053,7 +1540,7 @@ public:
 	 * @return true if all vector components are positive or zero.
 	 * @return false otherwise.
 	 */
-	bool is_positive_or_zero() const noexcept
+	constexpr bool is_positive_or_zero() const noexcept
 	{
 		for (auto& c : *this) {
 			if (c < 0) {
@@ -1068,7 +1555,7 @@ public:
 	 * @return true if all vector components are positive.
 	 * @return false otherwise.
 	 */
-	bool is_positive() const noexcept
+	constexpr bool is_positive() const noexcept
 	{
 		for (auto& c : *this) {
 			if (c <= 0) {
@@ -1083,7 +1570,7 @@ public:
 	 * @return true if all vector components are negative.
 	 * @return false otherwise.
 	 */
-	bool is_negative() const noexcept
+	constexpr bool is_negative() const noexcept
 	{
 		for (auto& c : *this) {
 			if (c >= 0) {
@@ -1098,11 +1585,17 @@ public:
 	 * @param v - vector to take absolute value of.
 	 * @return vector holding absolute values of this vector's components.
 	 */
-	friend vector abs(const vector& v) noexcept
+	constexpr friend vector abs(const vector& v) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::abs(v.data(), res.data());
+				return res;
+			}
+		}
 		return v.comp_op([](const auto& a) {
-			using std::abs;
-			return abs(a);
+			return math::abs(a);
 		});
 	}
 
@@ -1111,10 +1604,12 @@ public:
 	 * @param vec - vector to project onto, it does not have to be normalized.
 	 * @return Reference to this vector object.
 	 */
-	vector& project(const vector& vec) noexcept
+	constexpr vector& project(const vector& vec) noexcept
 	{
-		ASSERT(this->norm_pow2() != 0)
-		(*this) = vec * (vec * (*this)) / vec.norm_pow2();
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(this->norm_pow2() != 0)
+		}
+		(*this) = vec * vec.dot(*this) / vec.norm_pow2();
 		return *this;
 	}
 
@@ -1124,8 +1619,13 @@ public:
 	 * @param q - quaternion which defines the rotation.
 	 * @return Reference to this vector object.
 	 */
+#if CFG_CPP >= 20
+	constexpr vector& rotate(const quaternion<component_type>& q) noexcept
+		requires(dimension == 3 || dimension == 4);
+#else
 	template <typename enable_type = component_type>
-	vector& rotate(const quaternion<std::enable_if_t<dimension == 3 || dimension == 4, enable_type>>& q) noexcept;
+	constexpr vector& rotate(const quaternion<std::enable_if_t<dimension == 3 || dimension == 4, enable_type>>& q) noexcept;
+#endif
 
 	/**
 	 * @brief Get component-wise minimum of two vectors.
@@ -1133,8 +1633,18 @@ public:
 	 * @param vb - second vector.
 	 * @return vector whose components are component-wise minimum of initial vectors.
 	 */
-	friend vector min(const vector& va, const vector& vb) noexcept
+	constexpr friend vector min(const vector& va, const vector& vb) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::min(va.data(), vb.data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(va).unrolled_min(vb.data(), index_sequence());
+		}
 		return va.comp_op(vb, [](const auto& a, const auto& b) {
 			using std::min;
 			return min(a, b);
@@ -1147,32 +1657,23 @@ public:
 	 * @param vb - second vector.
 	 * @return vector whose components are component-wise maximum of initial vectors.
 	 */
-	friend vector max(const vector& va, const vector& vb) noexcept
+	constexpr friend vector max(const vector& va, const vector& vb) noexcept
 	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector res{};
+				simd_kernels::max(va.data(), vb.data(), res.data());
+				return res;
+			}
+		}
+		if constexpr (unroll) {
+			return vector(va).unrolled_max(vb.data(), index_sequence());
+		}
 		return va.comp_op(vb, [](const auto& a, const auto& b) {
 			using std::max;
 			return max(a, b);
 		});
 	}
-
-	friend std::ostream& operator<<(std::ostream& s, const vector<component_type, dimension>& vec)
-	{
-		static_assert(dimension >= 1, "dimension cannot be 0");
-		if constexpr (std::is_same_v<component_type, uint8_t>) {
-			s << unsigned(vec.x());
-		} else {
-			s << vec.x();
-		}
-		for (auto i = std::next(vec.begin()); i != vec.end(); ++i) {
-			s << " ";
-			if constexpr (std::is_same_v<component_type, uint8_t>) {
-				s << unsigned(*i);
-			} else {
-				s << (*i);
-			}
-		}
-		return s;
-	}
 };
 
 template <typename component_type>
@@ -1196,14 +1697,38 @@ static_assert(
 
 namespace r4 {
 
+#if CFG_CPP >= 20
+template <class component_type, size_t dimension>
+constexpr vector<component_type, dimension>& vector<component_type, dimension>::rotate(const quaternion<component_type>& q) noexcept
+	requires(dimension == 3 || dimension == 4)
+#else
 template <class component_type, size_t dimension>
 template <typename enable_type>
-vector<component_type, dimension>& vector<component_type, dimension>::rotate(
+constexpr vector<component_type, dimension>& vector<component_type, dimension>::rotate(
 	const quaternion<std::enable_if_t<dimension == 3 || dimension == 4, enable_type>>& q
 ) noexcept
+#endif
 {
 	*this = q.rot(*this);
 	return *this;
 }
 
 } // namespace r4
+
+// The r4 library contains explicit instantiations of vectors of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class vector<float, 2>;
+extern template class vector<float, 3>;
+extern template class vector<float, 4>;
+extern template class vector<double, 2>;
+extern template class vector<double, 3>;
+extern template class vector<double, 4>;
+extern template class vector<int, 2>;
+extern template class vector<int, 3>;
+extern template class vector<int, 4>;
+
+} // namespace r4
+#endif
@@ -0,0 +1,583 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015-2026 Ivan Gagis <igagis@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/* ================ LICENSE END ================ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include <utki/config.hpp>
+#include <utki/debug.hpp>
+
+#include "math.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+
+namespace r4 {
+
+/**
+ * @brief 3d vector padded to 4 components.
+ * The vector3a occupies the space of 4 components and is aligned to that size,
+ * i.e. vector3a<float> is 16 bytes and 16-byte aligned.
+ * This allows processing all components with a single 4-lane SIMD instruction without shuffling
+ * the 3 components into and out of SIMD registers. Also, elements of a vector3a array never cross the cache line boundary.
+ * The padding component is not accessible and does not affect results of any operation.
+ *
+ * The vector3a is a vector3, so it can be passed wherever a vector3 is expected and all of the vector3 API is available.
+ * The operations accelerated for vector3a return vector3a, the rest of operations return vector3.
+ * Conversion from vector3 is implicit and only adds zeroing of the padding component.
+ * @tparam component_type - type of vector components.
+ */
+template <typename component_type>
+class alignas(4 * sizeof(component_type)) vector3a : public vector<component_type, 3>
+{
+	using simd_kernels = simd::vector3a_kernels<component_type>;
+
+	// keep the padding component initialized to avoid computing on garbage values, like denormals, in the 4th SIMD lane
+	component_type padding = 0;
+
+	// pointer to all 4 components including the padding
+	component_type* lanes() noexcept
+	{
+		// vector3a is not a standard layout class, so offsetof() is only conditionally supported for it,
+		// but GCC, Clang and MSVC all place the base class components first and the padding right after them
+#if CFG_COMPILER == CFG_COMPILER_GCC || CFG_COMPILER == CFG_COMPILER_CLANG
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+		static_assert(std::is_standard_layout_v<base_type>, "vector components must be at the beginning of the vector");
+		static_assert(sizeof(base_type) == 3 * sizeof(component_type), "vector must not contain anything but components");
+		static_assert(offsetof(vector3a, padding) == 3 * sizeof(component_type), "padding must follow the components");
+#if CFG_COMPILER == CFG_COMPILER_GCC || CFG_COMPILER == CFG_COMPILER_CLANG
+#	pragma GCC diagnostic pop
+#endif
+
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		return reinterpret_cast<component_type*>(this);
+	}
+
+	const component_type* lanes() const noexcept
+	{
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+		return reinterpret_cast<const component_type*>(this);
+	}
+
+public:
+	using base_type = vector<component_type, 3>;
+
+	/**
+	 * @brief Construct uninitialized vector.
+	 */
+	constexpr vector3a() = default;
+
+	/**
+	 * @brief Constructor.
+	 * Initializes vector components to given values.
+	 * @param x - value for the first component.
+	 * @param y - value for the second component.
+	 * @param z - value for the third component.
+	 */
+	constexpr vector3a(component_type x, component_type y, component_type z) noexcept :
+		base_type(x, y, z)
+	{}
+
+	/**
+	 * @brief Constructor.
+	 * Initializes all vector components to a given value.
+	 * @param num - value to initialize all vector components with.
+	 */
+	constexpr vector3a(component_type num) noexcept :
+		base_type(num)
+	{}
+
+	/**
+	 * @brief Constructor.
+	 * Initializes components to a given values.
+	 * @param vec - 2d vector to use for initialization of first two vector components.
+	 * @param z - value to use for initialization of 3rd vector component.
+	 */
+	constexpr vector3a(const vector<component_type, 2>& vec, component_type z = 0) noexcept :
+		base_type(vec.x(), vec.y(), z)
+	{}
+
+	/**
+	 * @brief Constructor.
+	 * Initializes components to a given values.
+	 * In case the given vector has lower dimension than 3 the rest of the components will be initialized to 0.
+	 * @param vec - vector to use for initialization of vector components, e.g. a vector3.
+	 */
+	template <size_t another_dimension>
+	constexpr vector3a(const vector<component_type, another_dimension>& vec) noexcept :
+		base_type(vec)
+	{}
+
+	using base_type::operator+;
+	using base_type::operator-;
+	using base_type::operator*;
+	using base_type::operator/;
+	using base_type::operator+=;
+	using base_type::operator-=;
+	using base_type::operator*=;
+	using base_type::operator/=;
+	using base_type::dot;
+	using base_type::cross;
+	using base_type::comp_mul;
+	using base_type::comp_multiply;
+	using base_type::comp_div;
+	using base_type::comp_divide;
+
+	/**
+	 * @brief Add vector.
+	 * @param vec - vector to add.
+	 * @return Vector resulting from vector addition.
+	 */
+	constexpr vector3a operator+(const vector3a& vec) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::add(this->lanes(), vec.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::operator+(vec);
+	}
+
+	/**
+	 * @brief Add and assign.
+	 * @param vec - vector to add.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& operator+=(const vector3a& vec) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::add(this->lanes(), vec.lanes(), this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::operator+=(vec);
+		return *this;
+	}
+
+	/**
+	 * @brief Subtract vector.
+	 * @param vec - vector to subtract.
+	 * @return Vector resulting from vector subtraction.
+	 */
+	constexpr vector3a operator-(const vector3a& vec) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::sub(this->lanes(), vec.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::operator-(vec);
+	}
+
+	/**
+	 * @brief Subtract and assign.
+	 * @param vec - vector to subtract.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& operator-=(const vector3a& vec) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::sub(this->lanes(), vec.lanes(), this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::operator-=(vec);
+		return *this;
+	}
+
+	/**
+	 * @brief Unary minus.
+	 * @return Negated vector.
+	 */
+	constexpr vector3a operator-() const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::negate(this->lanes(), res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::operator-();
+	}
+
+	/**
+	 * @brief Negate this vector.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& negate() noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::negate(this->lanes(), this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::negate();
+		return *this;
+	}
+
+	/**
+	 * @brief Multiply by scalar.
+	 * @param num - scalar to multiply by.
+	 * @return Vector resulting from multiplication of this vector by scalar.
+	 */
+	constexpr vector3a operator*(component_type num) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::mul(this->lanes(), num, res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::operator*(num);
+	}
+
+	/**
+	 * @brief Multiply scalar by vector.
+	 * @param num - scalar to multiply.
+	 * @param vec - vector to multiply by.
+	 * @return Vector resulting from multiplication of given scalar by given vector.
+	 */
+	constexpr friend vector3a operator*(component_type num, const vector3a& vec) noexcept
+	{
+		return vec * num;
+	}
+
+	/**
+	 * @brief Multiply by scalar and assign.
+	 * @param num - scalar to multiply by.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& operator*=(component_type num) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::mul(this->lanes(), num, this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::operator*=(num);
+		return *this;
+	}
+
+	/**
+	 * @brief Divide by scalar.
+	 * @param num - scalar to divide by.
+	 * @return Vector resulting from division of this vector by scalar.
+	 */
+	constexpr vector3a operator/(component_type num) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::div(this->lanes(), num, res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::operator/(num);
+	}
+
+	/**
+	 * @brief Divide by scalar and assign.
+	 * @param num - scalar to divide by.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& operator/=(component_type num) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::div(this->lanes(), num, this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::operator/=(num);
+		return *this;
+	}
+
+	/**
+	 * @brief Dot product.
+	 * @param vec - vector to multiply by.
+	 * @return Dot product of this vector and given vector.
+	 */
+	constexpr component_type dot(const vector3a& vec) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				return simd_kernels::dot(this->lanes(), vec.lanes());
+			}
+		}
+		return this->base_type::dot(vec);
+	}
+
+	/**
+	 * @brief Cross product.
+	 * @param vec - vector to multiply by.
+	 * @return Vector resulting from the cross product.
+	 */
+	constexpr vector3a cross(const vector3a& vec) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::cross(this->lanes(), vec.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::cross(vec);
+	}
+
+	/**
+	 * @brief Component-wise multiplication.
+	 * @param vec - vector to multiply by.
+	 * @return Vector resulting from component-wise multiplication.
+	 */
+	constexpr vector3a comp_mul(const vector3a& vec) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::mul(this->lanes(), vec.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::comp_mul(vec);
+	}
+
+	/**
+	 * @brief Component-wise multiplication and assign.
+	 * @param vec - vector to multiply by.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& comp_multiply(const vector3a& vec) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::mul(this->lanes(), vec.lanes(), this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::comp_multiply(vec);
+		return *this;
+	}
+
+	/**
+	 * @brief Component-wise division.
+	 * @param vec - vector to divide by.
+	 * @return Vector resulting from component-wise division.
+	 */
+	constexpr vector3a comp_div(const vector3a& vec) const noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::div(this->lanes(), vec.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return this->base_type::comp_div(vec);
+	}
+
+	/**
+	 * @brief Component-wise division and assign.
+	 * @param vec - vector to divide by.
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& comp_divide(const vector3a& vec) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				simd_kernels::div(this->lanes(), vec.lanes(), this->lanes());
+				return *this;
+			}
+		}
+		this->base_type::comp_divide(vec);
+		return *this;
+	}
+
+	/**
+	 * @brief Calculate power 2 of vector norm.
+	 * @return Power 2 of this vector norm.
+	 */
+	constexpr component_type norm_pow2() const noexcept
+	{
+		return this->dot(*this);
+	}
+
+	/**
+	 * @brief Calculate vector norm.
+	 * @return Vector norm.
+	 */
+	constexpr component_type norm() const noexcept
+	{
+		return component_type(math::sqrt(this->norm_pow2()));
+	}
+
+	/**
+	 * @brief Normalize this vector.
+	 * If norm is 0 then the result is vector (1, 0, 0).
+	 * @return Reference to this vector object.
+	 */
+	constexpr vector3a& normalize() noexcept
+	{
+		component_type mag = this->norm();
+		if (!simd::is_constant_evaluated()) {
+			ASSERT(mag >= component_type(0))
+		}
+		if (mag != component_type(0)) {
+			return (*this) /= mag;
+		}
+
+		this->set(component_type(0));
+		this->x() = 1;
+		return *this;
+	}
+
+	/**
+	 * @brief Calculate normalized vector.
+	 * @return normalized vector.
+	 */
+	constexpr vector3a normed() const noexcept
+	{
+		return vector3a(*this).normalize();
+	}
+
+	/**
+	 * @brief Absolute vector value.
+	 * @param v - vector to take absolute value of.
+	 * @return vector holding absolute values of the vector's components.
+	 */
+	constexpr friend vector3a abs(const vector3a& v) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::abs(v.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return abs(static_cast<const base_type&>(v));
+	}
+
+	/**
+	 * @brief Get component-wise minimum of two vectors.
+	 * @param va - first vector.
+	 * @param vb - second vector.
+	 * @return vector whose components are component-wise minimum of initial vectors.
+	 */
+	constexpr friend vector3a min(const vector3a& va, const vector3a& vb) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::min(va.lanes(), vb.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return min(static_cast<const base_type&>(va), static_cast<const base_type&>(vb));
+	}
+
+	/**
+	 * @brief Get component-wise maximum of two vectors.
+	 * @param va - first vector.
+	 * @param vb - second vector.
+	 * @return vector whose components are component-wise maximum of initial vectors.
+	 */
+	constexpr friend vector3a max(const vector3a& va, const vector3a& vb) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if (!simd::is_constant_evaluated()) {
+				vector3a res{};
+				simd_kernels::max(va.lanes(), vb.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return max(static_cast<const base_type&>(va), static_cast<const base_type&>(vb));
+	}
+
+	/**
+	 * @brief Ceil vector components.
+	 * @param v - vector to ceil.
+	 * @return ceiled vector.
+	 */
+	friend vector3a ceil(const vector3a& v) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if constexpr (simd_kernels::has_rounding) {
+				vector3a res{};
+				simd_kernels::ceil(v.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return ceil(static_cast<const base_type&>(v));
+	}
+
+	/**
+	 * @brief Floor vector components.
+	 * @param v - vector to floor.
+	 * @return floored vector.
+	 */
+	friend vector3a floor(const vector3a& v) noexcept
+	{
+		if constexpr (simd_kernels::enabled) {
+			if constexpr (simd_kernels::has_rounding) {
+				vector3a res{};
+				simd_kernels::floor(v.lanes(), res.lanes());
+				return res;
+			}
+		}
+		return floor(static_cast<const base_type&>(v));
+	}
+};
+
+static_assert(sizeof(vector3a<float>) == sizeof(float) * 4, "size mismatch");
+static_assert(alignof(vector3a<float>) == sizeof(float) * 4, "alignment mismatch");
+static_assert(sizeof(vector3a<double>) == sizeof(double) * 4, "size mismatch");
+
+} // namespace r4
+
+// The r4 library contains explicit instantiations of vector3a of common types.
+// Define R4_EXTERN_TEMPLATES to use those instead of instantiating them in every translation unit.
+#ifdef R4_EXTERN_TEMPLATES
+namespace r4 {
+
+extern template class vector3a<float>;
+extern template class vector3a<double>;
+extern template class vector3a<int>;
+
+} // namespace r4
+#endif
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# Compare performance of unoptimized (-O0) builds of the benchmarks with and without R4_DEBUG_FAST mode.
+# The benchmarks are built with the compiler directly, bypassing the build system,
+# so that both variants are built with exactly the same flags except the R4_DEBUG_FAST macro.
+#
+# usage: run_debug_fast.sh [benchmark options], e.g. run_debug_fast.sh --filter=float
+# environment variables:
+#   CXX - compiler to use, default is g++
+#   CXXFLAGS - additional compiler flags, default is -O0 -DDEBUG
+#   LDLIBS - libraries to link, default is -lutki -lm
+#   OUT_DIR - directory to put the binaries and JSON results to, default is out/debug_fast
+
+set -eo pipefail
+
+script_dir=$(dirname "$0")
+cxx=${CXX:-g++}
+cxxflags=${CXXFLAGS:--O0 -DDEBUG}
+ldlibs=${LDLIBS:--lutki -lm}
+out_dir=${OUT_DIR:-${script_dir}/out/debug_fast}
+
+mkdir -p "${out_dir}"
+
+for mode in default debug_fast; do
+	defines=
+	if [ "${mode}" == "debug_fast" ]; then
+		defines=-DR4_DEBUG_FAST
+	fi
+
+	echo "building ${mode}"
+	# shellcheck disable=SC2086
+	${cxx} -std=c++17 ${cxxflags} ${defines} -isystem "${script_dir}/../../src" \
+		"${script_dir}"/src/*.cpp "${script_dir}"/../../src/r4/*.cpp -o "${out_dir}/r4_bench_${mode}" ${ldlibs}
+done
+
+for mode in default debug_fast; do
+	echo "running ${mode}"
+	"${out_dir}/r4_bench_${mode}" --label="${mode}" --json-out="${out_dir}/${mode}.json" "$@"
+done
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <utki/config.hpp>
+
+// Minimal micro-benchmark harness.
+//
+// Benchmarks are declared in the same fashion as tst unit tests:
+//
+//     const bench::set set("vector", [](bench::suite& suite){
+//         suite.add("vector3<float>::dot", [](size_t num_iterations){
+//             ...
+//         });
+//     });
+//
+// Each benchmark function performs the benchmarked operation given number of times.
+// The runner calibrates the number of iterations so that one sample runs for a sufficiently
+// long time, runs warmup samples and then collects timing statistics over several samples.
+
+namespace bench {
+
+/**
+ * @brief Prevent compiler from optimizing away the value computation.
+ * The compiler has to assume that the value is read and modified.
+ * @param value - value to keep.
+ */
+template <typename value_type>
+inline void do_not_optimize(value_type& value)
+{
+#if CFG_COMPILER == CFG_COMPILER_GCC || CFG_COMPILER == CFG_COMPILER_CLANG
+	if constexpr (std::is_trivially_copyable_v<value_type> && sizeof(value_type) <= sizeof(void*)) {
+		asm volatile("" : "+r,m"(value) : : "memory");
+	} else {
+		asm volatile("" : "+m,r"(value) : : "memory");
+	}
+#else
+	static const volatile void* volatile sink;
+	sink = &value;
+#endif
+}
+
+/**
+ * @brief Prevent compiler from optimizing away the value computation.
+ * The compiler has to assume that the value is read.
+ * @param value - value to keep.
+ */
+template <typename value_type>
+inline void do_not_optimize(const value_type& value)
+{
+#if CFG_COMPILER == CFG_COMPILER_GCC || CFG_COMPILER == CFG_COMPILER_CLANG
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static const volatile void* volatile sink;
+	sink = &value;
+#endif
+}
+
+/**
+ * @brief Make compiler assume that all memory may have been read and modified.
+ */
+inline void clobber_memory()
+{
+#if CFG_COMPILER == CFG_COMPILER_GCC || CFG_COMPILER == CFG_COMPILER_CLANG
+	asm volatile("" : : : "memory");
+#else
+	std::atomic_signal_fence(std::memory_order_acq_rel);
+#endif
+}
+
+/**
+ * @brief Benchmark function.
+ * The function performs benchmarked operation given number of times.
+ */
+using function_type = std::function<void(size_t num_iterations)>;
+
+struct benchmark {
+	std::string name;
+
+	// number of processed elements per one iteration, e.g. size of the array for batched operations
+	size_t num_elements_per_iteration;
+
+	function_type func;
+};
+
+class suite
+{
+	friend class set;
+
+	std::vector<benchmark> benchmarks;
+
+public:
+	/**
+	 * @brief Add benchmark processing one element per iteration.
+	 * @param name - benchmark name.
+	 * @param func - benchmark function.
+	 */
+	void add(std::string name, function_type func)
+	{
+		this->add(std::move(name), 1, std::move(func));
+	}
+
+	/**
+	 * @brief Add benchmark processing several elements per iteration.
+	 * The timings are reported per element.
+	 * @param name - benchmark name.
+	 * @param num_elements_per_iteration - number of elements processed by one iteration.
+	 * @param func - benchmark function.
+	 */
+	void add(std::string name, size_t num_elements_per_iteration, function_type func)
+	{
+		this->benchmarks.push_back(benchmark{std::move(name), num_elements_per_iteration, std::move(func)});
+	}
+
+	const std::vector<benchmark>& get_benchmarks() const noexcept
+	{
+		return this->benchmarks;
+	}
+};
+
+/**
+ * @brief Named set of benchmarks.
+ * Declare global constant instances of this class to register benchmarks.
+ */
+class set
+{
+public:
+	set(std::string_view name, const std::function<void(suite&)>& init);
+};
+
+struct registered_suite {
+	std::string name;
+	suite s;
+};
+
+std::vector<registered_suite>& get_registry();
+
+/**
+ * @brief Get name of the type.
+ * Used to compose names of the benchmarks instantiated for several component types.
+ * @return type name.
+ */
+template <typename type>
+constexpr std::string_view type_name()
+{
+	if constexpr (std::is_same_v<type, float>) {
+		return "float";
+	} else if constexpr (std::is_same_v<type, double>) {
+		return "double";
+	} else if constexpr (std::is_same_v<type, int>) {
+		return "int";
+	} else {
+		static_assert(!std::is_same_v<type, type>, "unknown type");
+	}
+}
+
+/**
+ * @brief Deterministic pseudo-random number generator.
+ * Benchmark input data is generated with fixed seed, so that results are comparable between runs.
+ */
+class random
+{
+	std::mt19937 engine;
+
+public:
+	random(uint32_t seed = 1) :
+		engine(seed)
+	{}
+
+	/**
+	 * @brief Get random number.
+	 * @param min - minimal value.
+	 * @param max - maximal value.
+	 * @return random number from [min : max].
+	 */
+	template <typename type>
+	type get(type min, type max)
+	{
+		if constexpr (std::is_integral_v<type>) {
+			return std::uniform_int_distribution<type>(min, max)(this->engine);
+		} else {
+			return std::uniform_real_distribution<type>(min, max)(this->engine);
+		}
+	}
+};
+
+/**
+ * @brief Number of elements used in batched benchmarks.
+ * Small enough for the data to stay in L1 cache, so that the batched benchmarks measure computations.
+ */
+constexpr size_t batch_size = 256;
+
+} // namespace bench
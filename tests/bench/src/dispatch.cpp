@@ -0,0 +1,110 @@
+#include <r4/dispatch.hpp>
+
+#include "bench.hpp"
+
+namespace {
+std::vector<r4::vector3<float>> make_points()
+{
+	bench::random rnd;
+	std::vector<r4::vector3<float>> ret;
+	for (size_t i = 0; i != bench::batch_size; ++i) {
+		ret.emplace_back(
+			rnd.get<float>(-100, 100), //
+			rnd.get<float>(-100, 100),
+			rnd.get<float>(-100, 100)
+		);
+	}
+	return ret;
+}
+
+// the benchmarks convert 4 component vectors, so the timings are per vector, same as for other benchmarks in this suite
+template <typename half_type>
+void add_convert(bench::suite& suite, r4::dispatch::isa isa, std::string_view type_name)
+{
+	std::string suffix = "<" + std::string(r4::dispatch::to_string(isa)) + ">";
+
+	suite.add("convert(vector4<float> -> vector4<" + std::string(type_name) + ">)" + suffix, bench::batch_size, [isa](size_t num_iterations) {
+		r4::dispatch::set_isa(isa);
+		const auto points = make_points();
+		std::vector<r4::vector4<float>> in;
+		for (const auto& p : points) {
+			in.emplace_back(p, 1);
+		}
+		const auto& const_in = in;
+		std::vector<r4::vector4<half_type>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::dispatch::convert(utki::make_span(const_in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add("convert(vector4<" + std::string(type_name) + "> -> vector4<float>)" + suffix, bench::batch_size, [isa](size_t num_iterations) {
+		r4::dispatch::set_isa(isa);
+		const auto points = make_points();
+		std::vector<r4::vector4<half_type>> in;
+		for (const auto& p : points) {
+			in.push_back(r4::vector4<float>(p, 1).to<half_type>());
+		}
+		const auto& const_in = in;
+		std::vector<r4::vector4<float>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::dispatch::convert(utki::make_span(const_in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+void add_all(bench::suite& suite, r4::dispatch::isa isa)
+{
+	std::string suffix = "<" + std::string(r4::dispatch::to_string(isa)) + ">";
+
+	// the benchmarks run one at a time, so each of them selects its instruction set before running
+
+	suite.add("transform_points" + suffix, bench::batch_size, [isa](size_t num_iterations) {
+		r4::dispatch::set_isa(isa);
+		r4::matrix4<float> m;
+		m.set_identity();
+		m.translate(1, 2, 3);
+		m.scale(2, 3, 4);
+		const auto in = make_points();
+		std::vector<r4::vector3<float>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::dispatch::transform_points(m, utki::make_span(in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add("normalize" + suffix, bench::batch_size, [isa](size_t num_iterations) {
+		r4::dispatch::set_isa(isa);
+		auto vectors = make_points();
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::dispatch::normalize(utki::make_span(vectors));
+			bench::do_not_optimize(vectors.front());
+		}
+	});
+
+	suite.add("bounding_box" + suffix, bench::batch_size, [isa](size_t num_iterations) {
+		r4::dispatch::set_isa(isa);
+		const auto points = make_points();
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			auto box = r4::dispatch::bounding_box(utki::make_span(points));
+			bench::do_not_optimize(box);
+		}
+	});
+
+	add_convert<r4::half>(suite, isa, "half");
+	add_convert<r4::bfloat16>(suite, isa, "bfloat16");
+}
+
+const bench::set set("dispatch", [](bench::suite& suite) {
+	// only the instruction sets supported by the CPU can be selected
+	for (size_t i = 0; i <= size_t(r4::dispatch::get_supported_isa()); ++i) {
+		add_all(suite, r4::dispatch::isa(i));
+	}
+});
+} // namespace
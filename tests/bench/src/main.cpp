@@ -0,0 +1,395 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+
+#include <r4/simd.hpp>
+
+#include "bench.hpp"
+#include "perf_counters.hpp"
+
+using namespace std::string_view_literals;
+
+std::vector<bench::registered_suite>& bench::get_registry()
+{
+	static std::vector<registered_suite> registry;
+	return registry;
+}
+
+bench::set::set(std::string_view name, const std::function<void(suite&)>& init)
+{
+	registered_suite s{std::string(name), suite()};
+	init(s.s);
+	get_registry().push_back(std::move(s));
+}
+
+namespace {
+struct options {
+	std::string filter;
+	std::string json_out;
+	std::string label;
+	size_t num_samples = 15;
+	size_t num_warmup_samples = 3;
+	double min_sample_time_ms = 10;
+	bool list = false;
+	bool perf_counters = false;
+};
+
+struct statistics {
+	double min;
+	double median;
+	double mean;
+	double stddev;
+};
+
+struct result {
+	std::string suite;
+	std::string name;
+	size_t num_iterations;
+	size_t num_elements_per_iteration;
+
+	// nanoseconds per element
+	statistics ns;
+
+	// hardware counters per element, averaged over all measured samples
+	struct {
+		bool valid = false;
+		double cycles = 0;
+		double instructions = 0;
+		double branch_misses = 0;
+		double l1d_read_misses = 0;
+
+		double ipc() const noexcept
+		{
+			return this->cycles > 0 ? this->instructions / this->cycles : 0;
+		}
+	} counters;
+};
+
+statistics calc_statistics(std::vector<double> samples)
+{
+	std::sort(samples.begin(), samples.end());
+
+	statistics ret{};
+	ret.min = samples.front();
+
+	size_t mid = samples.size() / 2;
+	ret.median = samples.size() % 2 == 0 ? (samples[mid - 1] + samples[mid]) / 2 : samples[mid];
+
+	ret.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+
+	double var = 0;
+	for (auto s : samples) {
+		var += (s - ret.mean) * (s - ret.mean);
+	}
+	ret.stddev = samples.size() > 1 ? std::sqrt(var / double(samples.size() - 1)) : 0;
+
+	return ret;
+}
+
+// run the benchmark function once and return elapsed time in nanoseconds
+double run_sample(const bench::benchmark& b, size_t num_iterations)
+{
+	using clock = std::chrono::steady_clock;
+
+	bench::clobber_memory();
+	auto start = clock::now();
+	b.func(num_iterations);
+	bench::clobber_memory();
+	auto end = clock::now();
+
+	return double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+// find number of iterations for one sample to run at least the minimal sample time
+size_t calibrate(const bench::benchmark& b, const options& opts)
+{
+	const double min_time_ns = opts.min_sample_time_ms * 1e6;
+
+	size_t num_iterations = 1;
+	for (;;) {
+		double t = run_sample(b, num_iterations);
+		if (t >= min_time_ns) {
+			return num_iterations;
+		}
+
+		// estimate the number of iterations with 20% margin, but grow at most 100 times per step
+		double factor = t > 0 ? std::min(min_time_ns * 1.2 / t, 100.0) : 100.0;
+		num_iterations = std::max(num_iterations + 1, size_t(double(num_iterations) * factor));
+	}
+}
+
+result run(
+	const std::string& suite_name,
+	const bench::benchmark& b,
+	const options& opts,
+	bench::perf_counters* counters
+)
+{
+	size_t num_iterations = calibrate(b, opts);
+
+	for (size_t i = 0; i != opts.num_warmup_samples; ++i) {
+		run_sample(b, num_iterations);
+	}
+
+	const double num_elements_per_sample = double(num_iterations * b.num_elements_per_iteration);
+
+	bench::perf_counters::values_type counted{};
+
+	// the counters are valid only if they were read successfully for all samples
+	bool counted_valid = counters != nullptr;
+
+	std::vector<double> samples;
+	samples.reserve(opts.num_samples);
+	for (size_t i = 0; i != opts.num_samples; ++i) {
+		// counters are started outside of the timed region, so they do not affect the timing
+		if (counters) {
+			counters->start();
+		}
+		double t = run_sample(b, num_iterations);
+		if (counters) {
+			auto values = counters->stop();
+			if (values) {
+				std::transform(counted.begin(), counted.end(), values->begin(), counted.begin(), std::plus<>());
+			} else {
+				counted_valid = false;
+			}
+		}
+		samples.push_back(t / num_elements_per_sample);
+	}
+
+	result ret;
+	ret.suite = suite_name;
+	ret.name = b.name;
+	ret.num_iterations = num_iterations;
+	ret.num_elements_per_iteration = b.num_elements_per_iteration;
+	ret.ns = calc_statistics(std::move(samples));
+
+	if (counted_valid) {
+		using c = bench::perf_counters::counter;
+		auto per_element = [&](c what) {
+			return double(counted[size_t(what)]) / (num_elements_per_sample * double(opts.num_samples));
+		};
+		ret.counters.valid = true;
+		ret.counters.cycles = per_element(c::cycles);
+		ret.counters.instructions = per_element(c::instructions);
+		ret.counters.branch_misses = per_element(c::branch_misses);
+		ret.counters.l1d_read_misses = per_element(c::l1d_read_misses);
+	}
+
+	return ret;
+}
+
+std::string json_escape(std::string_view str)
+{
+	std::stringstream ss;
+	for (char c : str) {
+		switch (c) {
+			case '"':
+				ss << "\\\"";
+				break;
+			case '\\':
+				ss << "\\\\";
+				break;
+			case '\n':
+				ss << "\\n";
+				break;
+			default:
+				ss << c;
+				break;
+		}
+	}
+	return ss.str();
+}
+
+std::string simd_description()
+{
+	std::string ret;
+#ifdef R4_SIMD_SSE2
+	ret += "sse2 ";
+#endif
+#ifdef R4_SIMD_SSE4_1
+	ret += "sse4.1 ";
+#endif
+#ifdef R4_SIMD_AVX
+	ret += "avx ";
+#endif
+	if (ret.empty()) {
+		return "none";
+	}
+	ret.pop_back();
+	return ret;
+}
+
+void write_json(std::ostream& o, const std::vector<result>& results, const options& opts, bool counters_available)
+{
+	o << std::setprecision(6);
+	o << "{" << '\n';
+	o << "  \"context\": {" << '\n';
+	o << "    \"label\": \"" << json_escape(opts.label) << "\"," << '\n';
+#ifdef __VERSION__
+	o << "    \"compiler\": \"" << json_escape(__VERSION__) << "\"," << '\n';
+#endif
+	o << "    \"cplusplus\": " << __cplusplus << "," << '\n';
+#ifdef DEBUG
+	o << "    \"debug\": true," << '\n';
+#else
+	o << "    \"debug\": false," << '\n';
+#endif
+	o << "    \"simd\": \"" << simd_description() << "\"," << '\n';
+	o << "    \"num_samples\": " << opts.num_samples << "," << '\n';
+	o << "    \"num_warmup_samples\": " << opts.num_warmup_samples << "," << '\n';
+	o << "    \"min_sample_time_ms\": " << opts.min_sample_time_ms << "," << '\n';
+	o << "    \"perf_counters\": " << (counters_available ? "true" : "false") << '\n';
+	o << "  }," << '\n';
+	o << "  \"benchmarks\": [";
+	for (auto i = results.begin(); i != results.end(); ++i) {
+		if (i != results.begin()) {
+			o << ",";
+		}
+		o << '\n';
+		o << "    {" << '\n';
+		o << "      \"suite\": \"" << json_escape(i->suite) << "\"," << '\n';
+		o << "      \"name\": \"" << json_escape(i->name) << "\"," << '\n';
+		o << "      \"iterations\": " << i->num_iterations << "," << '\n';
+		o << "      \"elements_per_iteration\": " << i->num_elements_per_iteration << "," << '\n';
+		o << "      \"ns_per_element\": {";
+		o << "\"min\": " << i->ns.min << ", ";
+		o << "\"median\": " << i->ns.median << ", ";
+		o << "\"mean\": " << i->ns.mean << ", ";
+		o << "\"stddev\": " << i->ns.stddev << "}";
+		if (i->counters.valid) {
+			o << "," << '\n';
+			o << "      \"counters_per_element\": {";
+			o << "\"cycles\": " << i->counters.cycles << ", ";
+			o << "\"instructions\": " << i->counters.instructions << ", ";
+			o << "\"ipc\": " << i->counters.ipc() << ", ";
+			o << "\"branch_misses\": " << i->counters.branch_misses << ", ";
+			o << "\"l1d_read_misses\": " << i->counters.l1d_read_misses << "}";
+		}
+		o << '\n';
+		o << "    }";
+	}
+	o << '\n' << "  ]" << '\n';
+	o << "}" << '\n';
+}
+
+void print_help()
+{
+	std::cout << "r4 micro-benchmarks" << '\n'
+			  << '\n'
+			  << "options:" << '\n'
+			  << "  --help                 show this help" << '\n'
+			  << "  --list                 list benchmarks and exit" << '\n'
+			  << "  --filter=<str>         run only benchmarks with full name (suite/name) containing <str>" << '\n'
+			  << "  --json-out=<file>      write results in JSON format to <file>" << '\n'
+			  << "  --label=<str>          label to put to JSON output, e.g. git commit hash" << '\n'
+			  << "  --samples=<n>          number of measured samples, default 15" << '\n'
+			  << "  --warmup=<n>           number of warmup samples, default 3" << '\n'
+			  << "  --min-time-ms=<n>      minimal duration of one sample in milliseconds, default 10" << '\n'
+			  << "  --perf-counters        read hardware performance counters (cycles, instructions, branch misses," << '\n'
+			  << "                         L1 data cache misses) and report them per element, Linux only" << '\n';
+}
+
+bool starts_with(std::string_view str, std::string_view prefix)
+{
+	return str.substr(0, prefix.size()) == prefix;
+}
+} // namespace
+
+int main(int argc, const char** argv)
+{
+	options opts;
+
+	for (int i = 1; i != argc; ++i) {
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+		std::string_view arg = argv[i];
+
+		auto value = [&arg]() {
+			return std::string(arg.substr(arg.find('=') + 1));
+		};
+
+		if (arg == "--help"sv) {
+			print_help();
+			return 0;
+		} else if (arg == "--perf-counters"sv) {
+			opts.perf_counters = true;
+		} else if (arg == "--list"sv) {
+			opts.list = true;
+		} else if (starts_with(arg, "--filter="sv)) {
+			opts.filter = value();
+		} else if (starts_with(arg, "--json-out="sv)) {
+			opts.json_out = value();
+		} else if (starts_with(arg, "--label="sv)) {
+			opts.label = value();
+		} else if (starts_with(arg, "--samples="sv)) {
+			opts.num_samples = std::max(size_t(std::stoul(value())), size_t(1));
+		} else if (starts_with(arg, "--warmup="sv)) {
+			opts.num_warmup_samples = std::stoul(value());
+		} else if (starts_with(arg, "--min-time-ms="sv)) {
+			opts.min_sample_time_ms = std::stod(value());
+		} else {
+			std::cerr << "unknown argument: " << arg << '\n';
+			print_help();
+			return 1;
+		}
+	}
+
+	std::unique_ptr<bench::perf_counters> counters;
+	if (opts.perf_counters && !opts.list) {
+		counters = std::make_unique<bench::perf_counters>();
+		if (!counters->available()) {
+			std::cerr << "hardware performance counters are not available, measuring only time: " << counters->error()
+					  << '\n';
+			counters.reset();
+		}
+	}
+
+	std::vector<result> results;
+
+	for (const auto& s : bench::get_registry()) {
+		for (const auto& b : s.s.get_benchmarks()) {
+			std::string full_name = s.name + "/" + b.name;
+			if (full_name.find(opts.filter) == std::string::npos) {
+				continue;
+			}
+
+			if (opts.list) {
+				std::cout << full_name << '\n';
+				continue;
+			}
+
+			auto r = run(s.name, b, opts, counters.get());
+
+			std::cout << std::left << std::setw(60) << full_name << std::right << std::fixed << std::setprecision(3)
+					  << " median " << std::setw(10) << r.ns.median << " ns"
+					  << "  min " << std::setw(10) << r.ns.min << " ns"
+					  << "  stddev " << std::setw(8) << r.ns.stddev << " ns";
+			if (r.counters.valid) {
+				std::cout << "  cycles " << std::setw(10) << r.counters.cycles << "  IPC " << std::setw(6)
+						  << r.counters.ipc() << "  br-miss " << std::setw(8) << r.counters.branch_misses
+						  << "  L1d-miss " << std::setw(8) << r.counters.l1d_read_misses;
+			}
+			std::cout << std::endl;
+
+			results.push_back(std::move(r));
+		}
+	}
+
+	if (!opts.json_out.empty()) {
+		std::ofstream f(opts.json_out);
+		if (!f) {
+			std::cerr << "could not open file for writing: " << opts.json_out << '\n';
+			return 1;
+		}
+		write_json(f, results, opts, counters != nullptr);
+	}
+
+	return 0;
+}
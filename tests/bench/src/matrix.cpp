@@ -0,0 +1,143 @@
+#include <r4/matrix.hpp>
+
+#include "bench.hpp"
+
+namespace {
+template <typename component_type, size_t num_rows, size_t num_columns>
+r4::matrix<component_type, num_rows, num_columns> make_matrix(bench::random& rnd)
+{
+	r4::matrix<component_type, num_rows, num_columns> ret;
+	for (auto& r : ret) {
+		for (auto& c : r) {
+			c = rnd.get<component_type>(component_type(1), component_type(10));
+		}
+	}
+	return ret;
+}
+
+// affine matrix with rotation block, so that it is invertible and suitable for inv_rigid()
+template <typename component_type>
+r4::matrix4<component_type> make_rigid(bench::random& rnd)
+{
+	r4::matrix4<component_type> ret;
+	ret.set_identity();
+	ret.translate(
+		rnd.get<component_type>(-10, 10), //
+		rnd.get<component_type>(-10, 10),
+		rnd.get<component_type>(-10, 10)
+	);
+	ret.rotate(r4::quaternion<component_type>().set_rotation(
+		r4::vector3<component_type>{
+			rnd.get<component_type>(-1, 1), //
+			rnd.get<component_type>(-1, 1),
+			rnd.get<component_type>(0.1, 1)
+		}
+			.normalize(),
+		rnd.get<component_type>(0, 3)
+	));
+	return ret;
+}
+
+template <typename value_type, typename generator_type, typename operation_type>
+void add(
+	bench::suite& suite,
+	const std::string& name,
+	generator_type gen,
+	operation_type op
+)
+{
+	suite.add(name, [gen, op](size_t num_iterations) {
+		bench::random rnd;
+		value_type a = gen(rnd);
+		value_type b = gen(rnd);
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::do_not_optimize(a);
+			bench::do_not_optimize(b);
+			auto r = op(a, b);
+			bench::do_not_optimize(r);
+		}
+	});
+
+	suite.add(name + "/batched", bench::batch_size, [gen, op](size_t num_iterations) {
+		bench::random rnd;
+		std::vector<value_type> a;
+		std::vector<value_type> b;
+		for (size_t i = 0; i != bench::batch_size; ++i) {
+			a.push_back(gen(rnd));
+			b.push_back(gen(rnd));
+		}
+		std::vector<decltype(op(a.front(), b.front()))> out(a.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != a.size(); ++j) {
+				out[j] = op(a[j], b[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+template <typename component_type, size_t num_rows, size_t num_columns>
+void add_all(bench::suite& suite)
+{
+	using matrix_type = r4::matrix<component_type, num_rows, num_columns>;
+
+	auto gen = [](bench::random& rnd) {
+		return make_matrix<component_type, num_rows, num_columns>(rnd);
+	};
+
+	std::string prefix = "matrix" + std::to_string(num_rows) + "x" + std::to_string(num_columns) + "<" +
+		std::string(bench::type_name<component_type>()) + ">::";
+
+	add<matrix_type>(suite, prefix + "operator*(matrix)", gen, [](const matrix_type& a, const matrix_type& b) {
+		return a * b;
+	});
+	add<matrix_type>(suite, prefix + "operator*(vector)", gen, [](const matrix_type& a, const matrix_type& b) {
+		return a * b[0];
+	});
+	add<matrix_type>(suite, prefix + "det", gen, [](const matrix_type& a, const matrix_type&) {
+		return a.det();
+	});
+
+	if constexpr (num_rows == num_columns) {
+		add<matrix_type>(suite, prefix + "tposed", gen, [](const matrix_type& a, const matrix_type&) {
+			return a.tposed();
+		});
+	}
+
+	if constexpr (std::is_floating_point_v<component_type>) {
+		add<matrix_type>(suite, prefix + "inv", gen, [](const matrix_type& a, const matrix_type&) {
+			return a.inv();
+		});
+	}
+
+	if constexpr (std::is_floating_point_v<component_type> && num_rows == 4) {
+		auto rigid_gen = [](bench::random& rnd) {
+			return make_rigid<component_type>(rnd);
+		};
+		add<matrix_type>(suite, prefix + "inv_affine", rigid_gen, [](const matrix_type& a, const matrix_type&) {
+			return a.inv_affine();
+		});
+		add<matrix_type>(suite, prefix + "inv_rigid", rigid_gen, [](const matrix_type& a, const matrix_type&) {
+			return a.inv_rigid();
+		});
+		add<matrix_type>(suite, prefix + "rotate(quaternion)", rigid_gen, [](matrix_type a, const matrix_type&) {
+			return a.rotate(r4::quaternion<component_type>(0, 0, component_type(0.6), component_type(0.8)));
+		});
+	}
+}
+
+template <typename component_type>
+void add_all_sizes(bench::suite& suite)
+{
+	add_all<component_type, 2, 3>(suite);
+	add_all<component_type, 3, 3>(suite);
+	add_all<component_type, 4, 4>(suite);
+}
+
+const bench::set set("matrix", [](bench::suite& suite) {
+	add_all_sizes<float>(suite);
+	add_all_sizes<double>(suite);
+	add_all_sizes<int>(suite);
+});
+} // namespace
@@ -0,0 +1,87 @@
+#include <r4/normal_encoding.hpp>
+
+#include "bench.hpp"
+
+namespace {
+std::vector<r4::vector3<float>> make_normals()
+{
+	bench::random rnd;
+	std::vector<r4::vector3<float>> ret;
+	for (size_t i = 0; i != bench::batch_size; ++i) {
+		r4::vector3<float> v(
+			rnd.get<float>(-1, 1), //
+			rnd.get<float>(-1, 1),
+			rnd.get<float>(-1, 1)
+		);
+		ret.push_back(v.normalize());
+	}
+	return ret;
+}
+
+template <typename encoding_type>
+void add_all(bench::suite& suite, std::string_view encoding_name)
+{
+	using encoded_type = typename encoding_type::encoded_type;
+
+	std::string suffix = "<" + std::string(encoding_name) + ">";
+
+	// one normal at a time, to compare with the batched forms
+
+	suite.add("encode_normal" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto in = make_normals();
+		std::vector<encoded_type> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != in.size(); ++j) {
+				out[j] = r4::encode_normal<encoding_type>(in[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add("encode_normals" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto in = make_normals();
+		std::vector<encoded_type> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::encode_normals<encoding_type>(utki::make_span(in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add("decode_normal" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto normals = make_normals();
+		std::vector<encoded_type> in(normals.size());
+		r4::encode_normals<encoding_type>(utki::make_span(normals), utki::make_span(in));
+		std::vector<r4::vector3<float>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != in.size(); ++j) {
+				out[j] = r4::decode_normal<encoding_type>(in[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add("decode_normals" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto normals = make_normals();
+		std::vector<encoded_type> in(normals.size());
+		r4::encode_normals<encoding_type>(utki::make_span(normals), utki::make_span(in));
+		const auto& const_in = in;
+		std::vector<r4::vector3<float>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::decode_normals<encoding_type>(utki::make_span(const_in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+const bench::set set("normal_encoding", [](bench::suite& suite) {
+	add_all<r4::normal_encoding::octahedral16>(suite, "octahedral16");
+	add_all<r4::normal_encoding::octahedral8>(suite, "octahedral8");
+	add_all<r4::normal_encoding::unorm_10_10_10_2>(suite, "unorm_10_10_10_2");
+	add_all<r4::normal_encoding::snorm_10_10_10_2>(suite, "snorm_10_10_10_2");
+	add_all<r4::normal_encoding::snorm16>(suite, "snorm16");
+});
+} // namespace
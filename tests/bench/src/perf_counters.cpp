@@ -0,0 +1,123 @@
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <utki/config.hpp>
+
+#if CFG_OS == CFG_OS_LINUX
+#	include <cerrno>
+#	include <cstring>
+
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+using namespace bench;
+
+#if CFG_OS == CFG_OS_LINUX
+
+namespace {
+int open_counter(uint32_t type, uint64_t config, int group_fd)
+{
+	perf_event_attr attr{};
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = group_fd == -1 ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+	return int(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+} // namespace
+
+perf_counters::perf_counters()
+{
+	this->fds.fill(-1);
+
+	const std::array<std::pair<uint32_t, uint64_t>, size_t(counter::enum_size)> configs = {
+		{
+         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+         {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+         {PERF_TYPE_HW_CACHE,
+			 PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}, //
+		}
+    };
+
+	for (size_t i = 0; i != configs.size(); ++i) {
+		this->fds[i] = open_counter(configs[i].first, configs[i].second, this->fds.front());
+		if (this->fds[i] == -1) {
+			this->error_message = std::string("perf_event_open() failed: ") + std::strerror(errno);
+			return;
+		}
+	}
+
+	this->is_available = true;
+}
+
+perf_counters::~perf_counters()
+{
+	for (auto fd : this->fds) {
+		if (fd != -1) {
+			close(fd);
+		}
+	}
+}
+
+void perf_counters::start() noexcept
+{
+	if (!this->is_available) {
+		return;
+	}
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+	ioctl(this->fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+	ioctl(this->fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+std::optional<perf_counters::values_type> perf_counters::stop() noexcept
+{
+	if (!this->is_available) {
+		return std::nullopt;
+	}
+
+	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+	ioctl(this->fds.front(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	// with PERF_FORMAT_GROUP the read data is: number of counters followed by the counter values
+	std::array<uint64_t, size_t(counter::enum_size) + 1> buf{};
+	if (read(this->fds.front(), buf.data(), sizeof(buf)) != ssize_t(sizeof(buf)) || buf.front() != size_t(counter::enum_size)) {
+		return std::nullopt;
+	}
+
+	values_type ret{};
+	std::copy(std::next(buf.begin()), buf.end(), ret.begin());
+
+	return ret;
+}
+
+#else
+
+perf_counters::perf_counters()
+{
+	this->fds.fill(-1);
+	this->error_message = "hardware performance counters are only supported on Linux";
+}
+
+perf_counters::~perf_counters() = default;
+
+void perf_counters::start() noexcept {}
+
+std::optional<perf_counters::values_type> perf_counters::stop() noexcept
+{
+	return std::nullopt;
+}
+
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace bench {
+
+/**
+ * @brief Hardware performance counters.
+ * Reads CPU cycles, retired instructions, branch misses and L1 data cache read misses
+ * using Linux perf_event_open() system call. On other systems, or if the system does not permit
+ * access to the counters (see /proc/sys/kernel/perf_event_paranoid), the counters are not available.
+ */
+class perf_counters
+{
+public:
+	enum class counter {
+		cycles,
+		instructions,
+		branch_misses,
+		l1d_read_misses,
+
+		enum_size
+	};
+
+	using values_type = std::array<uint64_t, size_t(counter::enum_size)>;
+
+private:
+	// group leader descriptor is the first one
+	std::array<int, size_t(counter::enum_size)> fds;
+
+	bool is_available = false;
+
+	std::string error_message;
+
+public:
+	perf_counters();
+
+	perf_counters(const perf_counters&) = delete;
+	perf_counters& operator=(const perf_counters&) = delete;
+
+	perf_counters(perf_counters&&) = delete;
+	perf_counters& operator=(perf_counters&&) = delete;
+
+	~perf_counters();
+
+	/**
+	 * @brief Check if the counters could be opened.
+	 * @return true if the counters are available.
+	 */
+	bool available() const noexcept
+	{
+		return this->is_available;
+	}
+
+	/**
+	 * @brief Get reason why the counters are not available.
+	 * @return error description.
+	 */
+	const std::string& error() const noexcept
+	{
+		return this->error_message;
+	}
+
+	/**
+	 * @brief Reset and start counting.
+	 */
+	void start() noexcept;
+
+	/**
+	 * @brief Stop counting and read the values.
+	 * @return counted values since last start().
+	 * @return empty optional if the counters are not available or could not be read.
+	 */
+	std::optional<values_type> stop() noexcept;
+};
+
+} // namespace bench
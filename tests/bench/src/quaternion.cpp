@@ -0,0 +1,129 @@
+#include <r4/quaternion.hpp>
+#include <r4/slerp.hpp>
+
+#include "bench.hpp"
+
+namespace {
+template <typename component_type>
+r4::quaternion<component_type> make_quaternion(bench::random& rnd)
+{
+	return r4::quaternion<component_type>(
+			   r4::vector3<component_type>{
+				   rnd.get<component_type>(-1, 1), //
+				   rnd.get<component_type>(-1, 1),
+				   rnd.get<component_type>(-1, 1)
+			   },
+			   rnd.get<component_type>(-1, 1)
+	)
+		.normalize();
+}
+
+template <typename component_type>
+std::vector<r4::quaternion<component_type>> make_quaternions(size_t size, uint32_t seed)
+{
+	bench::random rnd(seed);
+	std::vector<r4::quaternion<component_type>> ret;
+	for (size_t i = 0; i != size; ++i) {
+		ret.push_back(make_quaternion<component_type>(rnd));
+	}
+	return ret;
+}
+
+template <typename component_type, typename operation_type>
+void add(bench::suite& suite, std::string_view op_name, operation_type op)
+{
+	using quaternion_type = r4::quaternion<component_type>;
+
+	std::string name =
+		"quaternion<" + std::string(bench::type_name<component_type>()) + ">::" + std::string(op_name);
+
+	suite.add(name, [op](size_t num_iterations) {
+		bench::random rnd;
+		auto a = make_quaternion<component_type>(rnd);
+		auto b = make_quaternion<component_type>(rnd);
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::do_not_optimize(a);
+			bench::do_not_optimize(b);
+			auto r = op(a, b);
+			bench::do_not_optimize(r);
+		}
+	});
+
+	suite.add(name + "/batched", bench::batch_size, [op](size_t num_iterations) {
+		auto a = make_quaternions<component_type>(bench::batch_size, 1);
+		auto b = make_quaternions<component_type>(bench::batch_size, 2);
+		std::vector<decltype(op(std::declval<quaternion_type>(), std::declval<quaternion_type>()))> out(a.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != a.size(); ++j) {
+				out[j] = op(a[j], b[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+template <typename component_type>
+void add_batched_slerp(bench::suite& suite, std::string_view mode_name, r4::slerp_accuracy accuracy)
+{
+	std::string name = "slerp(span)<" + std::string(bench::type_name<component_type>()) + ">/" + std::string(mode_name);
+
+	suite.add(name, bench::batch_size, [accuracy](size_t num_iterations) {
+		const auto a = make_quaternions<component_type>(bench::batch_size, 1);
+		const auto b = make_quaternions<component_type>(bench::batch_size, 2);
+
+		bench::random rnd;
+		std::vector<component_type> t;
+		for (size_t i = 0; i != a.size(); ++i) {
+			t.push_back(rnd.get<component_type>(0, 1));
+		}
+
+		std::vector<r4::quaternion<component_type>> out(a.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::slerp(
+				utki::make_span(a),
+				utki::make_span(b),
+				utki::make_span(std::as_const(t)),
+				utki::make_span(out),
+				accuracy
+			);
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+template <typename component_type>
+void add_all(bench::suite& suite)
+{
+	using quaternion_type = r4::quaternion<component_type>;
+
+	add<component_type>(suite, "operator*", [](const quaternion_type& a, const quaternion_type& b) {
+		return a * b;
+	});
+	add<component_type>(suite, "dot", [](const quaternion_type& a, const quaternion_type& b) {
+		return a.dot(b);
+	});
+	add<component_type>(suite, "normalize", [](quaternion_type a, const quaternion_type&) {
+		return a.normalize();
+	});
+	add<component_type>(suite, "rot", [](const quaternion_type& a, const quaternion_type& b) {
+		return a.rot(b.v);
+	});
+	add<component_type>(suite, "slerp", [](const quaternion_type& a, const quaternion_type& b) {
+		return a.slerp(b, component_type(0.3));
+	});
+	add<component_type>(suite, "to_matrix4", [](const quaternion_type& a, const quaternion_type&) {
+		return r4::matrix4<component_type>(a);
+	});
+
+	add_batched_slerp<component_type>(suite, "exact", r4::slerp_accuracy::exact);
+	add_batched_slerp<component_type>(suite, "corrected_nlerp", r4::slerp_accuracy::corrected_nlerp);
+	add_batched_slerp<component_type>(suite, "nlerp", r4::slerp_accuracy::nlerp);
+}
+
+const bench::set set("quaternion", [](bench::suite& suite) {
+	add_all<float>(suite);
+	add_all<double>(suite);
+});
+} // namespace
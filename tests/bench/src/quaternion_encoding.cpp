@@ -0,0 +1,73 @@
+#include <r4/quaternion_encoding.hpp>
+
+#include "bench.hpp"
+
+namespace {
+std::vector<r4::quaternion<float>> make_quaternions()
+{
+	bench::random rnd;
+	std::vector<r4::quaternion<float>> ret;
+	for (size_t i = 0; i != bench::batch_size; ++i) {
+		r4::quaternion<float> q(
+			rnd.get<float>(-1, 1), //
+			rnd.get<float>(-1, 1),
+			rnd.get<float>(-1, 1),
+			rnd.get<float>(-1, 1)
+		);
+		ret.push_back(q.normalize());
+	}
+	return ret;
+}
+
+template <typename encoding_type>
+void add_all(bench::suite& suite, std::string_view encoding_name)
+{
+	using encoded_type = typename encoding_type::encoded_type;
+
+	std::string suffix = "<" + std::string(encoding_name) + ">";
+
+	suite.add("compress_quaternions" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto in = make_quaternions();
+		std::vector<encoded_type> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::compress_quaternions<encoding_type>(utki::make_span(in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	// one quaternion at a time, to compare with the batched form
+
+	suite.add("decompress_quaternion" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto quaternions = make_quaternions();
+		std::vector<encoded_type> in(quaternions.size());
+		r4::compress_quaternions<encoding_type>(utki::make_span(quaternions), utki::make_span(in));
+		std::vector<r4::quaternion<float>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != in.size(); ++j) {
+				out[j] = r4::decompress_quaternion<encoding_type>(in[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add("decompress_quaternions" + suffix, bench::batch_size, [](size_t num_iterations) {
+		const auto quaternions = make_quaternions();
+		std::vector<encoded_type> in(quaternions.size());
+		r4::compress_quaternions<encoding_type>(utki::make_span(quaternions), utki::make_span(in));
+		const auto& const_in = in;
+		std::vector<r4::quaternion<float>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::decompress_quaternions<encoding_type>(utki::make_span(const_in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+const bench::set set("quaternion_encoding", [](bench::suite& suite) {
+	add_all<r4::quaternion_encoding::smallest_three32>(suite, "smallest_three32");
+	add_all<r4::quaternion_encoding::smallest_three48>(suite, "smallest_three48");
+});
+} // namespace
@@ -0,0 +1,135 @@
+#include <r4/rectangle.hpp>
+#include <r4/rounding.hpp>
+#include <r4/segment2.hpp>
+
+#include "bench.hpp"
+
+namespace {
+template <typename value_type, typename generator_type, typename operation_type>
+void add(bench::suite& suite, const std::string& name, generator_type gen, operation_type op)
+{
+	suite.add(name, [gen, op](size_t num_iterations) {
+		bench::random rnd;
+		value_type a = gen(rnd);
+		value_type b = gen(rnd);
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::do_not_optimize(a);
+			bench::do_not_optimize(b);
+			auto r = op(a, b);
+			bench::do_not_optimize(r);
+		}
+	});
+
+	suite.add(name + "/batched", bench::batch_size, [gen, op](size_t num_iterations) {
+		bench::random rnd;
+		std::vector<value_type> a;
+		std::vector<value_type> b;
+		for (size_t i = 0; i != bench::batch_size; ++i) {
+			a.push_back(gen(rnd));
+			b.push_back(gen(rnd));
+		}
+		std::vector<decltype(op(a.front(), b.front()))> out(a.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != a.size(); ++j) {
+				out[j] = op(a[j], b[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+template <typename component_type>
+void add_all(bench::suite& suite)
+{
+	using rectangle_type = r4::rectangle<component_type>;
+	using segment_type = r4::segment2<component_type>;
+
+	auto gen = [](bench::random& rnd) {
+		return rectangle_type(
+			rnd.get<component_type>(-100, 100),
+			rnd.get<component_type>(-100, 100),
+			rnd.get<component_type>(1, 200),
+			rnd.get<component_type>(1, 200)
+		);
+	};
+
+	std::string prefix = "rectangle<" + std::string(bench::type_name<component_type>()) + ">::";
+
+	add<rectangle_type>(suite, prefix + "intersect", gen, [](rectangle_type a, const rectangle_type& b) {
+		return a.intersect(b);
+	});
+	add<rectangle_type>(suite, prefix + "unite", gen, [](rectangle_type a, const rectangle_type& b) {
+		return a.unite(b);
+	});
+	add<rectangle_type>(suite, prefix + "overlaps", gen, [](const rectangle_type& a, const rectangle_type& b) {
+		return a.overlaps(b.p);
+	});
+	add<rectangle_type>(suite, prefix + "contains", gen, [](const rectangle_type& a, const rectangle_type& b) {
+		return a.contains(b);
+	});
+
+	auto seg_gen = [](bench::random& rnd) {
+		return segment_type{
+			r4::vector2<component_type>{rnd.get<component_type>(-100, 100), rnd.get<component_type>(-100, 100)},
+			r4::vector2<component_type>{rnd.get<component_type>(-100, 100), rnd.get<component_type>(-100, 100)}
+		};
+	};
+
+	add<segment_type>(
+		suite,
+		"segment2<" + std::string(bench::type_name<component_type>()) + ">::unite",
+		seg_gen,
+		[](segment_type a, const segment_type& b) {
+			return a.unite(b);
+		}
+	);
+}
+
+// pixel snapping of rectangles, compared to rounding components one by one with std::round()
+void add_rounding(bench::suite& suite)
+{
+	using rectangle_type = r4::rectangle<float>;
+
+	auto gen = [](bench::random& rnd) {
+		return rectangle_type(
+			rnd.get<float>(-1000, 1000),
+			rnd.get<float>(-1000, 1000),
+			rnd.get<float>(1, 2000),
+			rnd.get<float>(1, 2000)
+		);
+	};
+
+	add<rectangle_type>(suite, "rectangle<float>::round_to_int", gen, [](const rectangle_type& a, const rectangle_type&) {
+		return r4::rectangle<int>(round(a.p).to<int>(), round(a.d).to<int>());
+	});
+	add<rectangle_type>(suite, "rectangle<float>::to_rounded<int>", gen, [](const rectangle_type& a, const rectangle_type&) {
+		return a.to_rounded<int>();
+	});
+	add<rectangle_type>(suite, "rectangle<float>::to_floored<int>", gen, [](const rectangle_type& a, const rectangle_type&) {
+		return a.to_floored<int>();
+	});
+
+	suite.add("to_rounded(span<rectangle<float>>)", bench::batch_size, [gen](size_t num_iterations) {
+		bench::random rnd;
+		std::vector<rectangle_type> in;
+		for (size_t i = 0; i != bench::batch_size; ++i) {
+			in.push_back(gen(rnd));
+		}
+		const auto& const_in = in;
+		std::vector<r4::rectangle<int>> out(in.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			r4::to_rounded(utki::make_span(const_in), utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+}
+
+const bench::set set("rectangle", [](bench::suite& suite) {
+	add_all<float>(suite);
+	add_all<double>(suite);
+	add_all<int>(suite);
+	add_rounding(suite);
+});
+} // namespace
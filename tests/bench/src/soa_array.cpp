@@ -0,0 +1,94 @@
+#include <r4/lazy.hpp>
+#include <r4/soa_array.hpp>
+
+#include "bench.hpp"
+
+namespace {
+template <typename component_type>
+r4::soa_array3<component_type> make_array(uint32_t seed)
+{
+	bench::random rnd(seed);
+	r4::soa_array3<component_type> ret;
+	for (size_t i = 0; i != bench::batch_size; ++i) {
+		ret.push_back(r4::vector3<component_type>{
+			rnd.get<component_type>(1, 100), //
+			rnd.get<component_type>(1, 100),
+			rnd.get<component_type>(1, 100)
+		});
+	}
+	return ret;
+}
+
+template <typename component_type>
+void add_all(bench::suite& suite)
+{
+	std::string prefix = "soa_array3<" + std::string(bench::type_name<component_type>()) + ">::";
+
+	suite.add(prefix + "dot", bench::batch_size, [](size_t num_iterations) {
+		auto a = make_array<component_type>(1);
+		auto b = make_array<component_type>(2);
+		std::vector<component_type> out(a.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			a.dot(b, utki::make_span(out));
+			bench::do_not_optimize(out.front());
+		}
+	});
+
+	suite.add(prefix + "lerp", bench::batch_size, [](size_t num_iterations) {
+		auto a = make_array<component_type>(1);
+		auto b = make_array<component_type>(2);
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			a.lerp(b, component_type(0));
+			bench::do_not_optimize(a.stream(0)[0]);
+		}
+	});
+
+	if constexpr (std::is_floating_point_v<component_type>) {
+		suite.add(prefix + "normalize", bench::batch_size, [](size_t num_iterations) {
+			auto a = make_array<component_type>(1);
+			for (size_t i = 0; i != num_iterations; ++i) {
+				bench::clobber_memory();
+				a.normalize();
+				bench::do_not_optimize(a.stream(0)[0]);
+			}
+		});
+	}
+
+	// lazy expressions compared to regular vector arithmetic
+	std::string lazy_prefix = "vector3<" + std::string(bench::type_name<component_type>()) + ">::";
+
+	suite.add(lazy_prefix + "a*s+b-c", bench::batch_size, [](size_t num_iterations) {
+		auto a = make_array<component_type>(1);
+		std::vector<r4::vector3<component_type>> v(a.size());
+		a.to_aos(utki::make_span(v));
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 1; j != v.size(); ++j) {
+				v[j] = v[j] * component_type(1) + v[j - 1] - v[j - 1];
+			}
+			bench::do_not_optimize(v.back());
+		}
+	});
+
+	suite.add(lazy_prefix + "a*s+b-c/lazy", bench::batch_size, [](size_t num_iterations) {
+		auto a = make_array<component_type>(1);
+		std::vector<r4::vector3<component_type>> v(a.size());
+		a.to_aos(utki::make_span(v));
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 1; j != v.size(); ++j) {
+				v[j] = r4::lazy(v[j]) * component_type(1) + v[j - 1] - v[j - 1];
+			}
+			bench::do_not_optimize(v.back());
+		}
+	});
+}
+
+const bench::set set("soa_array", [](bench::suite& suite) {
+	add_all<float>(suite);
+	add_all<double>(suite);
+	add_all<int>(suite);
+});
+} // namespace
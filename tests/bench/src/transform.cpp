@@ -0,0 +1,117 @@
+#include <r4/affine3.hpp>
+#include <r4/transform.hpp>
+
+#include "bench.hpp"
+
+namespace {
+template <typename component_type>
+r4::matrix4<component_type> make_transform(bench::random& rnd)
+{
+	r4::matrix4<component_type> ret;
+	ret.set_identity();
+	ret.translate(rnd.get<component_type>(-10, 10), rnd.get<component_type>(-10, 10), rnd.get<component_type>(-10, 10));
+	ret.scale(rnd.get<component_type>(1, 3), rnd.get<component_type>(1, 3), rnd.get<component_type>(1, 3));
+	return ret;
+}
+
+template <typename component_type>
+std::vector<r4::vector3<component_type>> make_points(size_t size)
+{
+	bench::random rnd;
+	std::vector<r4::vector3<component_type>> ret;
+	for (size_t i = 0; i != size; ++i) {
+		ret.emplace_back(
+			rnd.get<component_type>(-100, 100), //
+			rnd.get<component_type>(-100, 100),
+			rnd.get<component_type>(-100, 100)
+		);
+	}
+	return ret;
+}
+
+template <typename component_type, typename function_type>
+void add_span(bench::suite& suite, std::string_view func_name, function_type func)
+{
+	suite.add(
+		std::string(func_name) + "<" + std::string(bench::type_name<component_type>()) + ">",
+		bench::batch_size,
+		[func](size_t num_iterations) {
+			bench::random rnd;
+			auto m = make_transform<component_type>(rnd);
+			const auto in = make_points<component_type>(bench::batch_size);
+			std::vector<r4::vector3<component_type>> out(in.size());
+			for (size_t i = 0; i != num_iterations; ++i) {
+				bench::clobber_memory();
+				func(m, utki::make_span(in), utki::make_span(out));
+				bench::do_not_optimize(out.front());
+			}
+		}
+	);
+}
+
+template <typename component_type>
+void add_all(bench::suite& suite)
+{
+	using span_type = utki::span<r4::vector3<component_type>>;
+	using const_span_type = utki::span<const r4::vector3<component_type>>;
+	using matrix_type = r4::matrix4<component_type>;
+
+	add_span<component_type>(suite, "transform_points", [](const matrix_type& m, const_span_type in, span_type out) {
+		r4::transform_points(m, in, out);
+	});
+	add_span<component_type>(suite, "transform_directions", [](const matrix_type& m, const_span_type in, span_type out) {
+		r4::transform_directions(m, in, out);
+	});
+	add_span<component_type>(suite, "transform_homogeneous", [](const matrix_type& m, const_span_type in, span_type out) {
+		r4::transform_homogeneous(m, in, out);
+	});
+
+	// same as transform_points, but with per-point operator*, for comparison
+	add_span<component_type>(suite, "matrix4::operator*(vector3)", [](const matrix_type& m, const_span_type in, span_type out) {
+		auto o = out.begin();
+		for (const auto& p : in) {
+			*o = m * p;
+			++o;
+		}
+	});
+
+	add_span<component_type>(suite, "affine3::transform_point", [](const matrix_type& m, const_span_type in, span_type out) {
+		r4::affine3<component_type> a(m);
+		auto o = out.begin();
+		for (const auto& p : in) {
+			*o = a.transform_point(p);
+			++o;
+		}
+	});
+
+	std::string prefix = "affine3<" + std::string(bench::type_name<component_type>()) + ">::";
+
+	suite.add(prefix + "operator*(affine3)", [](size_t num_iterations) {
+		bench::random rnd;
+		r4::affine3<component_type> a(make_transform<component_type>(rnd));
+		r4::affine3<component_type> b(make_transform<component_type>(rnd));
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::do_not_optimize(a);
+			bench::do_not_optimize(b);
+			auto r = a * b;
+			bench::do_not_optimize(r);
+		}
+	});
+
+	suite.add(prefix + "inv_affine", [](size_t num_iterations) {
+		bench::random rnd;
+		r4::affine3<component_type> a(make_transform<component_type>(rnd));
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::do_not_optimize(a);
+			auto r = a.inv_affine();
+			bench::do_not_optimize(r);
+		}
+	});
+}
+
+const bench::set set("transform", [](bench::suite& suite) {
+	add_all<float>(suite);
+	add_all<double>(suite);
+	add_all<int>(suite);
+});
+} // namespace
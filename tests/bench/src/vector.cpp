@@ -0,0 +1,156 @@
+#include <r4/fixed.hpp>
+#include <r4/vector.hpp>
+#include <r4/vector3a.hpp>
+
+#include "bench.hpp"
+
+namespace {
+template <typename vector_type>
+vector_type make_vector(bench::random& rnd)
+{
+	using component_type = typename vector_type::value_type;
+
+	vector_type ret{};
+	for (auto& c : ret) {
+		if constexpr (std::is_arithmetic_v<component_type>) {
+			c = rnd.get<component_type>(component_type(1), component_type(100));
+		} else {
+			// fixed point, the values are small enough for the dot products to stay in range
+			c = component_type(rnd.get<double>(1, 10));
+		}
+	}
+	return ret;
+}
+
+template <typename vector_type>
+std::vector<vector_type> make_vectors(size_t size, uint32_t seed)
+{
+	bench::random rnd(seed);
+	std::vector<vector_type> ret;
+	for (size_t i = 0; i != size; ++i) {
+		ret.push_back(make_vector<vector_type>(rnd));
+	}
+	return ret;
+}
+
+// single binary operation on two vectors
+template <typename vector_type, typename operation_type>
+bench::function_type single(operation_type op)
+{
+	return [op](size_t num_iterations) {
+		bench::random rnd;
+		auto a = make_vector<vector_type>(rnd);
+		auto b = make_vector<vector_type>(rnd);
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::do_not_optimize(a);
+			bench::do_not_optimize(b);
+			auto r = op(a, b);
+			bench::do_not_optimize(r);
+		}
+	};
+}
+
+// binary operation on arrays of vectors
+template <typename vector_type, typename operation_type>
+bench::function_type batched(operation_type op)
+{
+	return [op](size_t num_iterations) {
+		auto a = make_vectors<vector_type>(bench::batch_size, 1);
+		auto b = make_vectors<vector_type>(bench::batch_size, 2);
+		using result_type = decltype(op(a.front(), b.front()));
+		std::vector<result_type> out(a.size());
+		for (size_t i = 0; i != num_iterations; ++i) {
+			bench::clobber_memory();
+			for (size_t j = 0; j != a.size(); ++j) {
+				out[j] = op(a[j], b[j]);
+			}
+			bench::do_not_optimize(out.front());
+		}
+	};
+}
+
+template <typename vector_type, typename operation_type>
+void add(bench::suite& suite, std::string_view type_name, std::string_view op_name, operation_type op)
+{
+	std::string name = std::string(type_name) + "::" + std::string(op_name);
+
+	suite.add(name, single<vector_type>(op));
+	suite.add(name + "/batched", bench::batch_size, batched<vector_type>(op));
+}
+
+// vector_type is either r4::vector or r4::vector3a
+template <typename vector_type, size_t dimension>
+void add_all(bench::suite& suite, std::string_view type_name)
+{
+	using component_type = typename vector_type::value_type;
+
+	add<vector_type>(suite, type_name, "operator+", [](const vector_type& a, const vector_type& b) {
+		return a + b;
+	});
+	add<vector_type>(suite, type_name, "operator*(number)", [](const vector_type& a, const vector_type& b) {
+		return a * b[0];
+	});
+	add<vector_type>(suite, type_name, "dot", [](const vector_type& a, const vector_type& b) {
+		return a.dot(b);
+	});
+	add<vector_type>(suite, type_name, "comp_mul", [](const vector_type& a, const vector_type& b) {
+		return a.comp_mul(b);
+	});
+	add<vector_type>(suite, type_name, "min", [](const vector_type& a, const vector_type& b) {
+		return min(a, b);
+	});
+	add<vector_type>(suite, type_name, "norm_pow2", [](const vector_type& a, const vector_type&) {
+		return a.norm_pow2();
+	});
+	add<vector_type>(suite, type_name, "sum", [](const vector_type& a, const vector_type&) {
+		return a.sum();
+	});
+
+	if constexpr (dimension == 3) {
+		add<vector_type>(suite, type_name, "cross", [](const vector_type& a, const vector_type& b) {
+			return a.cross(b);
+		});
+	}
+
+	if constexpr (std::is_floating_point_v<component_type>) {
+		add<vector_type>(suite, type_name, "norm", [](const vector_type& a, const vector_type&) {
+			return a.norm();
+		});
+		add<vector_type>(suite, type_name, "normalize", [](vector_type a, const vector_type&) {
+			return a.normalize();
+		});
+	}
+}
+
+template <typename component_type, size_t dimension>
+void add_all(bench::suite& suite)
+{
+	add_all<r4::vector<component_type, dimension>, dimension>(
+		suite,
+		"vector" + std::to_string(dimension) + "<" + std::string(bench::type_name<component_type>()) + ">"
+	);
+}
+
+template <typename component_type>
+void add_all_dimensions(bench::suite& suite)
+{
+	add_all<component_type, 2>(suite);
+	add_all<component_type, 3>(suite);
+	add_all<component_type, 4>(suite);
+
+	// padded 3d vector, to compare with vector3
+	add_all<r4::vector3a<component_type>, 3>(
+		suite,
+		"vector3a<" + std::string(bench::type_name<component_type>()) + ">"
+	);
+}
+
+const bench::set set("vector", [](bench::suite& suite) {
+	add_all_dimensions<float>(suite);
+	add_all<float, 8>(suite);
+	add_all<float, 16>(suite);
+	add_all_dimensions<double>(suite);
+	add_all_dimensions<int>(suite);
+	add_all<r4::vector4<r4::fixed<16, 16>>, 4>(suite, "vector4<fixed<16,16>>");
+});
+} // namespace
@@ -0,0 +1,43 @@
+#!/bin/bash
+
+# Measure compile time of r4 headers instantiation with different C++ standards.
+# In C++20 the methods of r4::vector and r4::matrix are constrained with requires-clauses,
+# in C++17 the same methods are enable_if-gated member templates.
+#
+# usage: run.sh [number of runs]
+# environment variables:
+#   CXX - compiler to use, default is g++
+#   CXXFLAGS - additional compiler flags
+
+set -eo pipefail
+
+script_dir=$(dirname "$0")
+num_runs=${1:-5}
+cxx=${CXX:-g++}
+
+src=${script_dir}/src/instantiate.cpp
+include_dir=${script_dir}/../../src
+
+TIMEFORMAT=%R
+
+# print best compile time of several runs, the arguments are passed to the compiler
+function measure {
+	local best=
+	for ((i = 0; i != num_runs; ++i)); do
+		# shellcheck disable=SC2086
+		local t=$( { time ${cxx} ${CXXFLAGS} -isystem "${include_dir}" -c "${src}" -o /dev/null "$@" ; } 2>&1 )
+		if [ -z "${best}" ] || awk "BEGIN{exit !(${t} < ${best})}"; then
+			best=${t}
+		fi
+	done
+	echo "${best}"
+}
+
+# the headers only time is subtracted to exclude parsing of the standard library headers,
+# which is different for different standards
+for std in c++17 c++20; do
+	headers=$(measure -std=${std} -DHEADERS_ONLY)
+	full=$(measure -std=${std})
+	instantiation=$(awk "BEGIN{print ${full} - ${headers}}")
+	echo "${std}: headers ${headers} s, total ${full} s, instantiation ${instantiation} s (best of ${num_runs} runs)"
+done
@@ -0,0 +1,96 @@
+// This translation unit is not linked anywhere, it is only compiled by the run.sh script
+// to measure the cost of instantiating r4 templates.
+// With HEADERS_ONLY macro defined only the headers are parsed, which gives the baseline.
+
+#include <r4/matrix.hpp>
+#include <r4/quaternion.hpp>
+#include <r4/vector.hpp>
+
+#ifndef HEADERS_ONLY
+
+namespace {
+
+template <typename component_type, size_t dimension>
+component_type use_vector()
+{
+	using vec = r4::vector<component_type, dimension>;
+
+	vec a(component_type(1));
+	vec b = a * component_type(2) + a;
+
+	auto ret = a * b + a.x();
+	if constexpr (dimension >= 2) {
+		ret += a.y() + b.g();
+	}
+	if constexpr (dimension >= 3) {
+		ret += a.z() + b.b();
+		ret += a.cross(b).x();
+		ret += vec(r4::vector<component_type, 2>(a.x(), a.y()), a.z()).x();
+	}
+	if constexpr (dimension == 4) {
+		ret += a.w() + b.a();
+	}
+	if constexpr (dimension == 2) {
+		ret += a.cross(b);
+		ret += a.rot(component_type(1)).x();
+	}
+
+	b.set(component_type(3));
+	ret += b.norm_pow2();
+
+	return ret;
+}
+
+template <typename component_type, size_t num_rows, size_t num_columns>
+component_type use_matrix()
+{
+	using mat = r4::matrix<component_type, num_rows, num_columns>;
+
+	mat m;
+	m.set_identity();
+	m.scale(component_type(2));
+	m.translate(component_type(1), component_type(2));
+
+	auto n = m * m;
+	n *= m;
+	n.left_mul(m);
+
+	auto ret = n.det() + n.inv()[0][0] + n.inv_det().second;
+
+	if constexpr (num_rows == num_columns) {
+		ret += n.minor(0, 0) + n.remove(0, 0)[0][0];
+		r4::quaternion<component_type> q(r4::vector<component_type, 3>(component_type(1)));
+		n.rotate(q);
+		ret += mat(q)[0][0];
+	} else {
+		n.rotate(component_type(1));
+		ret += (n * r4::vector<component_type, 2>(component_type(1)))[0];
+	}
+
+	if constexpr (num_rows == 4) {
+		n.translate(component_type(1), component_type(2), component_type(3));
+		n.frustum(-1, 1, -1, 1, 1, 10);
+		n.perspective(component_type(1), component_type(1), component_type(1), component_type(10));
+		n.look_at({1, 2, 3}, {0, 0, 0}, {0, 1, 0});
+		ret += (n * r4::vector<component_type, 3>(component_type(1)))[0];
+		ret += n.inv_affine()[0][0] + n.inv_rigid()[0][0];
+	}
+
+	return ret;
+}
+
+template <typename component_type>
+component_type use_all()
+{
+	return use_vector<component_type, 2>() + use_vector<component_type, 3>() + use_vector<component_type, 4>() +
+		use_matrix<component_type, 2, 3>() + use_matrix<component_type, 3, 3>() + use_matrix<component_type, 4, 4>();
+}
+
+} // namespace
+
+double instantiate()
+{
+	return double(use_all<float>()) + double(use_all<double>()) + double(use_all<long double>());
+}
+
+#endif
@@ -0,0 +1,168 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/affine3.hpp"
+#include "../../../src/r4/io.hpp"
+
+// declare templates to instantiate all template methods to include all methods to gcov coverage
+template class r4::affine3<float>;
+
+namespace{
+r4::matrix4<float> make_matrix(){
+	r4::matrix4<float> m;
+	m.set_identity();
+	m.translate(3, -4, 5);
+	m.rotate(r4::quaternion<float>().set_rotation(r4::vector3<float>{1, 2, 3}.normalize(), 0.7f));
+	m.scale(2, 3, 0.5f);
+	return m;
+}
+
+r4::affine3<float> make_affine(){
+	r4::affine3<float> a;
+	a.set_identity();
+	a.translate(3, -4, 5);
+	a.rotate(r4::quaternion<float>().set_rotation(r4::vector3<float>{1, 2, 3}.normalize(), 0.7f));
+	a.scale(2, 3, 0.5f);
+	return a;
+}
+
+const tst::set set("affine3", [](tst::suite& suite){
+	suite.add("constructor_matrix4__to_matrix4", []{
+		r4::matrix4<int> m{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12},
+			{0, 0, 0, 1}
+		};
+
+		r4::affine3<int> a(m);
+
+		tst::check_eq(a[0], r4::vector4<int>{1, 2, 3, 4}, SL);
+		tst::check_eq(a[1], r4::vector4<int>{5, 6, 7, 8}, SL);
+		tst::check_eq(a[2], r4::vector4<int>{9, 10, 11, 12}, SL);
+
+		tst::check_eq(a.to_matrix4(), m, SL);
+	});
+
+	suite.add("builders_match_matrix4", []{
+		auto m = make_matrix();
+		auto a = make_affine();
+
+		auto diff = m - a.to_matrix4();
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, r4::matrix4<float>().set(0), SL);
+	});
+
+	suite.add("constructor_quaternion", []{
+		auto q = r4::quaternion<float>().set_rotation(r4::vector3<float>{0, 1, 1}.normalize(), 1.1f);
+
+		r4::affine3<float> a(q);
+
+		auto diff = r4::matrix4<float>(q) - a.to_matrix4();
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, r4::matrix4<float>().set(0), SL);
+	});
+
+	suite.add("operator_multiply_affine3", []{
+		r4::affine3<int> a{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12}
+		};
+		r4::affine3<int> b{
+			{2, 0, 1, -1},
+			{0, 3, 1, 2},
+			{1, 1, 0, 5}
+		};
+
+		auto res = a * b;
+
+		tst::check_eq(res.to_matrix4(), a.to_matrix4() * b.to_matrix4(), SL);
+
+		auto c = a;
+		c *= b;
+		tst::check_eq(c, res, SL);
+
+		c = b;
+		c.left_mul(a);
+		tst::check_eq(c, res, SL);
+	});
+
+	suite.add("transform_point__transform_direction", []{
+		r4::affine3<int> a{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12}
+		};
+
+		r4::vector3<int> v{1, -2, 3};
+
+		tst::check_eq(a.transform_point(v), r4::vector3<int>(a.to_matrix4() * v), SL);
+		tst::check_eq(a * v, a.transform_point(v), SL);
+		tst::check_eq(a.transform_direction(v), a.linear() * v, SL);
+	});
+
+	suite.add("inv_affine", []{
+		auto a = make_affine();
+
+		auto inv = a.inv_affine();
+
+		auto diff = r4::matrix4<float>().set_identity() - (a * inv).to_matrix4();
+		diff.snap_to_zero(1e-5f);
+		tst::check_eq(diff, r4::matrix4<float>().set(0), SL);
+
+		diff = a.to_matrix4().inv() - inv.to_matrix4();
+		diff.snap_to_zero(1e-5f);
+		tst::check_eq(diff, r4::matrix4<float>().set(0), SL);
+
+		auto b = a;
+		b.invert_affine();
+		tst::check_eq(b, inv, SL);
+	});
+
+	suite.add("linear__translation", []{
+		r4::affine3<int> a{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12}
+		};
+
+		tst::check_eq(
+			a.linear(),
+			r4::matrix3<int>{
+				{1, 2, 3},
+				{5, 6, 7},
+				{9, 10, 11}
+			},
+			SL
+		);
+		tst::check_eq(a.translation(), r4::vector3<int>{4, 8, 12}, SL);
+	});
+
+	suite.add("to", []{
+		r4::affine3<float> a{
+			{1.1f, 2, 3, 4},
+			{5, 6.7f, 7, 8},
+			{9, 10, 11, 12.9f}
+		};
+
+		r4::affine3<int> expected{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12}
+		};
+
+		tst::check_eq(a.to<int>(), expected, SL);
+	});
+
+	suite.add("operator_output", []{
+		r4::affine3<int> a;
+		a.set_identity();
+
+		std::stringstream ss;
+		ss << a;
+
+		tst::check_eq(ss.str(), std::string("|1 0 0 0\n|0 1 0 0\n|0 0 1 0\n"), SL);
+	});
+});
+}
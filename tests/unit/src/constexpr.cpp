@@ -0,0 +1,220 @@
+#include <cmath>
+#include <limits>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/math.hpp"
+#include "../../../src/r4/matrix.hpp"
+#include "../../../src/r4/quaternion.hpp"
+#include "../../../src/r4/rectangle.hpp"
+#include "../../../src/r4/vector.hpp"
+
+namespace{
+constexpr bool is_close(double a, double b, double tolerance = 1e-6){
+	return a - b <= tolerance && b - a <= tolerance;
+}
+
+// vector
+constexpr r4::vector4<float> va{1, 2, 3, 4};
+constexpr r4::vector4<float> vb(2);
+
+static_assert(va + vb == r4::vector4<float>{3, 4, 5, 6}, "constexpr evaluation failed");
+static_assert(va - vb == r4::vector4<float>{-1, 0, 1, 2}, "constexpr evaluation failed");
+static_assert(-va == r4::vector4<float>{-1, -2, -3, -4}, "constexpr evaluation failed");
+static_assert(va * 2.0f == r4::vector4<float>{2, 4, 6, 8}, "constexpr evaluation failed");
+static_assert(va / 2.0f == r4::vector4<float>{0.5f, 1, 1.5f, 2}, "constexpr evaluation failed");
+static_assert(va.dot(vb) == 20, "constexpr evaluation failed");
+static_assert(va.norm_pow2() == 30, "constexpr evaluation failed");
+static_assert(va.comp_mul(vb) == r4::vector4<float>{2, 4, 6, 8}, "constexpr evaluation failed");
+static_assert(
+	va.comp_op([](auto a){return a * a;}) == r4::vector4<float>{1, 4, 9, 16},
+	"constexpr evaluation failed"
+);
+static_assert(min(va, vb) == r4::vector4<float>{1, 2, 2, 2}, "constexpr evaluation failed");
+static_assert(abs(-va) == va, "constexpr evaluation failed");
+static_assert(va.to<int>() == r4::vector4<int>{1, 2, 3, 4}, "constexpr evaluation failed");
+static_assert(
+	r4::vector3<int>{1, 0, 0}.cross(r4::vector3<int>{0, 1, 0}) == r4::vector3<int>{0, 0, 1},
+	"constexpr evaluation failed"
+);
+static_assert(r4::vector4<int>(r4::vector2<int>{1, 2}) == r4::vector4<int>{1, 2, 0, 0}, "constexpr evaluation failed");
+static_assert(r4::vector2<double>{3, 4}.norm() == 5, "constexpr evaluation failed");
+static_assert(r4::vector2<double>{3, 4}.normed() == r4::vector2<double>{0.6, 0.8}, "constexpr evaluation failed");
+static_assert(is_close(r4::vector2<double>{1, 0}.rot(utki::pi / 2).y(), 1), "constexpr evaluation failed");
+
+// matrix
+constexpr r4::matrix4<double> ma{
+	{2, 0, 0, 1},
+	{0, 4, 0, 2},
+	{0, 0, 8, 3},
+	{0, 0, 0, 1}
+};
+
+static_assert(ma.det() == 64, "constexpr evaluation failed");
+static_assert(ma * ma.inv() == r4::matrix4<double>().set_identity(), "constexpr evaluation failed");
+static_assert(ma.inv_affine() == ma.inv(), "constexpr evaluation failed");
+static_assert(ma.tposed().tposed() == ma, "constexpr evaluation failed");
+static_assert(ma * r4::vector4<double>{1, 1, 1, 1} == r4::vector4<double>{3, 6, 11, 1}, "constexpr evaluation failed");
+static_assert(
+	r4::matrix4<double>().set_identity().translate(1, 2, 3).scale(2) ==
+		r4::matrix4<double>{
+			{2, 0, 0, 1},
+			{0, 2, 0, 2},
+			{0, 0, 2, 3},
+			{0, 0, 0, 1}
+		},
+	"constexpr evaluation failed"
+);
+static_assert(
+	is_close(r4::matrix4<double>().set_perspective(utki::pi / 2, 1, 1, 3)[1][1], 1),
+	"constexpr evaluation failed"
+);
+static_assert(
+	is_close(r4::matrix2<double>().set_identity().rotate(utki::pi / 2)[0][1], -1),
+	"constexpr evaluation failed"
+);
+
+// quaternion
+constexpr r4::quaternion<double> qa{1, 2, 3, 4};
+
+static_assert(qa * qa.inv_unit() == r4::quaternion<double>{0, 0, 0, 30}, "constexpr evaluation failed");
+static_assert(qa.norm_pow2() == 30, "constexpr evaluation failed");
+static_assert(
+	is_close(r4::quaternion<double>().set_rotation(0, 0, 1, utki::pi).rot(r4::vector3<double>{1, 0, 0}).x(), -1),
+	"constexpr evaluation failed"
+);
+static_assert(
+	is_close(r4::quaternion<double>(r4::vector3<double>{0, 0, utki::pi / 2}).to_matrix<3>()[1][0], 1),
+	"constexpr evaluation failed"
+);
+
+// rectangle
+static_assert(
+	r4::rectangle<int>(0, 0, 10, 10).intersect(r4::rectangle<int>(5, 6, 10, 10)) == r4::rectangle<int>(5, 6, 5, 4),
+	"constexpr evaluation failed"
+);
+static_assert(
+	r4::rectangle<int>(0, 0, 10, 10).unite(r4::rectangle<int>(5, 6, 10, 10)) == r4::rectangle<int>(0, 0, 15, 16),
+	"constexpr evaluation failed"
+);
+static_assert(r4::rectangle<int>(0, 0, 10, 10).overlaps(r4::vector2<int>{9, 9}), "constexpr evaluation failed");
+}
+
+namespace{
+const tst::set set("constexpr", [](tst::suite& suite){
+	suite.add("math_sqrt", []{
+		constexpr std::array<double, 8> values = {0, 1e-300, 0.5, 1, 2, 10, 123.456, 1e300};
+		constexpr std::array<double, 8> results = {
+			r4::math::sqrt(values[0]),
+			r4::math::sqrt(values[1]),
+			r4::math::sqrt(values[2]),
+			r4::math::sqrt(values[3]),
+			r4::math::sqrt(values[4]),
+			r4::math::sqrt(values[5]),
+			r4::math::sqrt(values[6]),
+			r4::math::sqrt(values[7])
+		};
+
+		for(size_t i = 0; i != values.size(); ++i){
+			auto expected = std::sqrt(values[i]);
+			tst::check_le(std::abs(results[i] - expected), expected * 1e-15, SL);
+			tst::check_eq(r4::math::sqrt(values[i]), expected, SL);
+		}
+
+		static_assert(r4::math::sqrt(4.0f) == 2.0f, "constexpr evaluation failed");
+		static_assert(r4::math::sqrt(16) == 4.0, "constexpr evaluation failed");
+	});
+
+	suite.add("math_sin_cos_tan", []{
+		constexpr std::array<double, 8> values = {0, 1e-5, 0.1, 1, -1, 3, -7, 100};
+		constexpr std::array<double, 8> sines = {
+			r4::math::sin(values[0]),
+			r4::math::sin(values[1]),
+			r4::math::sin(values[2]),
+			r4::math::sin(values[3]),
+			r4::math::sin(values[4]),
+			r4::math::sin(values[5]),
+			r4::math::sin(values[6]),
+			r4::math::sin(values[7])
+		};
+		constexpr std::array<double, 8> cosines = {
+			r4::math::cos(values[0]),
+			r4::math::cos(values[1]),
+			r4::math::cos(values[2]),
+			r4::math::cos(values[3]),
+			r4::math::cos(values[4]),
+			r4::math::cos(values[5]),
+			r4::math::cos(values[6]),
+			r4::math::cos(values[7])
+		};
+		constexpr std::array<double, 8> tangents = {
+			r4::math::tan(values[0]),
+			r4::math::tan(values[1]),
+			r4::math::tan(values[2]),
+			r4::math::tan(values[3]),
+			r4::math::tan(values[4]),
+			r4::math::tan(values[5]),
+			r4::math::tan(values[6]),
+			r4::math::tan(values[7])
+		};
+
+		for(size_t i = 0; i != values.size(); ++i){
+			// argument reduction loses precision for big arguments
+			double tolerance = std::abs(values[i]) < 10 ? 1e-15 : 1e-13;
+			tst::check_le(std::abs(sines[i] - std::sin(values[i])), tolerance, SL);
+			tst::check_le(std::abs(cosines[i] - std::cos(values[i])), tolerance, SL);
+			tst::check_le(std::abs(tangents[i] - std::tan(values[i])), tolerance * 10, SL);
+		}
+
+		static_assert(r4::math::sin(0.0f) == 0.0f, "constexpr evaluation failed");
+		static_assert(r4::math::cos(0.0f) == 1.0f, "constexpr evaluation failed");
+	});
+
+	suite.add("math_sin_cos_of_large_angles", []{
+		// number of periods does not fit into any integer type
+		constexpr auto sin_large = r4::math::sin(1e30f);
+		constexpr auto cos_large = r4::math::cos(1e300);
+		static_assert(-1 <= sin_large && sin_large <= 1, "constexpr evaluation failed");
+		static_assert(-1 <= cos_large && cos_large <= 1, "constexpr evaluation failed");
+
+		// the argument reduction is exact, 2^70 periods of 2 * pi rounded to double reduce to 0
+		constexpr double periods_angle = 6.283185307179586 * 1180591620717411303424.0;
+		static_assert(r4::math::sin(periods_angle) == 0, "constexpr evaluation failed");
+		static_assert(r4::math::cos(-periods_angle) == 1, "constexpr evaluation failed");
+
+		constexpr auto sin_inf = r4::math::sin(std::numeric_limits<double>::infinity());
+		static_assert(sin_inf != sin_inf, "constexpr evaluation failed");
+
+		tst::check(std::isfinite(sin_large), SL);
+	});
+
+	suite.add("runtime_and_compile_time_results_match", []{
+		constexpr auto ct_norm = r4::vector3<float>{1, 2, 3}.norm();
+		constexpr auto ct_inv = r4::matrix4<float>{
+			{1, 2, 0, 1},
+			{0, 1, 3, 0},
+			{2, 0, 1, 0},
+			{0, 0, 0, 1}
+		}.inv();
+
+		auto v = r4::vector3<float>{1, 2, 3};
+		auto m = r4::matrix4<float>{
+			{1, 2, 0, 1},
+			{0, 1, 3, 0},
+			{2, 0, 1, 0},
+			{0, 0, 0, 1}
+		};
+
+		tst::check_eq(ct_norm, v.norm(), SL);
+
+		auto rt_inv = m.inv();
+		for(size_t r = 0; r != 4; ++r){
+			for(size_t c = 0; c != 4; ++c){
+				tst::check_le(std::abs(ct_inv[r][c] - rt_inv[r][c]), 1e-6f, SL);
+			}
+		}
+	});
+});
+}
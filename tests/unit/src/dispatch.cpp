@@ -0,0 +1,243 @@
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/dispatch.hpp"
+
+namespace{
+std::vector<r4::vector3<float>> make_points(size_t size){
+	std::vector<r4::vector3<float>> ret;
+	for(size_t i = 0; i != size; ++i){
+		auto f = float(i);
+		ret.emplace_back(f * 0.5f - 7, 3 - f * 1.25f, f * f * 0.125f - 11);
+	}
+	return ret;
+}
+
+bool is_close(const r4::vector3<float>& a, const r4::vector3<float>& b){
+	const float tolerance = 1e-5f * std::max(1.0f, b.norm());
+	return (a - b).norm() <= tolerance;
+}
+
+// calls the function with the scalar implementation selected
+template <typename function_type>
+void with_scalar_isa(function_type function){
+	auto isa = r4::dispatch::get_isa();
+	r4::dispatch::set_isa(r4::dispatch::isa::scalar);
+	function();
+	r4::dispatch::set_isa(isa);
+}
+
+void check_transform_points(){
+	r4::matrix4<float> m{
+		{1, 2, 3, 4},
+		{5, 6, 7, 8},
+		{9, 10, 11, 12},
+		{0, 0, 0, 1}
+	};
+
+	// sizes which are not multiples of the SIMD block sizes are processed partially by narrower kernels
+	for(size_t size = 0; size != 40; ++size){
+		const auto in = make_points(size);
+		std::vector<r4::vector3<float>> out(in.size());
+
+		r4::dispatch::transform_points(m, utki::make_span(in), utki::make_span(out));
+
+		// SIMD implementations do the same operations in the same order as the scalar one, so the results are same
+		std::vector<r4::vector3<float>> expected(in.size());
+		with_scalar_isa([&]{
+			r4::dispatch::transform_points(m, utki::make_span(in), utki::make_span(expected));
+		});
+
+		for(size_t i = 0; i != in.size(); ++i){
+			tst::check(is_close(out[i], m * in[i]), SL) << "size = " << size << ", i = " << i << ", out[i] = " << out[i];
+			tst::check_eq(out[i], expected[i], SL) << "size = " << size << ", i = " << i;
+		}
+
+		// in-place transformation
+		auto inplace = in;
+		r4::dispatch::transform_points(m, utki::span<const r4::vector3<float>>(inplace), utki::make_span(inplace));
+		tst::check(inplace == out, SL);
+	}
+}
+
+void check_normalize(){
+	for(size_t size = 0; size != 40; ++size){
+		auto vectors = make_points(size);
+		// zero vectors in different lanes
+		for(size_t i = 3; i < vectors.size(); i += 7){
+			vectors[i] = r4::vector3<float>(0);
+		}
+		const auto in = vectors;
+
+		r4::dispatch::normalize(utki::make_span(vectors));
+
+		auto expected = in;
+		with_scalar_isa([&]{
+			r4::dispatch::normalize(utki::make_span(expected));
+		});
+
+		for(size_t i = 0; i != in.size(); ++i){
+			tst::check(is_close(vectors[i], in[i].normed()), SL) << "size = " << size << ", i = " << i;
+			tst::check_eq(vectors[i], expected[i], SL) << "size = " << size << ", i = " << i;
+		}
+	}
+}
+
+void check_bounding_box(){
+	tst::check_eq(
+		r4::dispatch::bounding_box(nullptr).first,
+		r4::vector3<float>(std::numeric_limits<float>::infinity()),
+		SL
+	);
+	tst::check_eq(
+		r4::dispatch::bounding_box(nullptr).second,
+		r4::vector3<float>(-std::numeric_limits<float>::infinity()),
+		SL
+	);
+
+	for(size_t size = 1; size != 40; ++size){
+		const auto points = make_points(size);
+
+		auto expected_min = points.front();
+		auto expected_max = points.front();
+		for(const auto& p : points){
+			expected_min = min(expected_min, p);
+			expected_max = max(expected_max, p);
+		}
+
+		auto box = r4::dispatch::bounding_box(utki::make_span(points));
+		tst::check_eq(box.first, expected_min, SL) << "size = " << size;
+		tst::check_eq(box.second, expected_max, SL) << "size = " << size;
+	}
+}
+
+// numbers which take all the special paths of conversions: rounding ties, overflow, subnormals, infinities and NaNs
+std::vector<float> make_numbers(size_t size){
+	const std::array<float, 12> special = {{
+		1.00048828125f,
+		65520,
+		-1e10f,
+		5.9604644775390625e-8f,
+		2.98023223876953125e-8f,
+		-6.103515625e-5f,
+		std::numeric_limits<float>::infinity(),
+		-std::numeric_limits<float>::infinity(),
+		std::numeric_limits<float>::quiet_NaN(),
+		-0.0f,
+		3.0e38f,
+		1.00390625f
+	}};
+
+	std::vector<float> ret;
+	for(size_t i = 0; i != size; ++i){
+		if(i % 3 == 1){
+			ret.push_back(special[(i / 3) % special.size()]);
+		}else{
+			ret.push_back(float(i) * 1.37f - 20);
+		}
+	}
+	return ret;
+}
+
+uint32_t bits_of(float f){
+	uint32_t u = 0;
+	std::memcpy(&u, &f, sizeof(u));
+	return u;
+}
+
+// the dispatched conversions must give same bits as converting each number
+template <typename half_type>
+void check_convert(){
+	for(size_t size = 0; size != 70; ++size){
+		const auto in = make_numbers(size);
+
+		std::vector<half_type> out(in.size());
+		r4::dispatch::convert(utki::make_span(in), utki::make_span(out));
+
+		for(size_t i = 0; i != in.size(); ++i){
+			tst::check_eq(out[i].get_bits(), half_type(in[i]).get_bits(), SL) << "size = " << size << ", i = " << i << ", in[i] = " << in[i];
+		}
+
+		const auto& halves = out;
+		std::vector<float> back(halves.size());
+		r4::dispatch::convert(utki::make_span(halves), utki::make_span(back));
+
+		for(size_t i = 0; i != halves.size(); ++i){
+			float expected = halves[i];
+			if(std::isnan(expected)){
+				tst::check(std::isnan(back[i]), SL) << "size = " << size << ", i = " << i;
+			}else{
+				tst::check_eq(bits_of(back[i]), bits_of(expected), SL) << "size = " << size << ", i = " << i;
+			}
+		}
+	}
+
+	// vectors and matrices
+	const std::vector<r4::vector3<float>> vectors = {{1, 2, 3}, {-4, 0.1f, 65520}, {7, 8, 9}};
+	std::vector<r4::vector3<half_type>> converted_vectors(vectors.size());
+	r4::dispatch::convert(utki::make_span(vectors), utki::make_span(converted_vectors));
+	for(size_t i = 0; i != vectors.size(); ++i){
+		tst::check_eq(converted_vectors[i].template to<float>(), vectors[i].template to<half_type>().template to<float>(), SL);
+	}
+
+	const std::vector<r4::matrix4<float>> matrices(2, r4::matrix4<float>().set_identity());
+	std::vector<r4::matrix4<half_type>> converted_matrices(matrices.size());
+	r4::dispatch::convert(utki::make_span(matrices), utki::make_span(converted_matrices));
+	for(const auto& m : converted_matrices){
+		tst::check_eq(m.template to<float>(), r4::matrix4<float>().set_identity(), SL);
+	}
+}
+}
+
+namespace{
+const tst::set set("dispatch", [](tst::suite& suite){
+	suite.add("to_string", []{
+		tst::check_eq(r4::dispatch::to_string(r4::dispatch::isa::scalar), std::string_view("scalar"), SL);
+		tst::check_eq(r4::dispatch::to_string(r4::dispatch::isa::sse4_1), std::string_view("sse4.1"), SL);
+		tst::check_eq(r4::dispatch::to_string(r4::dispatch::isa::avx2), std::string_view("avx2"), SL);
+		tst::check_eq(r4::dispatch::to_string(r4::dispatch::isa::avx512), std::string_view("avx512"), SL);
+	});
+
+	suite.add("set_isa_throws_if_not_supported", []{
+		auto supported = r4::dispatch::get_supported_isa();
+		tst::check(supported < r4::dispatch::isa::enum_size, SL);
+		tst::check(r4::dispatch::get_isa() <= supported, SL);
+
+		for(auto i = size_t(supported) + 1; i <= size_t(r4::dispatch::isa::enum_size); ++i){
+			bool thrown = false;
+			try{
+				r4::dispatch::set_isa(r4::dispatch::isa(i));
+			}catch(std::invalid_argument&){
+				thrown = true;
+			}
+			tst::check(thrown, SL) << "i = " << i;
+		}
+	});
+
+	// the only test which changes the selected instruction set,
+	// the tests run in parallel and other tests must not rely on the selection
+	suite.add("all_supported_isas", []{
+		auto initial = r4::dispatch::get_isa();
+
+		for(size_t i = 0; i <= size_t(r4::dispatch::get_supported_isa()); ++i){
+			auto isa = r4::dispatch::isa(i);
+			r4::dispatch::set_isa(isa);
+			tst::check(r4::dispatch::get_isa() == isa, SL);
+
+			check_transform_points();
+			check_normalize();
+			check_bounding_box();
+			check_convert<r4::half>();
+			check_convert<r4::bfloat16>();
+		}
+
+		r4::dispatch::set_isa(initial);
+	});
+});
+}
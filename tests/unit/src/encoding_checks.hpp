@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <tst/check.hpp>
+#include <utki/math.hpp>
+#include <utki/span.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/vector.hpp"
+
+// Checks shared by tests of the normal and quaternion encodings.
+// The codec_type provides value_type, encoded_type, and encode(), decode(), encode_all(), decode_all() and error() static functions,
+// where error() is the angle in degrees between the original and the decoded values.
+namespace encoding_checks{
+// random unit vectors, uniformly distributed on the sphere
+template <size_t dimension>
+std::vector<r4::vector<double, dimension>> random_units(size_t size){
+	std::mt19937 gen(1);
+	std::normal_distribution<double> dist;
+	std::vector<r4::vector<double, dimension>> ret(size);
+	for(auto& v : ret){
+		for(auto& c : v){
+			c = dist(gen);
+		}
+		v.normalize();
+	}
+	return ret;
+}
+
+inline double to_degrees(double radians){
+	return radians * 180 / utki::pi;
+}
+
+template <typename codec_type>
+void check_error(const std::vector<typename codec_type::value_type>& values, double max_error){
+	double worst = 0;
+	for(const auto& v : values){
+		auto d = codec_type::decode(codec_type::encode(v));
+		tst::check_lt(std::abs(d.norm() - 1), 1e-6f, SL) << "v = " << v;
+		worst = std::max(worst, codec_type::error(v, d));
+	}
+	tst::check_lt(worst, max_error, SL);
+}
+
+template <typename codec_type>
+void check_exact(const typename codec_type::value_type& v, const typename codec_type::value_type& expected){
+	tst::check_eq(codec_type::decode(codec_type::encode(v)), expected, SL) << "v = " << v;
+}
+
+// batched forms give same results as the single value forms, including the tail which does not fill whole SIMD register
+template <typename codec_type>
+void check_batch(const std::vector<typename codec_type::value_type>& values){
+	using value_type = typename codec_type::value_type;
+	using encoded_type = typename codec_type::encoded_type;
+
+	std::vector<encoded_type> encoded(values.size());
+	codec_type::encode_all(utki::make_span(values), utki::make_span(encoded));
+
+	const auto& const_encoded = encoded;
+	std::vector<value_type> decoded(values.size());
+	codec_type::decode_all(utki::make_span(const_encoded), utki::make_span(decoded));
+
+	for(size_t i = 0; i != values.size(); ++i){
+		auto e = codec_type::encode(values[i]);
+		tst::check(encoded[i] == e, SL) << "i = " << i;
+		tst::check_eq(decoded[i], codec_type::decode(e), SL) << "i = " << i;
+	}
+}
+}
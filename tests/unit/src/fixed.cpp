@@ -0,0 +1,275 @@
+#include <cmath>
+#include <cstdint>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/fixed.hpp"
+#include "../../../src/r4/matrix.hpp"
+#include "../../../src/r4/rectangle.hpp"
+#include "../../../src/r4/segment2.hpp"
+
+using fixed32 = r4::fixed<16, 16>;
+using fixed16 = r4::fixed<8, 8>;
+using saturating16 = r4::fixed<8, 8, r4::overflow::saturate>;
+
+// declare templates to instantiate all template methods to include all methods to gcov coverage
+template class r4::vector<fixed32, 2>;
+template class r4::vector<fixed32, 3>;
+template class r4::vector<fixed32, 4>;
+template class r4::vector<fixed16, 4>;
+template class r4::matrix<fixed32, 3, 3>;
+template class r4::matrix<fixed32, 4, 4>;
+template class r4::quaternion<fixed32>;
+template class r4::rectangle<fixed32>;
+template class r4::segment2<fixed32>;
+
+namespace{
+constexpr fixed32 half = fixed32::from_raw(0x8000);
+
+static_assert(fixed32(3) + half == fixed32(3.5), "constexpr evaluation failed");
+static_assert(fixed32(3) * half == fixed32(1.5), "constexpr evaluation failed");
+static_assert(fixed32(3) / fixed32(4) == fixed32(0.75), "constexpr evaluation failed");
+static_assert(sqrt(fixed32(9)) == fixed32(3), "constexpr evaluation failed");
+static_assert(r4::vector2<fixed32>(3, 4).norm() == fixed32(5), "constexpr evaluation failed");
+
+template <typename fixed_type>
+double error_of(fixed_type f, double expected){
+	return std::abs(double(f) - expected);
+}
+}
+
+namespace{
+const tst::set set("fixed", [](tst::suite& suite){
+	suite.add("conversions", []{
+		tst::check_eq(fixed32(1).get_raw(), int32_t(0x10000), SL);
+		tst::check_eq(fixed32(-2).get_raw(), int32_t(-0x20000), SL);
+		tst::check_eq(fixed32(0.5).get_raw(), int32_t(0x8000), SL);
+		tst::check_eq(fixed32(-0.25f).get_raw(), int32_t(-0x4000), SL);
+
+		// rounds to nearest
+		tst::check_eq(fixed16(0.01).get_raw(), int16_t(3), SL);
+		tst::check_eq(fixed16(-0.01).get_raw(), int16_t(-3), SL);
+
+		// floating point values are saturated, NaN becomes zero
+		tst::check_eq(fixed16(1000.0), std::numeric_limits<fixed16>::max(), SL);
+		tst::check_eq(fixed16(-1000.0), std::numeric_limits<fixed16>::lowest(), SL);
+		tst::check_eq(fixed16(std::nan("")), fixed16(0), SL);
+
+		tst::check_eq(double(fixed32::from_raw(0x18000)), 1.5, SL);
+		tst::check_eq(int(fixed32(2.75)), 2, SL);
+		tst::check_eq(int(fixed32(-2.75)), -2, SL);
+	});
+
+	suite.add<std::pair<fixed32, fixed32>>(
+		"arithmetic",
+		{
+			{fixed32(1.5), fixed32(2.25)},
+			{fixed32(-3.125), fixed32(0.5)},
+			{fixed32(100), fixed32(-0.01)},
+			{fixed32(-7), fixed32(-7)},
+			{fixed32::from_raw(1), fixed32::from_raw(3)},
+		},
+		[](const auto& p){
+			auto a = p.first;
+			auto b = p.second;
+			auto da = double(a);
+			auto db = double(b);
+			auto eps = double(std::numeric_limits<fixed32>::epsilon());
+
+			tst::check_eq(double(a + b), da + db, SL);
+			tst::check_eq(double(a - b), da - db, SL);
+			tst::check_eq(double(-a), -da, SL);
+			tst::check_le(error_of(a * b, da * db), eps / 2, SL);
+			tst::check_lt(error_of(a / b, da / db), eps, SL);
+		}
+	);
+
+	suite.add("multiplication_rounding", []{
+		// 3 * 2^-16 * 0.5 = 1.5 * 2^-16, rounds up
+		tst::check_eq((fixed32::from_raw(3) * half).get_raw(), int32_t(2), SL);
+		tst::check_eq((fixed32::from_raw(-3) * half).get_raw(), int32_t(-1), SL);
+	});
+
+	suite.add("division_by_zero", []{
+		tst::check_eq(fixed32(3) / fixed32(0), std::numeric_limits<fixed32>::max(), SL);
+		tst::check_eq(fixed32(-3) / fixed32(0), std::numeric_limits<fixed32>::lowest(), SL);
+	});
+
+	suite.add("overflow", []{
+		// 8.8 format range is [-128, 128)
+		tst::check_eq(fixed16(100) + fixed16(100), fixed16(-56), SL);
+		tst::check_eq(fixed16(-100) - fixed16(100), fixed16(56), SL);
+		tst::check_eq(fixed16(16) * fixed16(16), fixed16(0), SL);
+		tst::check_eq(-std::numeric_limits<fixed16>::lowest(), std::numeric_limits<fixed16>::lowest(), SL);
+
+		tst::check_eq(saturating16(100) + saturating16(100), std::numeric_limits<saturating16>::max(), SL);
+		tst::check_eq(saturating16(-100) - saturating16(100), std::numeric_limits<saturating16>::lowest(), SL);
+		tst::check_eq(saturating16(16) * saturating16(-16), std::numeric_limits<saturating16>::lowest(), SL);
+		tst::check_eq(saturating16(100) / saturating16(0.5), std::numeric_limits<saturating16>::max(), SL);
+		tst::check_eq(-std::numeric_limits<saturating16>::lowest(), std::numeric_limits<saturating16>::max(), SL);
+		tst::check_eq(saturating16(1000), std::numeric_limits<saturating16>::max(), SL);
+	});
+
+	suite.add("integer_out_of_range", []{
+		constexpr auto int64_max = std::numeric_limits<int64_t>::max();
+		constexpr auto int64_min = std::numeric_limits<int64_t>::min();
+		constexpr auto uint64_max = std::numeric_limits<uint64_t>::max();
+
+		// integers wrap around modulo 2^int_bits
+		static_assert(fixed16(int64_max) == fixed16(-1), "constexpr evaluation failed");
+		tst::check_eq(fixed16(128), fixed16(-128), SL);
+		tst::check_eq(fixed16(int64_t(0x1'0000'0101)), fixed16(1), SL);
+		tst::check_eq(fixed16(int64_min), fixed16(0), SL);
+		tst::check_eq(fixed16(uint64_max), fixed16(-1), SL);
+		tst::check_eq(fixed32(std::numeric_limits<int32_t>::max()), fixed32(-1), SL);
+
+		// integers saturate to the representable range
+		static_assert(saturating16(int64_max) == std::numeric_limits<saturating16>::max(), "constexpr evaluation failed");
+		tst::check_eq(saturating16(127), saturating16::from_raw(127 * 256), SL);
+		tst::check_eq(saturating16(128), std::numeric_limits<saturating16>::max(), SL);
+		tst::check_eq(saturating16(-128), std::numeric_limits<saturating16>::lowest(), SL);
+		tst::check_eq(saturating16(-129), std::numeric_limits<saturating16>::lowest(), SL);
+		tst::check_eq(saturating16(int64_min), std::numeric_limits<saturating16>::lowest(), SL);
+		tst::check_eq(saturating16(uint64_max), std::numeric_limits<saturating16>::max(), SL);
+		tst::check_eq(saturating16(uint64_t(int64_max) + 1), std::numeric_limits<saturating16>::max(), SL);
+	});
+
+	suite.add("rounding", []{
+		tst::check_eq(floor(fixed32(2.5)), fixed32(2), SL);
+		tst::check_eq(floor(fixed32(-2.5)), fixed32(-3), SL);
+		tst::check_eq(ceil(fixed32(2.5)), fixed32(3), SL);
+		tst::check_eq(ceil(fixed32(-2.5)), fixed32(-2), SL);
+		tst::check_eq(round(fixed32(2.5)), fixed32(3), SL);
+		tst::check_eq(round(fixed32(-2.5)), fixed32(-3), SL);
+		tst::check_eq(round(fixed32(-2.25)), fixed32(-2), SL);
+		tst::check_eq(abs(fixed32(-2.25)), fixed32(2.25), SL);
+	});
+
+	suite.add("sqrt", []{
+		auto eps = double(std::numeric_limits<fixed32>::epsilon());
+		for(int32_t raw = 1; raw > 0 && raw <= std::numeric_limits<int32_t>::max() - 7919; raw += 7919){
+			auto f = fixed32::from_raw(raw);
+			tst::check_le(error_of(sqrt(f), std::sqrt(double(f))), eps / 2, SL) << "raw = " << raw;
+		}
+		tst::check_eq(sqrt(fixed32(0)), fixed32(0), SL);
+		tst::check_eq(sqrt(fixed32(-1)), fixed32(0), SL);
+		tst::check_eq(sqrt(fixed16(4)), fixed16(2), SL);
+
+		auto max = std::numeric_limits<fixed32>::max();
+		tst::check_le(error_of(sqrt(max), std::sqrt(double(max))), eps / 2, SL);
+	});
+
+	suite.add("trigonometry", []{
+		// a few units of the last place
+		const double tolerance = 4 * double(std::numeric_limits<fixed32>::epsilon());
+
+		for(double a = -10; a <= 10; a += 0.01){
+			auto f = fixed32(a);
+			auto da = double(f);
+			tst::check_le(error_of(sin(f), std::sin(da)), tolerance, SL) << "a = " << a;
+			tst::check_le(error_of(cos(f), std::cos(da)), tolerance, SL) << "a = " << a;
+			if(std::abs(std::cos(da)) > 0.1){
+				tst::check_le(error_of(tan(f), std::tan(da)), tolerance * 100, SL) << "a = " << a;
+			}
+			tst::check_le(error_of(atan(f), std::atan(da)), tolerance, SL) << "a = " << a;
+			tst::check_le(error_of(atan2(f, fixed32(-0.5)), std::atan2(da, -0.5)), tolerance, SL) << "a = " << a;
+		}
+
+		for(double a = -1; a <= 1; a += 0.001){
+			auto f = fixed32(a);
+			auto da = double(f);
+			// derivatives of asin() and acos() are infinite at -1 and 1, which amplifies the argument rounding error
+			double t = std::abs(da) > 0.99 ? tolerance * 16 : tolerance;
+			tst::check_le(error_of(asin(f), std::asin(da)), t, SL) << "a = " << a;
+			tst::check_le(error_of(acos(f), std::acos(da)), t, SL) << "a = " << a;
+		}
+
+		tst::check_eq(sin(fixed32(0)), fixed32(0), SL);
+		tst::check_eq(cos(fixed32(0)), fixed32(1), SL);
+		tst::check_eq(atan2(fixed32(0), fixed32(0)), fixed32(0), SL);
+		tst::check_le(error_of(atan2(fixed32(0), fixed32(-1)), utki::pi), tolerance, SL);
+		tst::check_le(error_of(acos(fixed32(-2)), utki::pi), tolerance, SL);
+
+		// 8 bit and 31 bit fractions
+		tst::check_le(error_of(sin(fixed16(1)), std::sin(1.0)), 1.0 / 256, SL);
+		using q31 = r4::fixed<1, 31>;
+		tst::check_le(error_of(sin(q31(0.5)), std::sin(0.5)), 1e-8, SL);
+		tst::check_le(error_of(asin(q31(0.5)), std::asin(0.5)), 1e-8, SL);
+	});
+
+	// SIMD implementation gives same results as the scalar one, which is used in constant evaluation
+	suite.add("vector4_bit_compatibility", []{
+		using vector4 = r4::vector4<fixed32>;
+
+		constexpr vector4 ca{fixed32(1.1), fixed32(-200.7), fixed32(0.001), std::numeric_limits<fixed32>::max()};
+		constexpr vector4 cb{fixed32(-3.3), fixed32(1.9), fixed32(-0.75), fixed32(2)};
+		constexpr fixed32 num{1.3};
+
+		constexpr auto sum = ca + cb;
+		constexpr auto difference = ca - cb;
+		constexpr auto negated = -ca;
+		constexpr auto scaled = ca * num;
+		constexpr auto divided = ca / num;
+		constexpr auto product = ca.comp_mul(cb);
+		constexpr auto quotient = ca.comp_div(cb);
+		constexpr auto minimum = min(ca, cb);
+		constexpr auto maximum = max(ca, cb);
+		constexpr auto absolute = abs(cb);
+		constexpr auto dot = ca.dot(cb);
+		constexpr auto components_sum = ca.sum();
+		constexpr auto min_comp = cb.min_component();
+		constexpr auto max_comp = cb.max_component();
+
+		// run time copies, to make sure the SIMD implementation is used
+		vector4 a = ca;
+		vector4 b = cb;
+
+		tst::check_eq(a + b, sum, SL);
+		tst::check_eq(a - b, difference, SL);
+		tst::check_eq(-a, negated, SL);
+		tst::check_eq(a * num, scaled, SL);
+		tst::check_eq(a / num, divided, SL);
+		tst::check_eq(a.comp_mul(b), product, SL);
+		tst::check_eq(a.comp_div(b), quotient, SL);
+		tst::check_eq(min(a, b), minimum, SL);
+		tst::check_eq(max(a, b), maximum, SL);
+		tst::check_eq(abs(b), absolute, SL);
+		tst::check_eq(a.dot(b), dot, SL);
+		tst::check_eq(a.sum(), components_sum, SL);
+		tst::check_eq(b.min_component(), min_comp, SL);
+		tst::check_eq(b.max_component(), max_comp, SL);
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check_eq(floor(b)[i], floor(b[i]), SL) << "i = " << i;
+			tst::check_eq(ceil(b)[i], ceil(b[i]), SL) << "i = " << i;
+		}
+	});
+
+	suite.add("drop_in", []{
+		auto eps = double(std::numeric_limits<fixed32>::epsilon());
+
+		r4::vector3<fixed32> v{3, 4, 12};
+		tst::check_eq(v.norm(), fixed32(13), SL);
+		tst::check_le(error_of(r4::vector3<fixed32>(v).normalize().norm(), 1), 4 * eps, SL);
+
+		r4::quaternion<fixed32> q;
+		q.set_rotation(0, 0, 1, fixed32(utki::pi / 2));
+		auto rotated = q.to_matrix<3>() * r4::vector3<fixed32>{1, 0, 0};
+		tst::check_le(error_of(rotated.x(), 0), 8 * eps, SL);
+		tst::check_le(error_of(rotated.y(), 1), 8 * eps, SL);
+
+		r4::matrix4<fixed32> m;
+		m.set_identity();
+		m.translate(1, 2, 3);
+		m.scale(2);
+		tst::check_eq(m * r4::vector4<fixed32>{1, 1, 1, 1}, r4::vector4<fixed32>{3, 4, 5, 1}, SL);
+		tst::check_eq(m.inv() * r4::vector4<fixed32>{3, 4, 5, 1}, r4::vector4<fixed32>{1, 1, 1, 1}, SL);
+
+		r4::rectangle<fixed32> r{{0, 0}, {10, 20}};
+		tst::check_eq(r.center(), r4::vector2<fixed32>{5, 10}, SL);
+		tst::check(r.overlaps(r4::vector2<fixed32>{fixed32(9.5), 19}), SL);
+	});
+});
+}
@@ -0,0 +1,186 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/half.hpp"
+#include "../../../src/r4/matrix.hpp"
+
+namespace{
+uint32_t bits_of(float f){
+	uint32_t u = 0;
+	std::memcpy(&u, &f, sizeof(u));
+	return u;
+}
+
+float float_of(uint32_t u){
+	float f = 0;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+template <typename half_type>
+uint16_t to_bits(float f){
+	return half_type(f).get_bits();
+}
+}
+
+namespace{
+const tst::set set("half", [](tst::suite& suite){
+	suite.add<std::pair<float, uint16_t>>(
+		"half_from_float",
+		{
+			{0.0f, 0x0000},
+			{-0.0f, 0x8000},
+			{1.0f, 0x3c00},
+			{-2.0f, 0xc000},
+			{0.5f, 0x3800},
+			{0.1f, 0x2e66},
+			{65504.0f, 0x7bff}, // largest finite half
+			{65519.0f, 0x7bff}, // rounds down to largest finite half
+			{65520.0f, 0x7c00}, // rounds up to infinity
+			{1e10f, 0x7c00},
+			{-1e10f, 0xfc00},
+			{std::numeric_limits<float>::infinity(), 0x7c00},
+			{-std::numeric_limits<float>::infinity(), 0xfc00},
+			{6.103515625e-5f, 0x0400}, // smallest normal half, 2^-14
+			{5.9604644775390625e-8f, 0x0001}, // smallest subnormal half, 2^-24
+			{2.98023223876953125e-8f, 0x0000}, // 2^-25, tie, rounds to even
+			{8.94069671630859375e-8f, 0x0002}, // 3 * 2^-25, tie, rounds to even
+			{1e-10f, 0x0000},
+			{1.00048828125f, 0x3c00}, // 1 + 2^-11, tie, rounds to even
+			{1.00146484375f, 0x3c02}, // 1 + 3 * 2^-11, tie, rounds to even
+		},
+		[](const auto& p){
+			tst::check_eq(to_bits<r4::half>(p.first), p.second, SL) << "f = " << p.first;
+		}
+	);
+
+	suite.add("half_nan", []{
+		auto h = r4::half(std::numeric_limits<float>::quiet_NaN());
+		tst::check_eq(h.get_bits() & 0x7c00, 0x7c00, SL);
+		tst::check((h.get_bits() & 0x3ff) != 0, SL);
+		tst::check(std::isnan(float(h)), SL);
+
+		// signaling NaN with payload only in the lower mantissa bits stays NaN
+		auto s = r4::half(float_of(0x7f800001));
+		tst::check(std::isnan(float(s)), SL);
+	});
+
+	// every half value converts to float and back exactly
+	suite.add("half_round_trip", []{
+		for(uint32_t b = 0; b <= 0xffff; ++b){
+			auto h = r4::half::from_bits(uint16_t(b));
+			float f = h;
+
+			if((b & 0x7c00) == 0x7c00 && (b & 0x3ff) != 0){
+				tst::check(std::isnan(f), SL) << "b = " << b;
+				continue;
+			}
+
+			tst::check_eq(r4::half(f).get_bits(), uint16_t(b), SL) << "b = " << b;
+		}
+	});
+
+	suite.add<std::pair<uint16_t, float>>(
+		"half_to_float",
+		{
+			{0x0000, 0.0f},
+			{0x3c00, 1.0f},
+			{0xc000, -2.0f},
+			{0x7bff, 65504.0f},
+			{0x0001, 5.9604644775390625e-8f},
+			{0x03ff, 6.09755516052246094e-5f}, // largest subnormal
+			{0x7c00, std::numeric_limits<float>::infinity()},
+			{0xfc00, -std::numeric_limits<float>::infinity()},
+		},
+		[](const auto& p){
+			tst::check_eq(float(r4::half::from_bits(p.first)), p.second, SL);
+		}
+	);
+
+	suite.add<std::pair<float, uint16_t>>(
+		"bfloat16_from_float",
+		{
+			{0.0f, 0x0000},
+			{-0.0f, 0x8000},
+			{1.0f, 0x3f80},
+			{-2.0f, 0xc000},
+			{float_of(0x3f808000), 0x3f80}, // tie, rounds to even
+			{float_of(0x3f818000), 0x3f82}, // tie, rounds to even
+			{float_of(0x3f808001), 0x3f81},
+			{float_of(0x7f7fffff), 0x7f80}, // largest float rounds to infinity
+			{std::numeric_limits<float>::infinity(), 0x7f80},
+			{-std::numeric_limits<float>::infinity(), 0xff80},
+			{std::numeric_limits<float>::denorm_min(), 0x0000},
+		},
+		[](const auto& p){
+			tst::check_eq(to_bits<r4::bfloat16>(p.first), p.second, SL) << "f = " << p.first;
+		}
+	);
+
+	suite.add("bfloat16_nan", []{
+		// NaN with payload only in the lower 16 bits must not become infinity
+		auto b = r4::bfloat16(float_of(0x7f800001));
+		tst::check(std::isnan(float(b)), SL);
+
+		auto q = r4::bfloat16(std::numeric_limits<float>::quiet_NaN());
+		tst::check(std::isnan(float(q)), SL);
+	});
+
+	suite.add("bfloat16_to_float", []{
+		for(uint32_t b = 0; b <= 0xffff; ++b){
+			tst::check_eq(bits_of(r4::bfloat16::from_bits(uint16_t(b))), b << 16, SL);
+		}
+	});
+
+	suite.add("vector_to", []{
+		const r4::vector4<float> v4{1, -2.5f, 0.1f, 65520};
+		auto h4 = v4.to<r4::half>();
+		tst::check_eq(h4[0].get_bits(), uint16_t(0x3c00), SL);
+		tst::check_eq(h4[1].get_bits(), to_bits<r4::half>(-2.5f), SL);
+		tst::check_eq(h4[2].get_bits(), uint16_t(0x2e66), SL);
+		tst::check_eq(h4[3].get_bits(), uint16_t(0x7c00), SL);
+		tst::check_eq(h4.to<float>(), r4::vector4<float>(1, -2.5f, float(r4::half(0.1f)), std::numeric_limits<float>::infinity()), SL);
+
+		const r4::vector3<float> v3{0.5f, 3, -4};
+		tst::check_eq(v3.to<r4::half>().to<float>(), v3, SL);
+		tst::check_eq(v3.to<r4::bfloat16>().to<float>(), v3, SL);
+
+		auto b4 = v4.to<r4::bfloat16>();
+		for(size_t i = 0; i != v4.size(); ++i){
+			tst::check_eq(b4[i].get_bits(), to_bits<r4::bfloat16>(v4[i]), SL) << "i = " << i;
+		}
+
+		r4::vector<float, 16> v16{};
+		for(size_t i = 0; i != v16.size(); ++i){
+			v16[i] = float(i) * 0.3f - 2;
+		}
+		auto h16 = v16.to<r4::half>();
+		auto b16 = v16.to<r4::bfloat16>();
+		auto fh16 = h16.to<float>();
+		auto fb16 = b16.to<float>();
+		for(size_t i = 0; i != v16.size(); ++i){
+			tst::check_eq(h16[i].get_bits(), to_bits<r4::half>(v16[i]), SL) << "i = " << i;
+			tst::check_eq(b16[i].get_bits(), to_bits<r4::bfloat16>(v16[i]), SL) << "i = " << i;
+			tst::check_eq(fh16[i], float(r4::half(v16[i])), SL) << "i = " << i;
+			tst::check_eq(fb16[i], float(r4::bfloat16(v16[i])), SL) << "i = " << i;
+		}
+	});
+
+	suite.add("matrix_to", []{
+		r4::matrix4<float> m{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12},
+			{13, 14, 15, 16}
+		};
+
+		tst::check_eq(m.to<r4::half>().to<float>(), m, SL);
+		tst::check_eq(m.to<r4::bfloat16>().to<float>(), m, SL);
+	});
+});
+}
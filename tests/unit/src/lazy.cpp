@@ -0,0 +1,69 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/lazy.hpp"
+
+namespace{
+constexpr r4::vector3<int> constexpr_expression(){
+	r4::vector3<int> a{1, 2, 3};
+	r4::vector3<int> b{10, 20, 30};
+	return r4::lazy(a) * 2 + b - (-r4::lazy(a)) / 1;
+}
+
+// check that lazy expressions are evaluated at compile time
+static_assert(constexpr_expression()[0] == 13, "constexpr evaluation failed");
+static_assert(constexpr_expression()[1] == 26, "constexpr evaluation failed");
+static_assert(constexpr_expression()[2] == 39, "constexpr evaluation failed");
+}
+
+namespace{
+const tst::set set("lazy", [](tst::suite& suite){
+	suite.add("scalar_operations", []{
+		r4::vector4<float> a{1, 2, 3, 4};
+
+		r4::vector4<float> r = r4::lazy(a) * 2;
+		tst::check_eq(r, a * 2, SL);
+
+		r = 3 * r4::lazy(a);
+		tst::check_eq(r, a * 3, SL);
+
+		r = r4::lazy(a) / 2;
+		tst::check_eq(r, a / 2, SL);
+
+		r = -r4::lazy(a);
+		tst::check_eq(r, -a, SL);
+	});
+
+	suite.add("chained_expression", []{
+		r4::vector3<double> a{1, 2, 3};
+		r4::vector3<double> b{-4, 5, 0.5};
+		r4::vector3<double> c{7, -8, 9};
+		double s = 0.25;
+
+		r4::vector3<double> r = r4::lazy(a) * s + b - c;
+		tst::check_eq(r, a * s + b - c, SL);
+
+		r = b + r4::lazy(a) * s - (c - r4::lazy(b)) / 2;
+		tst::check_eq(r, b + a * s - (c - b) / 2, SL);
+
+		tst::check_eq((r4::lazy(a) + b).eval(), a + b, SL);
+	});
+
+	suite.add("aliasing", []{
+		r4::vector2<int> a{1, 2};
+		r4::vector2<int> b{3, 4};
+
+		a = r4::lazy(b) - a + a * 2;
+		tst::check_eq(a, r4::vector2<int>{4, 6}, SL);
+	});
+
+	suite.add("vector_dot_expression", []{
+		r4::vector2<int> a{1, 2};
+		r4::vector2<int> b{3, 4};
+
+		// vector by vector multiplication is a dot product, same applies to lazy expressions
+		tst::check_eq(a * (r4::lazy(b) * 2), 22, SL);
+	});
+});
+}
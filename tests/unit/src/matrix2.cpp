@@ -1,6 +1,7 @@
 #include <tst/set.hpp>
 #include <tst/check.hpp>
 
+#include "../../../src/r4/io.hpp"
 #include "../../../src/r4/matrix.hpp"
 
 using namespace std::string_literals;
@@ -278,5 +279,58 @@ const tst::set set("matrix2", [](tst::suite& suite){
 
 		tst::check_eq(diff, decltype(m)().set(0), SL);
 	});
+
+	suite.add("inv_det", []{
+		r4::matrix2<float> m{
+			{1.0f, 3.0f, 5.0f},
+			{2.0f, 3.0f, 1.0f},
+		};
+
+		auto [inv, det] = m.inv_det();
+
+		tst::check_eq(det, -3.0f, SL);
+
+		auto diff = decltype(m)().set_identity() - inv * m;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+	});
+
+	suite.add("inv_affine", []{
+		r4::matrix2<float> m{
+			{1.0f, 3.0f, 5.0f},
+			{2.0f, 3.0f, 1.0f},
+		};
+
+		auto inv = m.inv_affine();
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		auto mm = m;
+		mm.invert_affine();
+		tst::check_eq(mm, inv, SL);
+	});
+
+	suite.add("inv_rigid", []{
+		r4::matrix2<float> m;
+		m.set_identity();
+		m.translate(3, -4);
+		m.rotate(0.9f);
+
+		auto inv = m.inv_rigid();
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		diff = m.inv() - inv;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		auto mm = m;
+		mm.invert_rigid();
+		tst::check_eq(mm, inv, SL);
+	});
 });
 }
@@ -1,6 +1,7 @@
 #include <tst/set.hpp>
 #include <tst/check.hpp>
 
+#include "../../../src/r4/io.hpp"
 #include "../../../src/r4/matrix.hpp"
 
 using namespace std::string_literals;
@@ -420,5 +421,29 @@ const tst::set set("matrix3", [](tst::suite& suite){
 
 		tst::check_eq(diff, decltype(m)().set(0), SL);
 	});
+
+	suite.add("inv_det", []{
+		r4::matrix3<float> m{
+			{1, 3, 5},
+			{1, 3, 1},
+			{4, 3, 9},
+		};
+
+		auto [inv, det] = m.inv_det();
+
+		tst::check_eq(det, -36.0f, SL);
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		r4::matrix3<int> singular{
+			{1, 2, 3},
+			{4, 5, 6},
+			{7, 8, 9},
+		};
+
+		tst::check_eq(singular.inv_det().second, 0, SL);
+	});
 });
 }
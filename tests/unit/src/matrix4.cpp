@@ -1,6 +1,9 @@
+#include <cmath>
+
 #include <tst/set.hpp>
 #include <tst/check.hpp>
 
+#include "../../../src/r4/io.hpp"
 #include "../../../src/r4/matrix.hpp"
 
 using namespace std::string_literals;
@@ -755,6 +758,52 @@ const tst::set set("matrix4", [](tst::suite& suite){
 		tst::check_eq(m.to<int>(), cmp.to<int>(), SL);
 	});
 
+	suite.add("rotate_frustum_perspective_look_at__non_identity", []{
+		r4::matrix4<double> m{
+			{1, 2, 3, 4},
+			{5, -6, 7, 8},
+			{9, 10, 11, -12},
+			{13, 14, 15, 16}
+		};
+
+		auto check = [](const r4::matrix4<double>& a, const r4::matrix4<double>& b){
+			auto diff = a - b;
+			diff.snap_to_zero(1e-9);
+			tst::check_eq(diff, r4::matrix4<double>().set(0), SL);
+		};
+
+		{
+			auto q = r4::quaternion<double>().set_rotation(r4::vector3<double>{1, -2, 3}.normalize(), 0.7);
+			auto res = m;
+			res.rotate(q);
+			check(res, m * r4::matrix4<double>(q));
+		}
+
+		{
+			auto res = m;
+			res.frustum(-2, 3, -1.5, 1, 2, 100);
+			r4::matrix4<double> f;
+			f.set_frustum(-2, 3, -1.5, 1, 2, 100);
+			check(res, m * f);
+		}
+
+		{
+			auto res = m;
+			res.perspective(1.1, 16.0 / 9, 1, 10);
+			r4::matrix4<double> p;
+			p.set_perspective(1.1, 16.0 / 9, 1, 10);
+			check(res, m * p);
+		}
+
+		{
+			auto res = m;
+			res.look_at({3, 1, 2}, {0, 1, -1}, {0.1, 2, 0});
+			r4::matrix4<double> l;
+			l.set_look_at({3, 1, 2}, {0, 1, -1}, {0.1, 2, 0});
+			check(res, m * l);
+		}
+	});
+
 	suite.add("remove__r_c___and___minor__r_c", []{
 		r4::matrix4<int> m{
 			{1 , 2 , 3 , 4 },
@@ -936,6 +985,168 @@ const tst::set set("matrix4", [](tst::suite& suite){
 		tst::check_eq(diff, decltype(m)().set(0), SL);
 	});
 
+	suite.add("inv_det", []{
+		r4::matrix4<float> m{
+			{1, 3, 5, 9},
+			{1, 3, 1, 7},
+			{4, 3, 9, 7},
+			{5, 2, 0, 9}
+		};
+
+		auto [inv, det] = m.inv_det();
+
+		tst::check_eq(det, -376.0f, SL);
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		diff = decltype(m)().set_identity() - inv * m;
+		diff.snap_to_zero(1e-6f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+	});
+
+	suite.add("inv_det__double", []{
+		r4::matrix4<double> m{
+			{2, 0, 1, 3},
+			{0, 1, 4, 0},
+			{1, 5, 0, 2},
+			{7, 0, 0, 1}
+		};
+
+		auto [inv, det] = m.inv_det();
+
+		tst::check_eq(det, 2 * m.remove(0, 0).det() + m.remove(0, 2).det() - 3 * m.remove(0, 3).det(), SL);
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-12);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+	});
+
+	suite.add("inv_det__singular", []{
+		r4::matrix4<float> m{
+			{1, 2, 3, 4},
+			{5, 6, 7, 8},
+			{9, 10, 11, 12},
+			{13, 14, 15, 16}
+		};
+
+		// adjugate of the matrix of rank 2 is zero, so in SIMD and scalar implementations
+		// the inverse is calculated exactly as 0 / 0
+		auto [inv, det] = m.inv_det();
+		tst::check_eq(det, 0.0f, SL);
+		for(const auto& r : inv){
+			for(auto e : r){
+				tst::check(std::isnan(e), SL) << "inv = " << inv;
+			}
+		}
+
+		auto [inv_double, det_double] = m.to<double>().inv_det();
+		tst::check_eq(det_double, 0.0, SL);
+		for(const auto& r : inv_double){
+			for(auto e : r){
+				tst::check(std::isnan(e), SL) << "inv_double = " << inv_double;
+			}
+		}
+
+		r4::matrix4<int> mi{
+			{1, 2, 3, 4},
+			{2, 4, 6, 8},
+			{9, 10, 11, 12},
+			{13, 14, 15, 16}
+		};
+
+		tst::check_eq(mi.inv_det().second, 0, SL);
+
+		// for integral components the adjugate matrix is returned
+		r4::matrix4<int> projection{
+			{1, 0, 0, 0},
+			{0, 1, 0, 0},
+			{0, 0, 1, 0},
+			{0, 0, 0, 0}
+		};
+		auto [inv_int, det_int] = projection.inv_det();
+		tst::check_eq(det_int, 0, SL);
+		tst::check_eq(
+			inv_int,
+			r4::matrix4<int>{
+				{0, 0, 0, 0},
+				{0, 0, 0, 0},
+				{0, 0, 0, 0},
+				{0, 0, 0, 1}
+			},
+			SL
+		);
+	});
+
+	suite.add("inv_affine", []{
+		r4::matrix4<float> m;
+		m.set_identity();
+		m.translate(3, -4, 5);
+		m.rotate(r4::quaternion<float>().set_rotation(r4::vector3<float>{1, 2, 3}.normalize(), 0.7f));
+		m.scale(2, 3, 0.5f);
+
+		auto inv = m.inv_affine();
+
+		tst::check_eq(inv[3], r4::vector4<float>{0, 0, 0, 1}, SL);
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-5f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		diff = m.inv() - inv;
+		diff.snap_to_zero(1e-5f);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		auto mm = m;
+		mm.invert_affine();
+		tst::check_eq(mm, inv, SL);
+	});
+
+	suite.add("inv_affine__int", []{
+		r4::matrix4<int> m{
+			{1, 0, 0, 3},
+			{0, 1, 0, 4},
+			{0, 0, 1, 5},
+			{0, 0, 0, 1}
+		};
+
+		auto inv = m.inv_affine();
+
+		r4::matrix4<int> expected{
+			{1, 0, 0, -3},
+			{0, 1, 0, -4},
+			{0, 0, 1, -5},
+			{0, 0, 0, 1}
+		};
+
+		tst::check_eq(inv, expected, SL);
+	});
+
+	suite.add("inv_rigid", []{
+		r4::matrix4<double> m;
+		m.set_identity();
+		m.translate(3, -4, 5);
+		m.rotate(r4::quaternion<double>().set_rotation(r4::vector3<double>{1, 2, 3}.normalize(), 0.7));
+		m.rotate(r4::quaternion<double>().set_rotation(r4::vector3<double>{0, 1, 0}, -1.3));
+
+		auto inv = m.inv_rigid();
+
+		tst::check_eq(inv[3], r4::vector4<double>{0, 0, 0, 1}, SL);
+
+		auto diff = decltype(m)().set_identity() - m * inv;
+		diff.snap_to_zero(1e-12);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		diff = m.inv() - inv;
+		diff.snap_to_zero(1e-12);
+		tst::check_eq(diff, decltype(m)().set(0), SL);
+
+		auto mm = m;
+		mm.invert_rigid();
+		tst::check_eq(mm, inv, SL);
+	});
+
 	suite.add("operator_output", []{
 		r4::matrix4<int> m;
 		m.set_identity();
@@ -0,0 +1,148 @@
+#include <cmath>
+#include <vector>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/normal_encoding.hpp"
+
+#include "encoding_checks.hpp"
+
+namespace{
+template <typename encoding_type>
+struct codec{
+	using value_type = r4::vector3<float>;
+	using encoded_type = typename encoding_type::encoded_type;
+
+	static encoded_type encode(const value_type& v){
+		return r4::encode_normal<encoding_type>(v);
+	}
+
+	static value_type decode(const encoded_type& e){
+		return r4::decode_normal<encoding_type>(e);
+	}
+
+	static void encode_all(utki::span<const value_type> in, utki::span<encoded_type> out){
+		r4::encode_normals<encoding_type>(in, out);
+	}
+
+	static void decode_all(utki::span<const encoded_type> in, utki::span<value_type> out){
+		r4::decode_normals<encoding_type>(in, out);
+	}
+
+	static double error(const value_type& a, const value_type& b){
+		auto da = a.to<double>();
+		auto db = b.to<double>();
+		return encoding_checks::to_degrees(std::atan2(da.cross(db).norm(), da.dot(db)));
+	}
+};
+
+std::vector<r4::vector3<float>> make_normals(size_t size){
+	std::vector<r4::vector3<float>> ret;
+
+	// axes and diagonals, where octahedral encoding is folded
+	for(int x = -1; x <= 1; ++x){
+		for(int y = -1; y <= 1; ++y){
+			for(int z = -1; z <= 1; ++z){
+				if(x != 0 || y != 0 || z != 0){
+					ret.push_back(r4::vector3<double>(x, y, z).normalize().to<float>());
+				}
+			}
+		}
+	}
+
+	for(const auto& v : encoding_checks::random_units<3>(size - ret.size())){
+		ret.push_back(v.to<float>());
+	}
+	return ret;
+}
+
+template <typename encoding_type>
+void check_error(double max_error){
+	encoding_checks::check_error<codec<encoding_type>>(make_normals(100000), max_error);
+}
+
+template <typename encoding_type>
+void check_batch(){
+	encoding_checks::check_batch<codec<encoding_type>>(make_normals(1000 + 7));
+}
+
+template <typename encoding_type>
+void check_axes(){
+	for(size_t i = 0; i != 3; ++i){
+		for(float s : {1.0f, -1.0f}){
+			r4::vector3<float> axis{0, 0, 0};
+			axis[i] = s;
+			encoding_checks::check_exact<codec<encoding_type>>(axis, axis);
+		}
+	}
+}
+}
+
+namespace{
+const tst::set set("normal_encoding", [](tst::suite& suite){
+	suite.add("error_bounds", []{
+		check_error<r4::normal_encoding::octahedral16>(0.004);
+		check_error<r4::normal_encoding::octahedral8>(1);
+		check_error<r4::normal_encoding::unorm_10_10_10_2>(0.1);
+		check_error<r4::normal_encoding::snorm_10_10_10_2>(0.1);
+		check_error<r4::normal_encoding::snorm16>(0.002);
+	});
+
+	suite.add("batch", []{
+		check_batch<r4::normal_encoding::octahedral16>();
+		check_batch<r4::normal_encoding::octahedral8>();
+		check_batch<r4::normal_encoding::unorm_10_10_10_2>();
+		check_batch<r4::normal_encoding::snorm_10_10_10_2>();
+		check_batch<r4::normal_encoding::snorm16>();
+	});
+
+	suite.add("axes", []{
+		check_axes<r4::normal_encoding::octahedral16>();
+		check_axes<r4::normal_encoding::octahedral8>();
+		check_axes<r4::normal_encoding::snorm_10_10_10_2>();
+		check_axes<r4::normal_encoding::snorm16>();
+	});
+
+	suite.add("octahedral", []{
+		using r4::normal_encoding::octahedral16;
+		tst::check_eq(r4::encode_normal<octahedral16>({0, 0, 1}), r4::vector2<int16_t>(0, 0), SL);
+		tst::check_eq(r4::encode_normal<octahedral16>({1, 0, 0}), r4::vector2<int16_t>(32767, 0), SL);
+		tst::check_eq(r4::encode_normal<octahedral16>({0, -1, 0}), r4::vector2<int16_t>(0, -32767), SL);
+
+		// the lower hemisphere is mapped to the corners of the square
+		tst::check_eq(r4::encode_normal<octahedral16>({0, 0, -1}), r4::vector2<int16_t>(32767, 32767), SL);
+
+		// any code decodes to a unit vector, including -32768
+		auto d = r4::decode_normal<octahedral16>({-32768, -32768});
+		tst::check_eq(d, r4::vector3<float>(0, 0, -1), SL);
+	});
+
+	suite.add("packed_10_10_10_2", []{
+		using r4::normal_encoding::snorm_10_10_10_2;
+		using r4::normal_encoding::unorm_10_10_10_2;
+
+		tst::check_eq(r4::encode_normal<snorm_10_10_10_2>({1, 0, 0}), uint32_t(0x1ff), SL);
+		tst::check_eq(r4::encode_normal<snorm_10_10_10_2>({-1, 0, 0}), uint32_t(0x201), SL);
+		tst::check_eq(r4::encode_normal<snorm_10_10_10_2>({0, 0, -1}), uint32_t(0x201 << 20), SL);
+
+		// 0 is mapped to 511.5, which rounds to even
+		tst::check_eq(r4::encode_normal<unorm_10_10_10_2>({0, 0, 1}), uint32_t(512 | (512 << 10) | (1023 << 20)), SL);
+		tst::check_eq(r4::encode_normal<unorm_10_10_10_2>({0, -1, 0}), uint32_t(512 | (512 << 20)), SL);
+
+		// the upper 2 bits are ignored
+		tst::check_eq(r4::decode_normal<snorm_10_10_10_2>(0xc00001ff), r4::vector3<float>(1, 0, 0), SL);
+
+		// -512 decodes same as -511
+		tst::check_eq(r4::decode_normal<snorm_10_10_10_2>(0x200), r4::vector3<float>(-1, 0, 0), SL);
+	});
+
+	suite.add("snorm16", []{
+		using r4::normal_encoding::snorm16;
+		tst::check_eq(r4::encode_normal<snorm16>({0, 1, 0}), r4::vector3<int16_t>(0, 32767, 0), SL);
+		tst::check_eq(r4::encode_normal<snorm16>({0, 0, -1}), r4::vector3<int16_t>(0, 0, -32767), SL);
+		tst::check_eq(r4::decode_normal<snorm16>({0, 0, -32768}), r4::vector3<float>(0, 0, -1), SL);
+	});
+});
+}
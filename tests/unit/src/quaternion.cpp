@@ -1,6 +1,7 @@
 #include <tst/set.hpp>
 #include <tst/check.hpp>
 
+#include "../../../src/r4/io.hpp"
 #include "../../../src/r4/quaternion.hpp"
 
 // declare templates to instantiate all template methods to include all methods to gcov coverage
@@ -400,6 +401,41 @@ const tst::set set("quaternion", [](tst::suite& suite){
 		tst::check_eq(r[2], 4672, SL);
 	});
 
+	suite.add("float_matches_double", []{
+		// float quaternion operations may be SIMD accelerated, check those against double precision results
+		const float eps = 1e-5f;
+
+		auto check = [&eps](auto f, const auto& d){
+			auto diff = f.template to<double>() - d;
+			tst::check_lt(diff.norm(), double(eps), SL) << "f = " << f << ", d = " << d;
+		};
+
+		for(int i = 0; i != 16; ++i){
+			r4::quaternion<double> a{r4::vector3<double>{0.3 * i - 2, 1.0 - 0.1 * i, 0.05 * i * i}, 0.7 - 0.2 * i};
+			r4::quaternion<double> b{r4::vector3<double>{1.0 - 0.1 * i, -0.4 * i, 0.2 + 0.1 * i}, 0.3 * i - 1};
+			a.normalize();
+			b.normalize();
+			r4::vector3<double> v{1.5 - i, 0.25 * i, 3};
+
+			auto af = a.to<float>();
+			auto bf = b.to<float>();
+			auto vf = v.to<float>();
+
+			check(af * bf, a * b);
+			check((af * bf).normalize(), (a * b).normalize());
+			check(af.slerp(bf, 0.3f), a.slerp(b, 0.3));
+
+			tst::check_lt(std::abs(double(af.dot(bf)) - a.dot(b)), double(eps), SL);
+
+			auto rot_diff = af.rot(vf).to<double>() - a.rot(v);
+			tst::check_lt(rot_diff.norm(), 1e-5 * v.norm(), SL);
+
+			auto unnormalized = af * 3.5f;
+			unnormalized.normalize();
+			check(unnormalized, a);
+		}
+	});
+
 	suite.add("to_matrix3", []{
 		r4::vector3<float> v{2, 3, 4};
 
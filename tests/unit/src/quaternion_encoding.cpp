@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/quaternion_encoding.hpp"
+
+#include "encoding_checks.hpp"
+
+namespace{
+template <typename encoding_type>
+struct codec{
+	using value_type = r4::quaternion<float>;
+	using encoded_type = typename encoding_type::encoded_type;
+
+	static encoded_type encode(const value_type& q){
+		return r4::compress_quaternion<encoding_type>(q);
+	}
+
+	static value_type decode(const encoded_type& e){
+		return r4::decompress_quaternion<encoding_type>(e);
+	}
+
+	static void encode_all(utki::span<const value_type> in, utki::span<encoded_type> out){
+		r4::compress_quaternions<encoding_type>(in, out);
+	}
+
+	static void decode_all(utki::span<const encoded_type> in, utki::span<value_type> out){
+		r4::decompress_quaternions<encoding_type>(in, out);
+	}
+
+	// angle of rotation from one quaternion to another,
+	// acos() of the dot product is not used since it loses precision for small angles
+	static double error(const value_type& a, const value_type& b){
+		auto da = to_double(a);
+		auto db = to_double(b);
+		if(da.dot(db) < 0){
+			db = -db;
+		}
+		return encoding_checks::to_degrees(4 * std::asin((da - db).norm() / 2));
+	}
+
+private:
+	static r4::quaternion<double> to_double(const value_type& q){
+		r4::quaternion<double> ret(q.x(), q.y(), q.z(), q.w());
+		return ret.normalize();
+	}
+};
+
+std::vector<r4::quaternion<float>> make_quaternions(size_t size){
+	std::vector<r4::quaternion<float>> ret = {
+		{0, 0, 0, 1},
+		{0, 0, 0, -1},
+		{1, 0, 0, 0},
+		{0, -1, 0, 0},
+		// equal largest components
+		{0.5f, 0.5f, 0.5f, 0.5f},
+		{-0.5f, 0.5f, -0.5f, 0.5f},
+		{float(std::sqrt(0.5)), 0, 0, float(std::sqrt(0.5))},
+		{0, float(-std::sqrt(0.5)), float(std::sqrt(0.5)), 0},
+	};
+
+	for(const auto& v : encoding_checks::random_units<4>(size - ret.size())){
+		ret.emplace_back(float(v[0]), float(v[1]), float(v[2]), float(v[3]));
+	}
+	return ret;
+}
+
+template <typename encoding_type>
+void check_error(double max_error){
+	encoding_checks::check_error<codec<encoding_type>>(make_quaternions(100000), max_error);
+}
+
+template <typename encoding_type>
+void check_batch(){
+	encoding_checks::check_batch<codec<encoding_type>>(make_quaternions(1000 + 7));
+}
+
+// q and -q are compressed to the same value, the largest component of the decompressed quaternion is positive
+template <typename encoding_type>
+void check_sign(){
+	for(const auto& q : make_quaternions(1000)){
+		auto e = r4::compress_quaternion<encoding_type>(q);
+		tst::check(r4::compress_quaternion<encoding_type>(-q) == e, SL) << "q = " << q;
+
+		const std::array<float, 4> c = {q.x(), q.y(), q.z(), q.w()};
+		auto largest = std::distance(
+			c.begin(),
+			std::max_element(c.begin(), c.end(), [](float a, float b){
+				return std::abs(a) < std::abs(b);
+			})
+		);
+
+		auto d = r4::decompress_quaternion<encoding_type>(e);
+		const std::array<float, 4> dc = {d.x(), d.y(), d.z(), d.w()};
+		tst::check_gt(dc[largest], 0.0f, SL) << "q = " << q;
+	}
+}
+
+template <typename encoding_type>
+void check_axes(){
+	for(size_t i = 0; i != 4; ++i){
+		std::array<float, 4> c = {0, 0, 0, 0};
+		c[i] = 1;
+		r4::quaternion<float> q(c[0], c[1], c[2], c[3]);
+		encoding_checks::check_exact<codec<encoding_type>>(q, q);
+		encoding_checks::check_exact<codec<encoding_type>>(-q, q);
+	}
+}
+}
+
+namespace{
+const tst::set set("quaternion_encoding", [](tst::suite& suite){
+	suite.add("error_bounds", []{
+		check_error<r4::quaternion_encoding::smallest_three32>(0.3);
+		check_error<r4::quaternion_encoding::smallest_three48>(0.01);
+	});
+
+	suite.add("batch", []{
+		check_batch<r4::quaternion_encoding::smallest_three32>();
+		check_batch<r4::quaternion_encoding::smallest_three48>();
+	});
+
+	suite.add("sign", []{
+		check_sign<r4::quaternion_encoding::smallest_three32>();
+		check_sign<r4::quaternion_encoding::smallest_three48>();
+	});
+
+	suite.add("axes", []{
+		check_axes<r4::quaternion_encoding::smallest_three32>();
+		check_axes<r4::quaternion_encoding::smallest_three48>();
+	});
+
+	suite.add("smallest_three32", []{
+		using r4::quaternion_encoding::smallest_three32;
+		tst::check_eq(r4::compress_quaternion<smallest_three32>({0, 0, 0, 1}), uint32_t(3) << 30, SL);
+		tst::check_eq(r4::compress_quaternion<smallest_three32>({0, -1, 0, 0}), uint32_t(1) << 30, SL);
+
+		// the first of the equal largest components is restored, the others are 0.5 * sqrt(2) * 511 = 361.3
+		tst::check_eq(r4::compress_quaternion<smallest_three32>({0.5f, 0.5f, 0.5f, 0.5f}), uint32_t(361 | (361 << 10) | (361 << 20)), SL);
+		tst::check_eq(r4::compress_quaternion<smallest_three32>({-0.5f, 0.5f, 0.5f, 0.5f}), uint32_t(0x297 | (0x297 << 10) | (0x297 << 20)), SL);
+
+		// the sum of squares of the smallest three exceeds 1, the largest component becomes 0
+		auto d = r4::decompress_quaternion<smallest_three32>(uint32_t(0x1ff | (0x1ff << 10) | (0x1ff << 20)));
+		tst::check_eq(d.x(), 0.0f, SL);
+	});
+
+	suite.add("smallest_three48", []{
+		using r4::quaternion_encoding::smallest_three48;
+		using encoded_type = smallest_three48::encoded_type;
+		tst::check(r4::compress_quaternion<smallest_three48>({0, 0, 0, 1}) == encoded_type{0x8000, 0x8000, 0}, SL);
+		tst::check(r4::compress_quaternion<smallest_three48>({0, 0, -1, 0}) == encoded_type{0, 0x8000, 0}, SL);
+		tst::check(r4::compress_quaternion<smallest_three48>({0, 1, 0, 0}) == encoded_type{0x8000, 0, 0}, SL);
+
+		// y is the largest, 0.5 * sqrt(2) * 16383 = 11584.53, 0.1 * sqrt(2) * 16383 = 2316.9
+		tst::check(r4::compress_quaternion<smallest_three48>({0.5f, 0.7f, 0.1f, -0.5f}) == encoded_type{0x8000 | 11585, 2317, 0x7fff & uint16_t(-11585)}, SL);
+	});
+});
+}
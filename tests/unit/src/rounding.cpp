@@ -0,0 +1,131 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/rounding.hpp"
+
+namespace{
+std::vector<float> make_values(size_t size){
+	std::vector<float> ret = {
+		0.0f, -0.0f,
+		0.5f, -0.5f, 1.5f, -1.5f, 2.5f, -2.5f, // halfway cases are rounded away from zero
+		0.49999997f, -0.49999997f, // largest float below 0.5
+		1.0f, -1.0f, 0.1f, -0.1f, 0.9f, -0.9f,
+		8388607.5f, -8388607.5f, // 2^23 - 0.5
+		8388609.0f, -8388609.0f, // above 2^23 all floats are integers
+		2147483520.0f, -2147483520.0f, // largest float below 2^31
+		-2147483648.0f
+	};
+
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<float> small(-10, 10);
+	std::uniform_real_distribution<float> large(-1e9f, 1e9f);
+	while(ret.size() != size){
+		ret.push_back(ret.size() % 2 == 0 ? small(gen) : large(gen));
+	}
+	return ret;
+}
+
+// results of SIMD rounding are same as of std::round(), std::floor() and std::ceil()
+template <size_t dimension>
+void check_vector(){
+	const auto values = make_values(1000 * dimension);
+
+	for(size_t i = 0; i != values.size(); i += dimension){
+		r4::vector<float, dimension> v{};
+		for(size_t j = 0; j != dimension; ++j){
+			v[j] = values[i + j];
+		}
+
+		auto r = v.template to_rounded<int>();
+		auto f = v.template to_floored<int>();
+		auto c = v.template to_ceiled<int>();
+		for(size_t j = 0; j != dimension; ++j){
+			tst::check_eq(r[j], int(std::round(v[j])), SL) << "v[j] = " << v[j];
+			tst::check_eq(f[j], int(std::floor(v[j])), SL) << "v[j] = " << v[j];
+			tst::check_eq(c[j], int(std::ceil(v[j])), SL) << "v[j] = " << v[j];
+		}
+	}
+}
+
+// span forms give same results as the member functions, including the tail which does not fill whole group
+template <typename element_type, typename int_element_type, typename make_element_type>
+void check_span(make_element_type make_element){
+	const auto values = make_values(4 * 1003);
+	std::vector<element_type> in;
+	for(size_t i = 0; i != values.size() / 4; ++i){
+		in.push_back(make_element(&values[i * 4]));
+	}
+
+	std::vector<int_element_type> rounded(in.size());
+	std::vector<int_element_type> floored(in.size());
+	std::vector<int_element_type> ceiled(in.size());
+	const auto& const_in = in;
+	r4::to_rounded(utki::make_span(const_in), utki::make_span(rounded));
+	r4::to_floored(utki::make_span(const_in), utki::make_span(floored));
+	r4::to_ceiled(utki::make_span(const_in), utki::make_span(ceiled));
+
+	for(size_t i = 0; i != in.size(); ++i){
+		tst::check(rounded[i] == in[i].template to_rounded<int>(), SL) << "i = " << i;
+		tst::check(floored[i] == in[i].template to_floored<int>(), SL) << "i = " << i;
+		tst::check(ceiled[i] == in[i].template to_ceiled<int>(), SL) << "i = " << i;
+	}
+}
+}
+
+namespace{
+const tst::set set("rounding", [](tst::suite& suite){
+	suite.add("vector2", []{
+		const r4::vector2<float> v{2.5f, -2.5f};
+		tst::check_eq(v.to_rounded<int>(), r4::vector2<int>(3, -3), SL);
+		tst::check_eq(v.to_floored<int>(), r4::vector2<int>(2, -3), SL);
+		tst::check_eq(v.to_ceiled<int>(), r4::vector2<int>(3, -2), SL);
+		tst::check_eq(v.to_rounded<int>(), round(v).to<int>(), SL);
+	});
+
+	suite.add("vector_dimensions", []{
+		check_vector<1>();
+		check_vector<2>();
+		check_vector<3>();
+		check_vector<4>();
+		check_vector<5>();
+		check_vector<8>();
+	});
+
+	suite.add("vector_double", []{
+		const r4::vector3<double> v{0.5, -1.25, 7.75};
+		tst::check_eq(v.to_rounded<int>(), r4::vector3<int>(1, -1, 8), SL);
+		tst::check_eq(v.to_floored<int>(), r4::vector3<int>(0, -2, 7), SL);
+		tst::check_eq(v.to_ceiled<int>(), r4::vector3<int>(1, -1, 8), SL);
+	});
+
+	suite.add("rectangle", []{
+		const r4::rectangle<float> r{0.5f, -1.5f, 10.4f, 10.6f};
+		tst::check_eq(r.to_rounded<int>(), r4::rectangle<int>(1, -2, 10, 11), SL);
+		tst::check_eq(r.to_floored<int>(), r4::rectangle<int>(0, -2, 10, 10), SL);
+		tst::check_eq(r.to_ceiled<int>(), r4::rectangle<int>(1, -1, 11, 11), SL);
+	});
+
+	suite.add("span_vector2", []{
+		check_span<r4::vector2<float>, r4::vector2<int>>([](const float* p){
+			return r4::vector2<float>(p[0], p[1]);
+		});
+	});
+
+	suite.add("span_vector3", []{
+		check_span<r4::vector3<float>, r4::vector3<int>>([](const float* p){
+			return r4::vector3<float>(p[0], p[1], p[2]);
+		});
+	});
+
+	suite.add("span_rectangle", []{
+		check_span<r4::rectangle<float>, r4::rectangle<int>>([](const float* p){
+			return r4::rectangle<float>(p[0], p[1], p[2], p[3]);
+		});
+	});
+});
+}
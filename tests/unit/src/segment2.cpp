@@ -1,6 +1,7 @@
 #include <tst/set.hpp>
 #include <tst/check.hpp>
 
+#include <r4/io.hpp>
 #include <r4/segment2.hpp>
 
 // declare templates to instantiate all template methods to include all methods to gcov coverage
@@ -0,0 +1,113 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <r4/io.hpp>
+#include <r4/slerp.hpp>
+
+namespace{
+// slerp without small angle approximation, in double precision
+r4::quaternion<double> reference_slerp(r4::quaternion<double> a, r4::quaternion<double> b, double t){
+	double d = a.dot(b);
+	if(d < 0){
+		b.negate();
+		d = -d;
+	}
+
+	using std::min;
+	using std::acos;
+	using std::sin;
+	double alpha = acos(min(d, 1.0));
+	if(alpha < 1e-9){
+		return a;
+	}
+	return a * (sin((1 - t) * alpha) / sin(alpha)) + b * (sin(t * alpha) / sin(alpha));
+}
+
+template <typename component_type>
+void check_slerp(r4::slerp_accuracy accuracy, double max_error){
+	std::vector<r4::quaternion<component_type>> a;
+	std::vector<r4::quaternion<component_type>> b;
+	std::vector<component_type> t;
+
+	// number of quaternions is not a multiple of SIMD width to check the tail processing
+	for(int i = 0; i != 37; ++i){
+		auto p = r4::quaternion<double>(r4::vector3<double>{0.3 * i - 2, 1.0 - 0.1 * i, 0.05 * i}, 0.7 - 0.2 * i).normalize();
+		auto q = r4::quaternion<double>(r4::vector3<double>{1.0 - 0.1 * i, -0.4 * i, 0.2 + 0.1 * i}, 0.3 * i - 1).normalize();
+		a.push_back(p.to<component_type>());
+		b.push_back(q.to<component_type>());
+		t.push_back(component_type(double(i % 11) / 10));
+	}
+
+	std::vector<r4::quaternion<component_type>> out(a.size());
+
+	r4::slerp(
+		utki::make_span(std::as_const(a)),
+		utki::make_span(std::as_const(b)),
+		utki::make_span(std::as_const(t)),
+		utki::make_span(out),
+		accuracy
+	);
+
+	for(size_t i = 0; i != a.size(); ++i){
+		auto expected = reference_slerp(a[i].template to<double>(), b[i].template to<double>(), double(t[i]));
+		auto diff = out[i].template to<double>() - expected;
+		tst::check_lt(diff.norm(), max_error, SL) << "i = " << i << ", out = " << out[i] << ", expected = " << expected;
+		tst::check_lt(std::abs(out[i].norm() - component_type(1)), component_type(1e-5), SL);
+	}
+
+	// in-place gives same results as the separate output
+	auto in_place = a;
+	r4::slerp(
+		utki::make_span(std::as_const(in_place)),
+		utki::make_span(std::as_const(b)),
+		utki::make_span(std::as_const(t)),
+		utki::make_span(in_place),
+		accuracy
+	);
+	for(size_t i = 0; i != a.size(); ++i){
+		tst::check_eq(in_place[i], out[i], SL) << "i = " << i;
+	}
+}
+}
+
+namespace{
+const tst::set set("slerp", [](tst::suite& suite){
+	suite.add("float", []{
+		check_slerp<float>(r4::slerp_accuracy::exact, 3e-3);
+		check_slerp<float>(r4::slerp_accuracy::corrected_nlerp, 5e-4);
+		check_slerp<float>(r4::slerp_accuracy::nlerp, 0.075);
+	});
+
+	suite.add("double", []{
+		check_slerp<double>(r4::slerp_accuracy::exact, 3e-3);
+		check_slerp<double>(r4::slerp_accuracy::corrected_nlerp, 5e-4);
+		check_slerp<double>(r4::slerp_accuracy::nlerp, 0.075);
+	});
+
+	suite.add("end_points", []{
+		std::vector<r4::quaternion<float>> a = {
+			r4::quaternion<float>(r4::vector3<float>{0, 0, 1}, 0).normalize(),
+			r4::quaternion<float>(r4::vector3<float>{1, 1, 0}, 1).normalize()
+		};
+		std::vector<r4::quaternion<float>> b = {
+			r4::quaternion<float>(r4::vector3<float>{0, 1, 0}, 1).normalize(),
+			// opposite sign, same rotation as a[1]
+			r4::quaternion<float>(r4::vector3<float>{-1, -1, 0}, -1).normalize()
+		};
+
+		for(auto accuracy : {r4::slerp_accuracy::exact, r4::slerp_accuracy::corrected_nlerp, r4::slerp_accuracy::nlerp}){
+			std::vector<r4::quaternion<float>> out(a.size());
+
+			std::vector<float> t = {0, 0.5f};
+			r4::slerp(utki::make_span(std::as_const(a)), utki::make_span(std::as_const(b)), utki::make_span(std::as_const(t)), utki::make_span(out), accuracy);
+			tst::check_lt((out[0] - a[0]).norm(), 1e-6f, SL);
+			tst::check_lt((out[1] - a[1]).norm(), 1e-6f, SL);
+
+			t = {1, 1};
+			r4::slerp(utki::make_span(std::as_const(a)), utki::make_span(std::as_const(b)), utki::make_span(std::as_const(t)), utki::make_span(out), accuracy);
+			tst::check_lt((out[0] - b[0]).norm(), 1e-6f, SL);
+			tst::check_lt((out[1] + b[1]).norm(), 1e-6f, SL);
+		}
+	});
+});
+}
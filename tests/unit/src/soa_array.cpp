@@ -0,0 +1,179 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/soa_array.hpp"
+
+// declare templates to instantiate all template methods to include all methods to gcov coverage
+template class r4::soa_array<float, 3>;
+
+namespace{
+std::vector<r4::vector3<float>> make_vectors(size_t size){
+	std::vector<r4::vector3<float>> ret;
+	for(size_t i = 0; i != size; ++i){
+		auto f = float(i);
+		ret.emplace_back(f - 10, f * 0.5f, (i % 3 == 0) ? -f : 1.0f);
+	}
+	return ret;
+}
+}
+
+namespace{
+const tst::set set("soa_array", [](tst::suite& suite){
+	suite.add("constructor__size", []{
+		r4::soa_array3<float> a(21);
+
+		tst::check_eq(a.size(), size_t(21), SL);
+		tst::check_ge(a.capacity(), a.size(), SL);
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check(a.get(i).is_zero(), SL);
+		}
+
+		for(size_t c = 0; c != 3; ++c){
+			auto s = a.stream(c);
+			tst::check_eq(s.size(), a.size(), SL);
+			tst::check_eq(reinterpret_cast<uintptr_t>(s.data()) % r4::soa_array3<float>::alignment, uintptr_t(0), SL);
+		}
+	});
+
+	suite.add("constructor__span", []{
+		auto vecs = make_vectors(37);
+		r4::soa_array3<float> a(utki::make_span(vecs));
+
+		tst::check_eq(a.size(), vecs.size(), SL);
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check_eq(a.get(i), vecs[i], SL);
+			tst::check_eq(a.stream(1)[i], vecs[i].y(), SL);
+		}
+
+		std::vector<r4::vector3<float>> out(a.size());
+		a.to_aos(utki::make_span(out));
+		tst::check(out == vecs, SL);
+	});
+
+	suite.add("proxy_reference", []{
+		r4::soa_array3<float> a(3);
+
+		a[1] = r4::vector3<float>{1, 2, 3};
+		a[2] = a[1];
+		a[2][0] = 10;
+
+		r4::vector3<float> v = a[2];
+
+		tst::check_eq(v, r4::vector3<float>{10, 2, 3}, SL);
+		tst::check_eq(a.get(1), r4::vector3<float>{1, 2, 3}, SL);
+		tst::check(a.get(0).is_zero(), SL);
+	});
+
+	suite.add("push_back_resize_copy", []{
+		auto vecs = make_vectors(50);
+
+		r4::soa_array3<float> a;
+		for(const auto& v : vecs){
+			a.push_back(v);
+		}
+
+		tst::check_eq(a.size(), vecs.size(), SL);
+
+		auto b = a;
+		a.resize(10);
+		tst::check_eq(a.size(), size_t(10), SL);
+		tst::check_eq(b.size(), vecs.size(), SL);
+
+		a.resize(20);
+		for(size_t i = 0; i != 10; ++i){
+			tst::check_eq(a.get(i), vecs[i], SL);
+		}
+		for(size_t i = 10; i != 20; ++i){
+			tst::check(a.get(i).is_zero(), SL);
+		}
+		for(size_t i = 0; i != b.size(); ++i){
+			tst::check_eq(b.get(i), vecs[i], SL);
+		}
+
+		auto c = std::move(b);
+		tst::check_eq(c.size(), vecs.size(), SL);
+		tst::check(b.empty(), SL);
+	});
+
+	suite.add("dot_norm", []{
+		auto va = make_vectors(29);
+		auto vb = make_vectors(29);
+		std::reverse(vb.begin(), vb.end());
+
+		r4::soa_array3<float> a(utki::make_span(va));
+		r4::soa_array3<float> b(utki::make_span(vb));
+
+		std::vector<float> dots(a.size());
+		a.dot(b, utki::make_span(dots));
+
+		std::vector<float> norms(a.size());
+		a.norm(utki::make_span(norms));
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check_eq(dots[i], va[i].dot(vb[i]), SL);
+			tst::check_eq(norms[i], va[i].norm(), SL);
+		}
+	});
+
+	suite.add("normalize", []{
+		auto vecs = make_vectors(35);
+		vecs[10].set(0);
+
+		r4::soa_array3<float> a(utki::make_span(vecs));
+		a.normalize();
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check_eq(a.get(i), vecs[i].normed(), SL) << " i = " << i;
+		}
+	});
+
+	suite.add("normalize_int", []{
+		// the padding and zero vectors must not be divided by zero
+		r4::soa_array3<int> a(3);
+		a[0] = r4::vector3<int>{3, 4, 0};
+		a[2] = r4::vector3<int>{0, -7, 0};
+		a.normalize();
+
+		tst::check_eq(a.get(0), r4::vector3<int>{3, 4, 0}.normed(), SL);
+		tst::check_eq(a.get(1), r4::vector3<int>{1, 0, 0}, SL);
+		tst::check_eq(a.get(2), r4::vector3<int>{0, -1, 0}, SL);
+	});
+
+	suite.add("lerp", []{
+		auto va = make_vectors(19);
+		auto vb = make_vectors(19);
+		std::reverse(vb.begin(), vb.end());
+
+		r4::soa_array3<float> a(utki::make_span(va));
+		r4::soa_array3<float> b(utki::make_span(vb));
+
+		a.lerp(b, 0.25f);
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check_eq(a.get(i), va[i] + (vb[i] - va[i]) * 0.25f, SL);
+		}
+	});
+
+	suite.add("comp_op", []{
+		auto vecs = make_vectors(13);
+
+		r4::soa_array3<float> a(utki::make_span(vecs));
+
+		auto b = a.comp_op([](float c){
+			return c * 2;
+		});
+
+		auto c = a.comp_op(b, [](float x, float y){
+			return x + y;
+		});
+
+		for(size_t i = 0; i != a.size(); ++i){
+			tst::check_eq(b.get(i), vecs[i] * 2.0f, SL);
+			tst::check_eq(c.get(i), vecs[i] * 3.0f, SL);
+		}
+	});
+});
+}
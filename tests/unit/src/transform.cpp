@@ -0,0 +1,81 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include <r4/io.hpp>
+#include <r4/transform.hpp>
+
+namespace{
+template <typename component_type>
+r4::matrix4<component_type> make_matrix(){
+	r4::matrix4<component_type> m{
+		{1, 2, 3, 4},
+		{5, 6, 7, 8},
+		{9, 10, 11, 12},
+		{1, 1, 2, 2}
+	};
+	return m;
+}
+
+template <typename component_type>
+std::vector<r4::vector3<component_type>> make_points(){
+	std::vector<r4::vector3<component_type>> ret;
+	for(int i = 0; i != 19; ++i){
+		ret.emplace_back(i, -i, 2 * i + 1);
+	}
+	return ret;
+}
+
+template <typename component_type>
+void check_transforms(){
+	auto m = make_matrix<component_type>();
+	const auto in = make_points<component_type>();
+
+	std::vector<r4::vector3<component_type>> points(in.size());
+	std::vector<r4::vector3<component_type>> dirs(in.size());
+	std::vector<r4::vector3<component_type>> homs(in.size());
+
+	r4::transform_points(m, utki::make_span(in), utki::make_span(points));
+	r4::transform_directions(m, utki::make_span(in), utki::make_span(dirs));
+	r4::transform_homogeneous(m, utki::make_span(in), utki::make_span(homs));
+
+	for(size_t i = 0; i != in.size(); ++i){
+		auto p = m * in[i];
+		tst::check_eq(points[i], r4::vector3<component_type>(p), SL);
+
+		auto d = m * r4::vector4<component_type>(in[i], 0);
+		tst::check_eq(dirs[i], r4::vector3<component_type>(d), SL);
+
+		auto h = r4::vector3<component_type>(p) / p.w();
+		tst::check_eq(homs[i], h, SL);
+	}
+
+	// in-place transformation
+	auto inplace = in;
+	r4::transform_points(m, utki::span<const r4::vector3<component_type>>(inplace), utki::make_span(inplace));
+	tst::check(inplace == points, SL);
+}
+}
+
+namespace{
+const tst::set set("transform", [](tst::suite& suite){
+	suite.add("transform__float", []{
+		check_transforms<float>();
+	});
+
+	suite.add("transform__double", []{
+		check_transforms<double>();
+	});
+
+	suite.add("transform__int", []{
+		auto m = make_matrix<int>();
+		const auto in = make_points<int>();
+		std::vector<r4::vector3<int>> out(in.size());
+
+		r4::transform_points(m, utki::make_span(in), utki::make_span(out));
+
+		for(size_t i = 0; i != in.size(); ++i){
+			tst::check_eq(out[i], r4::vector3<int>(m * in[i]), SL);
+		}
+	});
+});
+}
@@ -1,6 +1,7 @@
 #include <tst/set.hpp>
 #include <tst/check.hpp>
 
+#include "../../../src/r4/io.hpp"
 #include "../../../src/r4/vector.hpp"
 
 // declare templates to instantiate all template methods to include all methods to gcov coverage
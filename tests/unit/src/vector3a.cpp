@@ -0,0 +1,192 @@
+#include <cfenv>
+
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/vector3a.hpp"
+
+// declare templates to instantiate all template methods to include all methods to gcov coverage
+template class r4::vector3a<float>;
+template class r4::vector3a<double>;
+template class r4::vector3a<int>;
+
+namespace{
+// puts given value to the padding component, to check that it does not affect the results
+template <typename component_type>
+r4::vector3a<component_type> with_padding(const r4::vector3a<component_type>& v, component_type padding){
+	auto ret = v;
+	std::next(reinterpret_cast<component_type*>(&ret), 3)[0] = padding;
+	return ret;
+}
+
+template <typename component_type>
+void check_ops(){
+	using vector3a = r4::vector3a<component_type>;
+	using vector3 = r4::vector3<component_type>;
+
+	const vector3 a3{1, -2, 3};
+	const vector3 b3{4, 5, -6};
+	const vector3a a = with_padding(vector3a(a3), component_type(100));
+	const vector3a b = with_padding(vector3a(b3), component_type(-7));
+
+	tst::check_eq(vector3(a + b), a3 + b3, SL);
+	tst::check_eq(vector3(a - b), a3 - b3, SL);
+	tst::check_eq(vector3(-a), -a3, SL);
+	tst::check_eq(vector3(a * component_type(2)), a3 * component_type(2), SL);
+	tst::check_eq(vector3(component_type(2) * a), component_type(2) * a3, SL);
+	tst::check_eq(vector3(a / component_type(2)), a3 / component_type(2), SL);
+	tst::check_eq(vector3(a.comp_mul(b)), a3.comp_mul(b3), SL);
+	tst::check_eq(vector3(a.comp_div(b)), a3.comp_div(b3), SL);
+	tst::check_eq(vector3(a.cross(b)), a3.cross(b3), SL);
+	tst::check_eq(vector3(min(a, b)), min(a3, b3), SL);
+	tst::check_eq(vector3(max(a, b)), max(a3, b3), SL);
+	tst::check_eq(vector3(abs(a)), abs(a3), SL);
+	tst::check_eq(a.dot(b), a3.dot(b3), SL);
+	tst::check_eq(a.norm_pow2(), a3.norm_pow2(), SL);
+	tst::check_eq(a.norm(), a3.norm(), SL);
+
+	{
+		vector3a v = a;
+		v += b;
+		tst::check_eq(vector3(v), a3 + b3, SL);
+		v -= b;
+		tst::check_eq(vector3(v), a3, SL);
+		v *= component_type(3);
+		tst::check_eq(vector3(v), a3 * component_type(3), SL);
+		v /= component_type(3);
+		tst::check_eq(vector3(v), a3, SL);
+		v.comp_multiply(b);
+		tst::check_eq(vector3(v), a3.comp_mul(b3), SL);
+		v.comp_divide(b);
+		tst::check_eq(vector3(v), a3, SL);
+		v.negate();
+		tst::check_eq(vector3(v), -a3, SL);
+	}
+}
+
+// division of the zero padding lane must not raise FE_INVALID, as the scalar implementation does not raise it
+template <typename component_type>
+void check_division_raises_no_invalid(){
+	// volatile to prevent compile-time evaluation of the divisions
+	volatile component_type one = 1;
+	const r4::vector3a<component_type> a{one, 2, 3};
+	const r4::vector3a<component_type> b{4, one, 5};
+
+	std::feclearexcept(FE_ALL_EXCEPT);
+
+	auto q = a.comp_div(b);
+	q.comp_divide(b);
+	q = q / component_type(2);
+	q /= component_type(2);
+	auto z = r4::vector3a<component_type>{one, 2, 3} / component_type(0);
+
+	tst::check(!std::fetestexcept(FE_INVALID), SL);
+	tst::check_eq(r4::vector3<component_type>(q), a.comp_div(b).comp_div(b) / component_type(4), SL);
+	tst::check(z.is_positive(), SL);
+}
+}
+
+namespace{
+const tst::set set("vector3a", [](tst::suite& suite){
+	suite.add("size_and_alignment", []{
+		tst::check_eq(sizeof(r4::vector3a<float>), sizeof(float) * 4, SL);
+		tst::check_eq(alignof(r4::vector3a<float>), sizeof(float) * 4, SL);
+		tst::check_eq(sizeof(r4::vector3a<double>), sizeof(double) * 4, SL);
+		tst::check_eq(alignof(r4::vector3a<double>), sizeof(double) * 4, SL);
+
+		std::array<r4::vector3a<float>, 3> arr{};
+		for(const auto& v : arr){
+			tst::check_eq(reinterpret_cast<uintptr_t>(&v) % 16, uintptr_t(0), SL);
+		}
+	});
+
+	suite.add("constructors", []{
+		r4::vector3a<int> v{3, 4, 5};
+		tst::check_eq(r4::vector3<int>(v), r4::vector3<int>{3, 4, 5}, SL);
+
+		r4::vector3a<int> n(4);
+		tst::check_eq(r4::vector3<int>(n), r4::vector3<int>{4, 4, 4}, SL);
+
+		r4::vector3a<int> v2{r4::vector2<int>{3, 4}, 5};
+		tst::check_eq(r4::vector3<int>(v2), r4::vector3<int>{3, 4, 5}, SL);
+
+		r4::vector3a<int> v4{r4::vector4<int>{3, 4, 5, 6}};
+		tst::check_eq(r4::vector3<int>(v4), r4::vector3<int>{3, 4, 5}, SL);
+	});
+
+	suite.add("conversion_to_and_from_vector3", []{
+		r4::vector3<float> v3{1, 2, 3};
+
+		r4::vector3a<float> a = v3;
+		tst::check_eq(a.x(), 1.0f, SL);
+		tst::check_eq(a.y(), 2.0f, SL);
+		tst::check_eq(a.z(), 3.0f, SL);
+
+		// vector3a is a vector3
+		const r4::vector3<float>& ref = a;
+		tst::check_eq(ref, v3, SL);
+
+		r4::vector3<float> back = a;
+		tst::check_eq(back, v3, SL);
+
+		a = r4::vector3<float>{4, 5, 6};
+		tst::check_eq(a, r4::vector3a<float>{4, 5, 6}, SL);
+	});
+
+	suite.add("operations_ignore_padding", []{
+		check_ops<float>();
+		check_ops<double>();
+		check_ops<int>();
+	});
+
+	suite.add("normalize", []{
+		auto a = with_padding(r4::vector3a<float>{3, 0, 4}, 1000.0f);
+		tst::check_eq(r4::vector3<float>(a.normed()), r4::vector3<float>{3, 0, 4}.normed(), SL);
+
+		a.normalize();
+		tst::check_eq(r4::vector3<float>(a), r4::vector3<float>{0.6f, 0, 0.8f}, SL);
+
+		r4::vector3a<float> z{0, 0, 0};
+		z.normalize();
+		tst::check_eq(z, r4::vector3a<float>{1, 0, 0}, SL);
+	});
+
+	suite.add("floor_ceil", []{
+		r4::vector3a<float> v{1.5f, -1.5f, 2.0f};
+
+		tst::check_eq(floor(v), r4::vector3a<float>{1, -2, 2}, SL);
+		tst::check_eq(ceil(v), r4::vector3a<float>{2, -1, 2}, SL);
+	});
+
+	suite.add("vector3_api", []{
+		r4::vector3a<float> v{1, 2, 3};
+
+		// operations not accelerated for vector3a are inherited from vector3
+		tst::check(v.is_positive(), SL);
+		tst::check_eq(v + r4::vector3<float>{1, 1, 1}, r4::vector3<float>{2, 3, 4}, SL);
+		tst::check_eq(v.to<int>(), r4::vector3<int>{1, 2, 3}, SL);
+
+		std::stringstream ss;
+		ss << v;
+		tst::check_eq(ss.str(), std::string("1 2 3"), SL);
+	});
+
+	suite.add("division_raises_no_invalid", []{
+		check_division_raises_no_invalid<float>();
+		check_division_raises_no_invalid<double>();
+	});
+
+	suite.add("constexpr", []{
+		constexpr r4::vector3a<double> a{1, 2, 3};
+		constexpr r4::vector3a<double> b{4, 5, 6};
+
+		static_assert((a + b).z() == 9, "constexpr evaluation failed");
+		static_assert(a.dot(b) == 32, "constexpr evaluation failed");
+		static_assert(a.cross(b) == r4::vector3<double>{-3, 6, -3}, "constexpr evaluation failed");
+		static_assert(r4::vector3a<double>{0, 3, 4}.norm() == 5, "constexpr evaluation failed");
+
+		tst::check_eq(a.cross(b), r4::vector3a<double>{-3, 6, -3}, SL);
+	});
+});
+}
@@ -4,6 +4,7 @@
 #include <utki/config.hpp>
 #include <utki/string.hpp>
 
+#include "../../../src/r4/io.hpp"
 #include "../../../src/r4/vector.hpp"
 
 using namespace std::string_literals;
@@ -536,6 +537,79 @@ const tst::set set("vector4", [](tst::suite& suite){
 		tst::check_eq(r[3], -6, SL);
     });
 
+    suite.add("float_arithmetic", []{
+        r4::vector4<float> a{1.5f, -2.0f, 3.25f, 4.0f};
+        r4::vector4<float> b{0.5f, 4.0f, -1.25f, 2.0f};
+
+        tst::check_eq(a + b, r4::vector4<float>{2.0f, 2.0f, 2.0f, 6.0f}, SL);
+        tst::check_eq(a - b, r4::vector4<float>{1.0f, -6.0f, 4.5f, 2.0f}, SL);
+        tst::check_eq(a * 2.0f, r4::vector4<float>{3.0f, -4.0f, 6.5f, 8.0f}, SL);
+        tst::check_eq(a / 2.0f, r4::vector4<float>{0.75f, -1.0f, 1.625f, 2.0f}, SL);
+        tst::check_eq(a.comp_mul(b), r4::vector4<float>{0.75f, -8.0f, -4.0625f, 8.0f}, SL);
+        tst::check_eq(a.comp_div(b), r4::vector4<float>{3.0f, -0.5f, -2.6f, 2.0f}, SL);
+        tst::check_eq(-a, r4::vector4<float>{-1.5f, 2.0f, -3.25f, -4.0f}, SL);
+        tst::check_eq(a.dot(b), 0.75f - 8.0f - 4.0625f + 8.0f, SL);
+        tst::check_eq(b.norm_pow2(), 0.25f + 16.0f + 1.5625f + 4.0f, SL);
+
+        auto c = a;
+        c += b;
+        c -= a;
+        tst::check_eq(c, b, SL);
+        c += 1.0f;
+        tst::check_eq(c, r4::vector4<float>{1.5f, 5.0f, -0.25f, 3.0f}, SL);
+    });
+
+    suite.add("float_min_max_abs_floor_ceil", []{
+        r4::vector4<float> a{1.5f, -2.5f, 0.0f, -0.0f};
+        r4::vector4<float> b{-1.0f, 4.0f, -0.0f, 0.0f};
+
+        auto mn = min(a, b);
+        tst::check_eq(mn, r4::vector4<float>{-1.0f, -2.5f, 0.0f, 0.0f}, SL);
+        // for equal arguments std::min() returns the first one
+        tst::check(!std::signbit(mn[2]), SL);
+        tst::check(std::signbit(mn[3]), SL);
+
+        auto mx = max(a, b);
+        tst::check_eq(mx, r4::vector4<float>{1.5f, 4.0f, 0.0f, 0.0f}, SL);
+        tst::check(!std::signbit(mx[2]), SL);
+        tst::check(std::signbit(mx[3]), SL);
+
+        tst::check_eq(abs(a), r4::vector4<float>{1.5f, 2.5f, 0.0f, 0.0f}, SL);
+        tst::check_eq(floor(a), r4::vector4<float>{1.0f, -3.0f, 0.0f, 0.0f}, SL);
+        tst::check_eq(ceil(a), r4::vector4<float>{2.0f, -2.0f, 0.0f, 0.0f}, SL);
+    });
+
+    suite.add("double_arithmetic", []{
+        r4::vector4<double> a{1.5, -2.0, 3.25, 4.0};
+        r4::vector4<double> b{0.5, 4.0, -1.25, 2.0};
+
+        tst::check_eq(a + b, r4::vector4<double>{2.0, 2.0, 2.0, 6.0}, SL);
+        tst::check_eq(a - b, r4::vector4<double>{1.0, -6.0, 4.5, 2.0}, SL);
+        tst::check_eq(a * 2.0, r4::vector4<double>{3.0, -4.0, 6.5, 8.0}, SL);
+        tst::check_eq(a.comp_mul(b), r4::vector4<double>{0.75, -8.0, -4.0625, 8.0}, SL);
+        tst::check_eq(a.dot(b), 0.75 - 8.0 - 4.0625 + 8.0, SL);
+        tst::check_eq(min(a, b), r4::vector4<double>{0.5, -2.0, -1.25, 2.0}, SL);
+        tst::check_eq(max(a, b), r4::vector4<double>{1.5, 4.0, 3.25, 4.0}, SL);
+        tst::check_eq(floor(a), r4::vector4<double>{1.0, -2.0, 3.0, 4.0}, SL);
+    });
+
+    suite.add("sum_min_component_max_component", []{
+        r4::vector4<float> f{1.5f, -2.0f, 3.25f, 4.0f};
+        tst::check_eq(f.sum(), 6.75f, SL);
+        tst::check_eq(f.min_component(), -2.0f, SL);
+        tst::check_eq(f.max_component(), 4.0f, SL);
+
+        r4::vector4<double> d{1.5, 4.0, 3.25, -2.0};
+        tst::check_eq(d.sum(), 6.75, SL);
+        tst::check_eq(d.min_component(), -2.0, SL);
+        tst::check_eq(d.max_component(), 4.0, SL);
+
+        r4::vector4<int> i{3, 4, -5, 6};
+        tst::check_eq(i.sum(), 8, SL);
+        tst::check_eq(i.min_component(), -5, SL);
+        tst::check_eq(i.max_component(), 6, SL);
+    });
+
     suite.add("constexprness", [](){
 #if CFG_CPP >= 20
         // operator/(number)
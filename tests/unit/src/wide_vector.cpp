@@ -0,0 +1,146 @@
+#include <tst/set.hpp>
+#include <tst/check.hpp>
+
+#include "../../../src/r4/io.hpp"
+#include "../../../src/r4/vector.hpp"
+
+// declare templates to instantiate all template methods to include all methods to gcov coverage
+template class r4::vector<float, 8>;
+template class r4::vector<float, 16>;
+
+namespace{
+template <size_t dimension>
+constexpr r4::vector<float, dimension> make_vector(float start, float step){
+	r4::vector<float, dimension> ret{};
+	for(auto& c : ret){
+		c = start;
+		start += step;
+		step = -step * 1.25f;
+	}
+	return ret;
+}
+
+// component-wise operations produce bit-identical results in SIMD and scalar implementations,
+// the scalar implementation is the one used in constant evaluation
+template <size_t dimension>
+void check_bit_compatibility(){
+	using vector = r4::vector<float, dimension>;
+
+	constexpr auto ca = make_vector<dimension>(1.1f, 0.7f);
+	constexpr auto cb = make_vector<dimension>(-3.3f, 1.9f);
+
+	constexpr auto sum = ca + cb;
+	constexpr auto difference = ca - cb;
+	constexpr auto negated = -ca;
+	constexpr auto scaled = ca * 1.3f;
+	constexpr auto divided = ca / 1.3f;
+	constexpr auto product = ca.comp_mul(cb);
+	constexpr auto quotient = ca.comp_div(cb);
+	constexpr auto minimum = min(ca, cb);
+	constexpr auto maximum = max(ca, cb);
+	constexpr auto absolute = abs(cb);
+	constexpr auto min_comp = cb.min_component();
+	constexpr auto max_comp = cb.max_component();
+
+	// run time copies, to make sure the SIMD implementation is used
+	vector a = ca;
+	vector b = cb;
+
+	tst::check_eq(a + b, sum, SL);
+	tst::check_eq(a - b, difference, SL);
+	tst::check_eq(-a, negated, SL);
+	tst::check_eq(a * 1.3f, scaled, SL);
+	tst::check_eq(a / 1.3f, divided, SL);
+	tst::check_eq(a.comp_mul(b), product, SL);
+	tst::check_eq(a.comp_div(b), quotient, SL);
+	tst::check_eq(min(a, b), minimum, SL);
+	tst::check_eq(max(a, b), maximum, SL);
+	tst::check_eq(abs(b), absolute, SL);
+	tst::check_eq(b.min_component(), min_comp, SL);
+	tst::check_eq(b.max_component(), max_comp, SL);
+
+	{
+		vector v = a;
+		v += b;
+		tst::check_eq(v, sum, SL);
+		v = a;
+		v -= b;
+		tst::check_eq(v, difference, SL);
+		v = a;
+		v *= 1.3f;
+		tst::check_eq(v, scaled, SL);
+		v = a;
+		v /= 1.3f;
+		tst::check_eq(v, divided, SL);
+		v = a;
+		v.comp_multiply(b);
+		tst::check_eq(v, product, SL);
+		v = a;
+		v.negate();
+		tst::check_eq(v, negated, SL);
+	}
+
+	tst::check_eq(vector(2).set(5), vector(5), SL);
+	for(const auto& c : floor(a * 3.0f)){
+		tst::check_eq(c, std::floor(c), SL);
+	}
+}
+
+// reductions add the components in different order in SIMD and scalar implementations
+template <size_t dimension>
+void check_reductions(){
+	constexpr auto ca = make_vector<dimension>(1.1f, 0.7f);
+	constexpr auto cb = make_vector<dimension>(-3.3f, 1.9f);
+
+	constexpr auto dot = ca.dot(cb);
+	constexpr auto sum = ca.sum();
+	constexpr auto norm = ca.norm();
+
+	auto a = ca;
+	auto b = cb;
+
+	tst::check_le(std::abs(a.dot(b) - dot), std::abs(dot) * 1e-6f, SL);
+	tst::check_le(std::abs(a.sum() - sum), std::abs(sum) * 1e-6f, SL);
+	tst::check_le(std::abs(a.norm() - norm), norm * 1e-6f, SL);
+	tst::check_le(std::abs(a.normed().norm() - 1.0f), 1e-6f, SL);
+
+	// exactly representable values give exact results in any order
+	r4::vector<float, dimension> ones(1);
+	tst::check_eq(ones.sum(), float(dimension), SL);
+	tst::check_eq(ones.dot(ones * 2.0f), float(dimension * 2), SL);
+}
+}
+
+namespace{
+const tst::set set("wide_vector", [](tst::suite& suite){
+	suite.add("vector8_bit_compatibility", []{
+		check_bit_compatibility<8>();
+	});
+
+	suite.add("vector16_bit_compatibility", []{
+		check_bit_compatibility<16>();
+	});
+
+	suite.add("vector8_reductions", []{
+		check_reductions<8>();
+	});
+
+	suite.add("vector16_reductions", []{
+		check_reductions<16>();
+	});
+
+	suite.add("min_component_max_component", []{
+		r4::vector<float, 16> v(0);
+		v[11] = -7;
+		v[14] = 9;
+
+		tst::check_eq(v.min_component(), -7.0f, SL);
+		tst::check_eq(v.max_component(), 9.0f, SL);
+
+		r4::vector<float, 8> w{5, 4, 3, 2, 1, 8, 7, 6};
+		tst::check_eq(w.min_component(), 1.0f, SL);
+		tst::check_eq(w.max_component(), 8.0f, SL);
+		tst::check_eq(w.sum(), 36.0f, SL);
+	});
+});
+}